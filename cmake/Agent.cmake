@@ -31,6 +31,7 @@ target_link_libraries(address_utils
 
 add_library(utils
   fboss/agent/AlpmUtils.cpp
+  fboss/agent/StateSerialization.cpp
   fboss/agent/Utils.cpp
   fboss/agent/oss/Utils.cpp
 )
@@ -67,6 +68,7 @@ add_library(core
   fboss/agent/ApplyThriftConfig.cpp
   fboss/agent/ArpCache.cpp
   fboss/agent/ArpHandler.cpp
+  fboss/agent/AsyncStateObserver.cpp
   fboss/agent/DHCPv4Handler.cpp
   fboss/agent/DHCPv6Handler.cpp
   fboss/agent/HwSwitch.cpp
@@ -97,6 +99,7 @@ add_library(core
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
   fboss/agent/StandaloneRibConversions.cpp
+  fboss/agent/StateUpdateCoalescingPolicy.cpp
   fboss/agent/SwSwitch.cpp
   fboss/agent/ThreadHeartbeat.cpp
   fboss/agent/TunIntf.cpp
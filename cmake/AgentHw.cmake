@@ -36,6 +36,7 @@ add_library(buffer_stats
 
 target_link_libraries(hw_switch_warmboot_helper
   utils
+  state
   Folly::folly
 )
 
@@ -37,6 +37,7 @@ add_library(sai_api
   fboss/agent/hw/sai/api/RouteApi.cpp
   fboss/agent/hw/sai/api/SaiApiLock.cpp
   fboss/agent/hw/sai/api/SaiApiTable.cpp
+  fboss/agent/hw/sai/api/SaiBulkApiQueue.cpp
   fboss/agent/hw/sai/api/SwitchApi.cpp
   fboss/agent/hw/sai/api/AclApi.h
   fboss/agent/hw/sai/api/BridgeApi.h
@@ -54,6 +55,7 @@ add_library(sai_api
   fboss/agent/hw/sai/api/SaiApiError.h
   fboss/agent/hw/sai/api/SaiAttribute.h
   fboss/agent/hw/sai/api/SaiAttributeDataTypes.h
+  fboss/agent/hw/sai/api/SaiBulkApiQueue.h
   fboss/agent/hw/sai/api/SaiObjectApi.h
   fboss/agent/hw/sai/api/SaiVersion.h
   fboss/agent/hw/sai/api/SchedulerApi.h
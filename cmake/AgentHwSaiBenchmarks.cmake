@@ -0,0 +1,76 @@
+# CMake to build libraries and binaries in fboss/agent/hw/sai/benchmarks
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(fake_sai_route_scale_benchmark
+  fboss/agent/hw/sai/benchmarks/FakeSaiRouteScaleBenchmark.cpp
+)
+
+target_link_libraries(fake_sai_route_scale_benchmark
+  fake_sai
+  sai_switch_ensemble
+  config_factory
+  route_scale_gen
+  Folly::folly
+)
+
+set_target_properties(fake_sai_route_scale_benchmark PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+add_executable(fake_sai_api_lock_contention_benchmark
+  fboss/agent/hw/sai/benchmarks/FakeSaiApiLockContentionBenchmark.cpp
+)
+
+target_link_libraries(fake_sai_api_lock_contention_benchmark
+  fake_sai
+  sai_api
+  Folly::folly
+)
+
+set_target_properties(fake_sai_api_lock_contention_benchmark PROPERTIES
+  COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+add_executable(fake_sai_stats_collection_benchmark
+  fboss/agent/hw/benchmarks/HwBenchmarkMain.cpp
+  fboss/agent/hw/benchmarks/HwStatsCollectionBenchmark.cpp
+)
+
+target_link_libraries(fake_sai_stats_collection_benchmark
+  fake_sai
+  sai_switch_ensemble
+  config_factory
+  Folly::folly
+)
+
+set_target_properties(fake_sai_stats_collection_benchmark PROPERTIES
+  COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+add_executable(fake_sai_store_reload_benchmark
+  fboss/agent/hw/sai/benchmarks/FakeSaiStoreReloadBenchmark.cpp
+)
+
+target_link_libraries(fake_sai_store_reload_benchmark
+  fake_sai
+  sai_api
+  sai_store
+  Folly::folly
+)
+
+set_target_properties(fake_sai_store_reload_benchmark PROPERTIES
+  COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
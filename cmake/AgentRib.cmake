@@ -23,11 +23,13 @@ target_link_libraries(standalone_rib
   ctrl_cpp2
   label_forwarding_action
   state_utils
+  interner
   Folly::folly
 )
 
 add_library(network_to_route_map
   fboss/agent/rib/NetworkToRouteMap.h
+  fboss/agent/rib/NextHopDependencies.h
 )
 
 target_link_libraries(network_to_route_map
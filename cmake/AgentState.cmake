@@ -51,6 +51,7 @@ add_library(state
   fboss/agent/state/SflowCollectorMap.cpp
   fboss/agent/state/StateDelta.cpp
   fboss/agent/state/StateUtils.cpp
+  fboss/agent/state/StreamingStateWriter.cpp
   fboss/agent/state/SwitchSettings.cpp
   fboss/agent/state/SwitchState.cpp
   fboss/agent/state/Vlan.cpp
@@ -67,6 +68,8 @@ target_link_libraries(state
   label_forwarding_action
   state_utils
   radix_tree
+  multibit_trie
+  interner
   phy_cpp2
   Folly::folly
 )
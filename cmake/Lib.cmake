@@ -12,6 +12,15 @@ target_link_libraries(radix_tree
   Folly::folly
 )
 
+add_library(multibit_trie
+  fboss/lib/MultibitTrie.h
+)
+
+target_link_libraries(multibit_trie
+  radix_tree
+  Folly::folly
+)
+
 add_library(log_thrift_call
   fboss/lib/LogThriftCall.cpp
 )
@@ -27,6 +36,16 @@ add_library(ref_map
 
 set_target_properties(ref_map PROPERTIES LINKER_LANGUAGE CXX)
 
+add_library(interner
+  fboss/lib/Interner.h
+)
+
+set_target_properties(interner PROPERTIES LINKER_LANGUAGE CXX)
+
+target_link_libraries(interner
+  Folly::folly
+)
+
 add_library(tuple_utils
   fboss/lib/TupleUtils.h
 )
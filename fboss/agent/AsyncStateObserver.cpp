@@ -0,0 +1,142 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AsyncStateObserver.h"
+
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+AsyncStateObserver::AsyncStateObserver(
+    StateObserver* observer,
+    const std::string& name,
+    const AsyncStateObserverOptions& options)
+    : observer_(observer), name_(name), options_(options) {
+  CHECK_GT(options_.maxPendingDeltas, 0);
+  thread_ = std::make_unique<std::thread>([this]() {
+    initThread(folly::to<std::string>("fbossObs", name_).substr(0, 15));
+    evb_.loopForever();
+  });
+}
+
+AsyncStateObserver::~AsyncStateObserver() {
+  {
+    // Drop whatever the observer has not gotten to yet and release the update
+    // thread if it is waiting on us.
+    std::lock_guard<std::mutex> g(pendingDeltasLock_);
+    stopping_ = true;
+    pendingDeltas_.clear();
+  }
+  pendingDeltasDrained_.notify_all();
+  evb_.runInEventBaseThread([this]() { evb_.terminateLoopSoon(); });
+  thread_->join();
+}
+
+void AsyncStateObserver::stateUpdated(const StateDelta& delta) {
+  size_t pending;
+  int64_t lagGenerations;
+  {
+    std::unique_lock<std::mutex> lk(pendingDeltasLock_);
+    if (pendingDeltas_.size() >= options_.maxPendingDeltas) {
+      if (options_.collapseDeltas &&
+          pendingDeltas_.back().second == delta.oldState()) {
+        // The observer is behind, fold this delta into the last queued one.
+        // The queued delta is not being processed yet, since the observer
+        // thread pops a delta off the queue before handling it.
+        pendingDeltas_.back().second = delta.newState();
+        ++collapsedDeltas_;
+      } else {
+        ++backpressureWaits_;
+        pendingDeltasDrained_.wait(lk, [this]() {
+          return stopping_ ||
+              pendingDeltas_.size() < options_.maxPendingDeltas;
+        });
+      }
+    }
+    if (stopping_) {
+      return;
+    }
+    if (pendingDeltas_.empty() ||
+        pendingDeltas_.back().second != delta.newState()) {
+      pendingDeltas_.emplace_back(delta.oldState(), delta.newState());
+    }
+    pending = pendingDeltas_.size();
+    lagGenerations = delta.newState()->getGeneration() -
+        pendingDeltas_.front().first->getGeneration();
+  }
+  publishCounters(pending, lagGenerations);
+  evb_.runInEventBaseThread(processPendingDeltasHelper, this);
+}
+
+size_t AsyncStateObserver::pendingDeltas() const {
+  std::lock_guard<std::mutex> g(pendingDeltasLock_);
+  return pendingDeltas_.size();
+}
+
+void AsyncStateObserver::processPendingDeltasHelper(
+    AsyncStateObserver* observer) {
+  observer->processPendingDeltas();
+}
+
+void AsyncStateObserver::processPendingDeltas() {
+  // processPendingDeltas() is scheduled once per queued delta, but collapsing
+  // may have left fewer deltas than that. Just return if there is no work.
+  PendingDelta next;
+  {
+    std::lock_guard<std::mutex> g(pendingDeltasLock_);
+    if (pendingDeltas_.empty()) {
+      return;
+    }
+    next = std::move(pendingDeltas_.front());
+    pendingDeltas_.pop_front();
+  }
+  pendingDeltasDrained_.notify_all();
+
+  try {
+    observer_->stateUpdated(StateDelta(next.first, next.second));
+  } catch (const std::exception& ex) {
+    XLOG(FATAL) << "error notifying " << name_
+                << " of update: " << folly::exceptionStr(ex);
+  }
+
+  size_t pending;
+  int64_t lagGenerations{0};
+  {
+    std::lock_guard<std::mutex> g(pendingDeltasLock_);
+    pending = pendingDeltas_.size();
+    if (!pendingDeltas_.empty()) {
+      lagGenerations = pendingDeltas_.back().second->getGeneration() -
+          next.second->getGeneration();
+    }
+  }
+  publishCounters(pending, lagGenerations);
+}
+
+void AsyncStateObserver::publishCounters(
+    size_t pending,
+    int64_t lagGenerations) {
+  fb303::fbData->setCounter(counterName("pending_deltas"), pending);
+  fb303::fbData->setCounter(counterName("lag_generations"), lagGenerations);
+  std::lock_guard<std::mutex> g(pendingDeltasLock_);
+  fb303::fbData->setCounter(counterName("collapsed_deltas"), collapsedDeltas_);
+  fb303::fbData->setCounter(
+      counterName("backpressure_waits"), backpressureWaits_);
+}
+
+std::string AsyncStateObserver::counterName(folly::StringPiece counter) const {
+  return folly::to<std::string>("state_observer.", name_, ".", counter);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include "fboss/agent/StateObserver.h"
+
+#include <folly/io/async/EventBase.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace facebook::fboss {
+
+class SwitchState;
+
+struct AsyncStateObserverOptions {
+  /*
+   * Maximum number of deltas queued up for the observer. Once this many are
+   * pending, the update thread either collapses new deltas into the last
+   * queued one, or blocks until the observer catches up.
+   */
+  uint32_t maxPendingDeltas{16};
+  /*
+   * Allow collapsing consecutive deltas (A -> B, B -> C) into one (A -> C)
+   * once the observer falls behind. Observers that need to see every
+   * intermediate state should turn this off, and get backpressure instead.
+   */
+  bool collapseDeltas{true};
+};
+
+/*
+ * Notifies a StateObserver from a dedicated thread, rather than inline from
+ * the update thread.
+ *
+ * stateUpdated() is called on the update thread and merely queues the delta.
+ * The wrapped observer then sees the queued deltas, in order, from the thread
+ * owned by this class, so a slow observer no longer adds its latency to every
+ * hardware update.
+ *
+ * Use SwSwitch::registerAsyncStateObserver() rather than creating these
+ * directly.
+ */
+class AsyncStateObserver : public StateObserver {
+ public:
+  AsyncStateObserver(
+      StateObserver* observer,
+      const std::string& name,
+      const AsyncStateObserverOptions& options);
+  ~AsyncStateObserver() override;
+
+  void stateUpdated(const StateDelta& delta) override;
+
+  StateObserver* getObserver() const {
+    return observer_;
+  }
+
+  size_t pendingDeltas() const;
+
+ private:
+  using PendingDelta =
+      std::pair<std::shared_ptr<SwitchState>, std::shared_ptr<SwitchState>>;
+
+  static void processPendingDeltasHelper(AsyncStateObserver* observer);
+  void processPendingDeltas();
+  void publishCounters(size_t pending, int64_t lagGenerations);
+  std::string counterName(folly::StringPiece counter) const;
+
+  StateObserver* observer_;
+  const std::string name_;
+  const AsyncStateObserverOptions options_;
+
+  mutable std::mutex pendingDeltasLock_;
+  std::condition_variable pendingDeltasDrained_;
+  std::deque<PendingDelta> pendingDeltas_;
+  bool stopping_{false};
+  int64_t collapsedDeltas_{0};
+  int64_t backpressureWaits_{0};
+
+  folly::EventBase evb_;
+  std::unique_ptr<std::thread> thread_;
+};
+
+} // namespace facebook::fboss
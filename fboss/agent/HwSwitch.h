@@ -210,8 +210,16 @@ class HwSwitch {
   /*
    * Allow hardware to perform any warm boot related cleanup
    * before we exit the application.
+   *
+   * The warm boot state written out holds swState under kSwSwitch, the
+   * HwSwitch's own state under kHwSwitch, and any other entries in
+   * switchState. swState is passed as is, so that it can be streamed to the
+   * warm boot file without building its folly::dynamic. It is null if
+   * switchState already holds it under kSwSwitch.
    */
-  virtual void gracefulExit(folly::dynamic& switchState) = 0;
+  virtual void gracefulExit(
+      folly::dynamic& switchState,
+      const std::shared_ptr<SwitchState>& swState) = 0;
 
   /*
    * Get Hw Switch state in a folly::dynamic
@@ -78,6 +78,11 @@ DEFINE_bool(
     enable_standalone_rib,
     false,
     "Place the RIB under the control of the RoutingInformationBase object");
+DEFINE_bool(
+    enable_state_update_pipeline,
+    false,
+    "Program the hardware from a dedicated thread, overlapping it with "
+    "preparation of the next switch state");
 
 using facebook::fboss::SwSwitch;
 using facebook::fboss::ThriftHandler;
@@ -141,6 +146,9 @@ class Initializer {
     if (FLAGS_enable_standalone_rib) {
       flags |= SwitchFlags::ENABLE_STANDALONE_RIB;
     }
+    if (FLAGS_enable_state_update_pipeline) {
+      flags |= SwitchFlags::ENABLE_STATE_UPDATE_PIPELINE;
+    }
     return flags;
   }
 
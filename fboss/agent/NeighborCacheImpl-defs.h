@@ -101,7 +101,9 @@ void NeighborCacheImpl<NTable>::programEntry(Entry* entry) {
   };
 
   sw_->updateState(
-      folly::to<std::string>("add neighbor ", fields.ip), std::move(updateFn));
+      folly::to<std::string>("add neighbor ", fields.ip),
+      std::move(updateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 template <typename NTable>
@@ -141,7 +143,8 @@ void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
 
   sw_->updateStateNoCoalescing(
       folly::to<std::string>("add pending entry ", fields.ip),
-      std::move(updateFn));
+      std::move(updateFn),
+      StateUpdate::Priority::HIGH);
 }
 
 template <typename NTable>
@@ -360,9 +363,15 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
   if (flushed) {
     // need a blocking state update if the caller wants to know if an entry
     // was actually flushed
-    sw_->updateStateBlocking("flush neighbor entry", std::move(updateFn));
+    sw_->updateStateBlocking(
+        "flush neighbor entry",
+        std::move(updateFn),
+        StateUpdate::Priority::HIGH);
   } else {
-    sw_->updateState("remove neighbor entry", std::move(updateFn));
+    sw_->updateState(
+        "remove neighbor entry",
+        std::move(updateFn),
+        StateUpdate::Priority::HIGH);
   }
 }
 
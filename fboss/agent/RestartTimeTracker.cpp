@@ -22,6 +22,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -89,6 +91,10 @@ std::string to_string(RestartEvent type) {
       return "parent_process_started";
     case RestartEvent::PROCESS_STARTED:
       return "process_started";
+    case RestartEvent::WARM_BOOT_STATE_READ:
+      return "warm_boot_state_read";
+    case RestartEvent::WARM_BOOT_STATE_DESERIALIZED:
+      return "warm_boot_state_deserialized";
     case RestartEvent::INITIALIZED:
       return "initialized";
     case RestartEvent::CONFIGURED:
@@ -138,8 +144,10 @@ class RestartTimeTracker {
     }
   }
 
-  std::optional<TimePoint> newEvent(RestartEvent type) {
-    auto tp = create(type);
+  std::optional<TimePoint> newEvent(
+      RestartEvent type,
+      std::optional<TimePoint> at = std::nullopt) {
+    auto tp = at ? at : create(type);
 
     if (tp) {
       if (lastEvent_) {
@@ -177,6 +185,8 @@ class RestartTimeTracker {
         return processStartTime(getppid());
       case RestartEvent::PROCESS_STARTED:
         return processStartTime(getpid());
+      case RestartEvent::WARM_BOOT_STATE_READ:
+      case RestartEvent::WARM_BOOT_STATE_DESERIALIZED:
       case RestartEvent::INITIALIZED:
       case RestartEvent::CONFIGURED:
       case RestartEvent::FIB_SYNCED:
@@ -204,28 +214,41 @@ class RestartTimeTracker {
 
 namespace restart_time {
 
-folly::Synchronized<std::unique_ptr<RestartTimeTracker>, std::mutex> impl_;
+struct TrackerState {
+  std::unique_ptr<RestartTimeTracker> tracker;
+  // Events marked before init()
+  std::vector<std::pair<RestartEvent, TimePoint>> pending;
+};
+
+folly::Synchronized<TrackerState, std::mutex> impl_;
 
 void init(const std::string& warmBootDir, bool warmBoot) {
-  auto tracker = impl_.lock();
-  if (*tracker) {
+  auto state = impl_.lock();
+  if (state->tracker) {
     throw std::runtime_error("Called restart_time::init twice...");
   }
-  *tracker = std::make_unique<RestartTimeTracker>(warmBootDir, warmBoot);
+  state->tracker = std::make_unique<RestartTimeTracker>(warmBootDir, warmBoot);
+  for (const auto& [event, tp] : state->pending) {
+    state->tracker->newEvent(event, tp);
+  }
+  state->pending.clear();
 }
 
 void mark(RestartEvent event) {
-  auto tracker = impl_.lock();
-  if (*tracker) {
-    (*tracker)->newEvent(event);
+  auto state = impl_.lock();
+  if (state->tracker) {
+    state->tracker->newEvent(event);
   } else {
-    XLOG(ERR) << "Cannot call restart_time::mark() before restart_time::init";
+    XLOG(DBG2) << "Holding on to restart event " << to_string(event)
+               << " until restart_time::init";
+    state->pending.emplace_back(event, steady_clock::now());
   }
 }
 
 void stop() {
-  auto tracker = impl_.lock();
-  (*tracker).reset();
+  auto state = impl_.lock();
+  state->tracker.reset();
+  state->pending.clear();
 }
 
 } // namespace restart_time
@@ -35,6 +35,10 @@ enum class RestartEvent : uint16_t {
   SHUTDOWN,
   PARENT_PROCESS_STARTED,
   PROCESS_STARTED,
+  // Warm boot state file read and parsed
+  WARM_BOOT_STATE_READ,
+  // SwitchState rebuilt from the warm boot state
+  WARM_BOOT_STATE_DESERIALIZED,
   INITIALIZED,
   CONFIGURED,
   FIB_SYNCED,
@@ -42,6 +46,10 @@ enum class RestartEvent : uint16_t {
 
 namespace restart_time {
 void init(const std::string& warmBootDir, bool warmBoot);
+/*
+ * Events marked before init() (e.g. while the HwSwitch is initializing) are
+ * held on to, and recorded with their original time once init() is called.
+ */
 void mark(RestartEvent event);
 void stop();
 }; // namespace restart_time
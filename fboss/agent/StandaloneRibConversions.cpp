@@ -40,12 +40,14 @@ static void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const std::set<folly::CIDRNetwork>* changedPrefixes,
     void* cookie) {
   rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
-  sw->updateStateBlocking("", std::move(fibUpdater));
+  sw->updateStateBlocking(
+      "", std::move(fibUpdater), StateUpdate::Priority::LOW);
 }
 
 void syncFibWithStandaloneRib(
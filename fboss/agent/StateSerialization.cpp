@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateSerialization.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/SysError.h"
+
+#include <folly/experimental/bser/Bser.h>
+#include <folly/json.h>
+#include <folly/lang/Bits.h>
+#include <folly/system/MemoryMapping.h>
+
+#include <gflags/gflags.h>
+
+#include <cstring>
+#include <memory>
+#include <system_error>
+
+DEFINE_bool(
+    binary_switch_state,
+    false,
+    "Write switch state files (warm boot, crash dumps) in the compact binary "
+    "format instead of JSON. Either format is accepted when reading them.");
+DEFINE_bool(
+    stream_warm_boot_state,
+    true,
+    "Stream the switch state to the warm boot file on exit, rather than "
+    "building the whole folly::dynamic first. Only applies to JSON output.");
+
+namespace {
+constexpr folly::StringPiece kBinaryStateMagic{"FBOSSBST"};
+// Bump when the binary payload changes in a way older readers can't handle
+constexpr uint32_t kBinaryStateVersion = 1;
+constexpr size_t kBinaryStateHeaderSize =
+    kBinaryStateMagic.size() + sizeof(uint32_t);
+} // namespace
+
+namespace facebook::fboss {
+
+StateSerializationFormat defaultStateSerializationFormat() {
+  return FLAGS_binary_switch_state ? StateSerializationFormat::BINARY
+                                   : StateSerializationFormat::JSON;
+}
+
+bool streamWarmBootState() {
+  return FLAGS_stream_warm_boot_state &&
+      defaultStateSerializationFormat() == StateSerializationFormat::JSON;
+}
+
+std::string serializeState(
+    const folly::dynamic& state,
+    StateSerializationFormat format) {
+  switch (format) {
+    case StateSerializationFormat::JSON:
+      return folly::toPrettyJson(state);
+    case StateSerializationFormat::BINARY: {
+      folly::bser::serialization_opts opts;
+      auto payload = folly::bser::toBser(state, opts);
+      std::string out;
+      out.reserve(kBinaryStateHeaderSize + payload.size());
+      out.append(kBinaryStateMagic.data(), kBinaryStateMagic.size());
+      auto version = folly::Endian::big(kBinaryStateVersion);
+      out.append(reinterpret_cast<const char*>(&version), sizeof(version));
+      out.append(payload.data(), payload.size());
+      return out;
+    }
+  }
+  throw FbossError(
+      "Unknown state serialization format ", static_cast<int>(format));
+}
+
+folly::dynamic deserializeState(folly::StringPiece data) {
+  if (!data.startsWith(kBinaryStateMagic)) {
+    return folly::parseJson(data);
+  }
+  if (data.size() < kBinaryStateHeaderSize) {
+    throw FbossError("Truncated binary switch state header");
+  }
+  uint32_t version;
+  std::memcpy(
+      &version, data.data() + kBinaryStateMagic.size(), sizeof(version));
+  version = folly::Endian::big(version);
+  if (version > kBinaryStateVersion) {
+    throw FbossError(
+        "Binary switch state version ",
+        version,
+        " is newer than supported version ",
+        kBinaryStateVersion);
+  }
+  data.advance(kBinaryStateHeaderSize);
+  return folly::bser::parseBser(folly::ByteRange(data));
+}
+
+folly::dynamic readStateFromFile(const std::string& filename) {
+  // Parse straight out of the page cache, rather than copying the whole
+  // file into memory first
+  std::unique_ptr<folly::MemoryMapping> mapping;
+  try {
+    mapping = std::make_unique<folly::MemoryMapping>(filename.c_str());
+  } catch (const std::system_error& ex) {
+    throw SysError(
+        ex.code().value(), "Unable to read switch state from : ", filename);
+  }
+  mapping->hintLinearScan();
+  return deserializeState(folly::StringPiece(mapping->range()));
+}
+
+} // namespace facebook::fboss
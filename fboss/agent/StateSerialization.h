@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+
+#include <cstdint>
+#include <string>
+
+namespace facebook::fboss {
+
+/*
+ * Formats for the switch state written out on warm boot exit and crashes.
+ *
+ * JSON is human readable, but encoding and parsing it for a SwitchState
+ * with a full route table takes a good part of warm boot exit and startup.
+ * BINARY encodes the same folly::dynamic tree in BSER, prefixed by a small
+ * header identifying the format and its version.
+ */
+enum class StateSerializationFormat : uint8_t {
+  JSON,
+  BINARY,
+};
+
+/*
+ * Format to write state files in, as selected by --binary_switch_state.
+ */
+StateSerializationFormat defaultStateSerializationFormat();
+
+/*
+ * Whether the SwitchState is streamed to the warm boot file on exit, as
+ * selected by --stream_warm_boot_state, rather than turned into a
+ * folly::dynamic first. Only JSON output is streamed.
+ */
+bool streamWarmBootState();
+
+std::string serializeState(
+    const folly::dynamic& state,
+    StateSerializationFormat format);
+
+/*
+ * Parse state written by serializeState() in either format. Anything
+ * without the binary header is parsed as JSON, so state files written by
+ * older versions of the agent can still be read.
+ */
+folly::dynamic deserializeState(folly::StringPiece data);
+
+/*
+ * Read and parse a state file written in either format. The file is memory
+ * mapped and parsed in place, so only the parsed folly::dynamic is held in
+ * memory.
+ */
+folly::dynamic readStateFromFile(const std::string& filename);
+
+} // namespace facebook::fboss
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/StateUpdateCoalescingPolicy.h"
+
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+StateUpdateCoalescingPolicy::StateUpdateCoalescingPolicy(
+    uint32_t maxBatchSize,
+    std::chrono::microseconds maxBatchLatency,
+    bool adaptive)
+    : maxBatchSize_(maxBatchSize),
+      maxBatchLatency_(maxBatchLatency),
+      adaptive_(adaptive && maxBatchLatency.count() > 0),
+      batchSizeLimit_(maxBatchSize) {
+  if (adaptive_ && !batchSizeLimit_) {
+    batchSizeLimit_ = kMaxAdaptiveBatchSize;
+  }
+}
+
+bool StateUpdateCoalescingPolicy::batchLatencyExceeded(
+    std::chrono::steady_clock::time_point batchStart,
+    std::chrono::steady_clock::time_point now) const {
+  return maxBatchLatency_.count() > 0 && now - batchStart >= maxBatchLatency_;
+}
+
+void StateUpdateCoalescingPolicy::batchApplied(
+    uint32_t batchSize,
+    std::chrono::microseconds duration) {
+  if (!adaptive_) {
+    return;
+  }
+  auto oldLimit = batchSizeLimit_;
+  if (duration > maxBatchLatency_) {
+    // Overshot the latency budget, back off
+    batchSizeLimit_ = std::max<uint32_t>(1, batchSize / 2);
+  } else if (batchSize >= batchSizeLimit_ && duration < maxBatchLatency_ / 2) {
+    // Batch was capped by the limit and came in well under budget, so we can
+    // afford to coalesce more
+    auto cap = maxBatchSize_ ? maxBatchSize_ : kMaxAdaptiveBatchSize;
+    batchSizeLimit_ = std::min<uint32_t>(cap, batchSizeLimit_ * 2);
+  }
+  if (oldLimit != batchSizeLimit_) {
+    XLOG(DBG2) << "State update batch size limit " << oldLimit << " -> "
+               << batchSizeLimit_ << " after batch of " << batchSize
+               << " took " << duration.count() << "us";
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace facebook::fboss {
+
+/*
+ * Decides how many pending StateUpdates SwSwitch coalesces into a single
+ * hardware update.
+ *
+ * Large batches amortize the per-delta cost of programming the hardware, but
+ * every update in a batch waits for the whole batch to be prepared and
+ * programmed. The policy bounds a batch both in number of updates and in the
+ * time spent preparing it. In adaptive mode, the batch size limit is further
+ * tuned from the observed end to end duration of previous batches: halved
+ * whenever a batch overshoots the latency budget, and doubled when full
+ * batches comfortably fit within it.
+ *
+ * Only meant to be used from the update thread.
+ */
+class StateUpdateCoalescingPolicy {
+ public:
+  // Upper bound for the batch size in adaptive mode, without a size limit
+  static constexpr uint32_t kMaxAdaptiveBatchSize = 1024;
+
+  /*
+   * maxBatchSize and maxBatchLatency of 0 mean no limit. Adaptive mode needs
+   * a latency budget to work against, and is a no-op without one.
+   */
+  StateUpdateCoalescingPolicy(
+      uint32_t maxBatchSize,
+      std::chrono::microseconds maxBatchLatency,
+      bool adaptive);
+
+  /*
+   * Maximum number of updates to pull into the next batch, 0 for no limit.
+   */
+  uint32_t getBatchSizeLimit() const {
+    return batchSizeLimit_;
+  }
+
+  /*
+   * Whether a batch whose preparation started at batchStart should stop
+   * taking in more updates.
+   */
+  bool batchLatencyExceeded(
+      std::chrono::steady_clock::time_point batchStart,
+      std::chrono::steady_clock::time_point now) const;
+
+  /*
+   * Feedback from the update thread once a batch of batchSize updates has
+   * been prepared and handed to the hardware.
+   */
+  void batchApplied(uint32_t batchSize, std::chrono::microseconds duration);
+
+ private:
+  const uint32_t maxBatchSize_;
+  const std::chrono::microseconds maxBatchLatency_;
+  const bool adaptive_;
+  uint32_t batchSizeLimit_;
+};
+
+} // namespace facebook::fboss
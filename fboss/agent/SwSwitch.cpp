@@ -13,6 +13,7 @@
 #include "fboss/agent/AlpmUtils.h"
 #include "fboss/agent/ApplyThriftConfig.h"
 #include "fboss/agent/ArpHandler.h"
+#include "fboss/agent/AsyncStateObserver.h"
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/HwSwitch.h"
@@ -35,6 +36,8 @@
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/StateSerialization.h"
+#include "fboss/agent/StateUpdateCoalescingPolicy.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/ThriftHandler.h"
 #include "fboss/agent/TunManager.h"
@@ -71,6 +74,7 @@
 #include <chrono>
 #include <condition_variable>
 #include <exception>
+#include <optional>
 #include <tuple>
 
 using folly::EventBase;
@@ -104,6 +108,31 @@ DEFINE_bool(
     false,
     "Flag to turn on logging of all updates to the FIB");
 
+DEFINE_int32(
+    state_update_max_batch_size,
+    0,
+    "Maximum number of pending state updates to coalesce into a single "
+    "hardware update, 0 for no limit");
+
+DEFINE_int32(
+    state_update_max_batch_latency_ms,
+    0,
+    "Stop coalescing more pending state updates into a batch once it has "
+    "been preparing for this long (ms), 0 for no limit");
+
+DEFINE_int32(
+    state_update_max_lane_wait_ms,
+    1000,
+    "Serve a lower priority state update lane ahead of higher priority ones "
+    "once its oldest pending update has waited this long (ms), so that it "
+    "can't be starved. 0 to always serve the highest priority lane first");
+
+DEFINE_bool(
+    state_update_adaptive_batching,
+    false,
+    "Adapt the state update batch size to the observed time taken by "
+    "previous batches, keeping them within state_update_max_batch_latency_ms");
+
 namespace {
 
 /**
@@ -165,6 +194,10 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
       lookupClassUpdater_(new LookupClassUpdater(this)),
       lookupClassRouteUpdater_(new LookupClassRouteUpdater(this)),
       macTableManager_(new MacTableManager(this)) {
+  coalescingPolicy_ = std::make_unique<StateUpdateCoalescingPolicy>(
+      std::max(FLAGS_state_update_max_batch_size, 0),
+      milliseconds(std::max(FLAGS_state_update_max_batch_latency_ms, 0)),
+      FLAGS_state_update_adaptive_batching);
   // Create the platform-specific state directories if they
   // don't exist already.
   utilCreateDir(platform_->getVolatileStateDir());
@@ -305,19 +338,25 @@ void SwSwitch::gracefulExit() {
                       .count();
 
     folly::dynamic switchState = folly::dynamic::object;
+    std::shared_ptr<SwitchState> swState;
     // TODO - Serialize both desired and applied state to
     // file. Right now we just serialize applied state and
     // then rely on a route/FIB sync on warm boot to recover
     // desired state.
-    switchState[kSwSwitch] = getAppliedState()->toFollyDynamic();
+    if (streamWarmBootState()) {
+      // The HwSwitch streams it out under kSwSwitch
+      swState = getAppliedState();
+    } else {
+      switchState[kSwSwitch] = getAppliedState()->toFollyDynamic();
 
-    steady_clock::time_point switchStateToFollyDone = steady_clock::now();
-    XLOG(INFO) << "[Exit] Switch state to folly dynamic "
-               << duration_cast<duration<float>>(
-                      switchStateToFollyDone - stopThreadsAndHandlersDone)
-                      .count();
+      steady_clock::time_point switchStateToFollyDone = steady_clock::now();
+      XLOG(INFO) << "[Exit] Switch state to folly dynamic "
+                 << duration_cast<duration<float>>(
+                        switchStateToFollyDone - stopThreadsAndHandlersDone)
+                        .count();
+    }
     // Cleanup if we ever initialized
-    hw_->gracefulExit(switchState);
+    hw_->gracefulExit(switchState, swState);
     XLOG(INFO)
         << "[Exit] SwSwitch Graceful Exit time "
         << duration_cast<duration<float>>(steady_clock::now() - begin).count();
@@ -366,7 +405,7 @@ void SwSwitch::exitFatal() const noexcept {
   switchState[kSwSwitch] = getAppliedState()->toFollyDynamic();
   switchState[kHwSwitch] = hw_->toFollyDynamic();
   if (!dumpStateToFile(platform_->getCrashSwitchStateFile(), switchState)) {
-    XLOG(ERR) << "Unable to write switch state JSON to file";
+    XLOG(ERR) << "Unable to write switch state to file";
   }
 }
 
@@ -589,6 +628,15 @@ void SwSwitch::registerStateObserver(
       [=]() { addStateObserver(observer, name); });
 }
 
+void SwSwitch::registerAsyncStateObserver(
+    StateObserver* observer,
+    const string name,
+    const AsyncStateObserverOptions& options) {
+  XLOG(DBG2) << "Registering async state observer: " << name;
+  updateEventBase_.runImmediatelyOrRunInEventBaseThreadAndWait(
+      [=]() { addAsyncStateObserver(observer, name, options); });
+}
+
 void SwSwitch::unregisterStateObserver(StateObserver* observer) {
   updateEventBase_.runImmediatelyOrRunInEventBaseThreadAndWait(
       [=]() { removeStateObserver(observer); });
@@ -601,6 +649,13 @@ bool SwSwitch::stateObserverRegistered(StateObserver* observer) {
 
 void SwSwitch::removeStateObserver(StateObserver* observer) {
   DCHECK(updateEventBase_.isInEventBaseThread());
+  auto asyncObserver = asyncStateObservers_.find(observer);
+  if (asyncObserver != asyncStateObservers_.end()) {
+    stateObservers_.erase(asyncObserver->second.get());
+    // Waits for any in flight notification of the observer to finish
+    asyncStateObservers_.erase(asyncObserver);
+    return;
+  }
   auto nErased = stateObservers_.erase(observer);
   if (!nErased) {
     throw FbossError("State observer remove failed: observer does not exist");
@@ -615,6 +670,21 @@ void SwSwitch::addStateObserver(StateObserver* observer, const string& name) {
   stateObservers_.emplace(observer, name);
 }
 
+void SwSwitch::addAsyncStateObserver(
+    StateObserver* observer,
+    const string& name,
+    const AsyncStateObserverOptions& options) {
+  DCHECK(updateEventBase_.isInEventBaseThread());
+  if (stateObserverRegistered(observer) ||
+      asyncStateObservers_.find(observer) != asyncStateObservers_.end()) {
+    throw FbossError("State observer add failed: ", name, " already exists");
+  }
+  auto asyncObserver =
+      std::make_unique<AsyncStateObserver>(observer, name, options);
+  stateObservers_.emplace(asyncObserver.get(), name);
+  asyncStateObservers_.emplace(observer, std::move(asyncObserver));
+}
+
 void SwSwitch::notifyStateObservers(const StateDelta& delta) {
   CHECK(updateEventBase_.inRunningEventBaseThread());
   if (isExiting()) {
@@ -634,10 +704,16 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
 }
 
 void SwSwitch::updateState(unique_ptr<StateUpdate> update) {
+  update->enqueueTime_ = std::chrono::steady_clock::now();
+  auto priority = update->getPriority();
+  auto lane = static_cast<size_t>(priority);
+  size_t depth;
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    pendingUpdates_.push_back(*update.release());
+    pendingUpdates_[lane].push_back(*update.release());
+    depth = ++numPendingUpdates_[lane];
   }
+  stats()->stateUpdateQueueDepth(priority, depth);
 
   // Signal the update thread that updates are pending.
   // We call runInEventBaseThread() with a static function pointer since this
@@ -648,14 +724,15 @@ void SwSwitch::updateState(unique_ptr<StateUpdate> update) {
 void SwSwitch::queueStateUpdateForGettingHwInSync(
     StringPiece name,
     StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn));
+  auto update = make_unique<FunctionStateUpdate>(
+      name, std::move(fn), true, StateUpdate::Priority::HIGH);
+  update->enqueueTime_ = std::chrono::steady_clock::now();
   {
-    // Push the state update in front to preserver ordering.
-    // This is not particularly necessary, since this state
-    // update is freely coalesced with other state updates when
-    // we come to processing pending updates
+    // Push the state update in front of the hw sync updates, which lead the
+    // very next batch we process, whatever its lane. It must come first in
+    // that batch, since batches are applied on top of the applied state.
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    pendingUpdates_.push_front(*update.release());
+    hwSyncUpdates_.push_front(*update.release());
   }
   // Don't inform updateEventBase about this update being queued.
   // Rather let this update be processed with the next incoming update.
@@ -670,19 +747,31 @@ void SwSwitch::queueStateUpdateForGettingHwInSync(
   // optimizations).
 }
 
-void SwSwitch::updateState(StringPiece name, StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn));
+void SwSwitch::updateState(
+    StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
+  auto update =
+      make_unique<FunctionStateUpdate>(name, std::move(fn), true, priority);
   updateState(std::move(update));
 }
 
-void SwSwitch::updateStateNoCoalescing(StringPiece name, StateUpdateFn fn) {
-  auto update = make_unique<FunctionStateUpdate>(name, std::move(fn), false);
+void SwSwitch::updateStateNoCoalescing(
+    StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
+  auto update =
+      make_unique<FunctionStateUpdate>(name, std::move(fn), false, priority);
   updateState(std::move(update));
 }
 
-void SwSwitch::updateStateBlocking(folly::StringPiece name, StateUpdateFn fn) {
+void SwSwitch::updateStateBlocking(
+    folly::StringPiece name,
+    StateUpdateFn fn,
+    StateUpdate::Priority priority) {
   auto result = std::make_shared<BlockingUpdateResult>();
-  auto update = make_unique<BlockingStateUpdate>(name, std::move(fn), result);
+  auto update = make_unique<BlockingStateUpdate>(
+      name, std::move(fn), result, true, priority);
   updateState(std::move(update));
   result->wait();
 }
@@ -691,6 +780,34 @@ void SwSwitch::handlePendingUpdatesHelper(SwSwitch* sw) {
   sw->handlePendingUpdates();
 }
 
+size_t SwSwitch::nextLaneToServeLocked(
+    std::chrono::steady_clock::time_point now) {
+  // Serve the highest priority lane that has anything pending, unless a
+  // lower priority one has been waiting too long, in which case the one
+  // waiting longest goes first.
+  auto nextLane = pendingUpdates_.size();
+  std::chrono::milliseconds maxWait(FLAGS_state_update_max_lane_wait_ms);
+  std::optional<std::chrono::steady_clock::time_point> oldestAged;
+  for (size_t lane = 0; lane < pendingUpdates_.size(); ++lane) {
+    if (pendingUpdates_[lane].empty()) {
+      continue;
+    }
+    if (nextLane == pendingUpdates_.size()) {
+      nextLane = lane;
+    }
+    if (!maxWait.count()) {
+      break;
+    }
+    auto enqueueTime = pendingUpdates_[lane].front().enqueueTime_;
+    if (now - enqueueTime >= maxWait &&
+        (!oldestAged || enqueueTime < *oldestAged)) {
+      oldestAged = enqueueTime;
+      nextLane = lane;
+    }
+  }
+  return nextLane;
+}
+
 void SwSwitch::handlePendingUpdates() {
   // Get the list of updates to run.
   //
@@ -699,22 +816,38 @@ void SwSwitch::handlePendingUpdates() {
   // might also end up finding 0 updates to process if a previous
   // handlePendingUpdates() call processed multiple updates.
   StateUpdateList updates;
+  auto batchSizeLimit = coalescingPolicy_->getBatchSizeLimit();
+  // Whether the coalescing policy left coalescible updates behind
+  bool batchCut = false;
+  // Updates from different lanes are never coalesced, so that a high
+  // priority update does not have to wait for a large batch of lower
+  // priority ones to be programmed.
+  size_t lane;
   {
     folly::SpinLockGuard guard(pendingUpdatesLock_);
-    // When deciding how many elements to pull off the pendingUpdates_
-    // list, we pull as many as we can, while making sure we don't
-    // include any updates after an update that does not allow
-    // coalescing.
-    auto iter = pendingUpdates_.begin();
-    while (iter != pendingUpdates_.end()) {
-      StateUpdate* update = &(*iter);
-      ++iter;
-      if (!update->allowsCoalescing()) {
-        break;
+    lane = nextLaneToServeLocked(std::chrono::steady_clock::now());
+    if (lane < pendingUpdates_.size()) {
+      auto& laneUpdates = pendingUpdates_[lane];
+      // When deciding how many elements to pull off the lane, we pull as many
+      // as the coalescing policy allows, while making sure we don't include
+      // any updates after an update that does not allow coalescing.
+      auto iter = laneUpdates.begin();
+      uint32_t batchSize = 0;
+      while (iter != laneUpdates.end()) {
+        StateUpdate* update = &(*iter);
+        ++iter;
+        --numPendingUpdates_[lane];
+        if (!update->allowsCoalescing()) {
+          break;
+        }
+        if (batchSizeLimit && ++batchSize >= batchSizeLimit) {
+          batchCut = iter != laneUpdates.end();
+          break;
+        }
       }
+      updates.splice(updates.begin(), laneUpdates, laneUpdates.begin(), iter);
+      updates.splice(updates.begin(), hwSyncUpdates_);
     }
-    updates.splice(
-        updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
   }
 
   // handlePendingUpdates() is invoked once for each update, but a previous
@@ -737,11 +870,43 @@ void SwSwitch::handlePendingUpdates() {
   // oldDesiredState. This is the one we always enqueue at the front of the
   // queue whenever applied and desired states diverge. After that, other
   // supplied state updates are applied (that were spliced above).
-  auto newDesiredState = oldAppliedState;
+  //
+  // With the state update pipeline enabled, the hw update thread may still be
+  // programming earlier desired states, so we build on top of the desired
+  // state instead. The hw update thread always programs the delta from the
+  // applied state, so anything that failed to apply is retried from there.
+  auto pipelined = isStateUpdatePipelineEnabled();
+  auto startState = pipelined ? oldDesiredState : oldAppliedState;
+  auto newDesiredState = startState;
+  bool allowsCoalescing = true;
+  auto batchStart = std::chrono::steady_clock::now();
+  uint32_t batchSize = 0;
   auto iter = updates.begin();
   while (iter != updates.end()) {
+    if (batchSize &&
+        coalescingPolicy_->batchLatencyExceeded(
+            batchStart, std::chrono::steady_clock::now())) {
+      // We have spent long enough preparing this batch. Put the rest back at
+      // the front of their lane, to be picked up after this batch has been
+      // programmed.
+      StateUpdateList remaining;
+      remaining.splice(remaining.begin(), updates, iter, updates.end());
+      auto numRemaining = remaining.size();
+      {
+        folly::SpinLockGuard guard(pendingUpdatesLock_);
+        pendingUpdates_[lane].splice(pendingUpdates_[lane].begin(), remaining);
+        numPendingUpdates_[lane] += numRemaining;
+      }
+      batchCut = true;
+      break;
+    }
     StateUpdate* update = &(*iter);
     ++iter;
+    ++batchSize;
+    allowsCoalescing = update->allowsCoalescing();
+    stats()->stateUpdateQueueWait(
+        update->getPriority(),
+        duration_cast<microseconds>(batchStart - update->enqueueTime_));
 
     shared_ptr<SwitchState> intermediateState;
     XLOG(INFO) << "preparing state update " << update->getName();
@@ -768,7 +933,15 @@ void SwSwitch::handlePendingUpdates() {
   }
 
   // Now apply the update and notify subscribers
-  if (newDesiredState != oldAppliedState) {
+  if (pipelined) {
+    if (newDesiredState != startState) {
+      // Publish the new desired state right away and leave hardware
+      // programming to the hw update thread, so that we can go on preparing
+      // the next state.
+      setDesiredState(newDesiredState);
+      scheduleHwUpdate(newDesiredState, allowsCoalescing);
+    }
+  } else if (newDesiredState != oldAppliedState) {
     // There was some change during these state updates
     auto newAppliedState = applyUpdate(oldAppliedState, newDesiredState);
     // Stick the initial applied->desired in the beginning
@@ -791,6 +964,18 @@ void SwSwitch::handlePendingUpdates() {
     }
   }
 
+  coalescingPolicy_->batchApplied(
+      batchSize,
+      duration_cast<microseconds>(
+          std::chrono::steady_clock::now() - batchStart));
+  stats()->stateUpdateBatchSize(batchSize);
+  if (batchCut) {
+    // Whatever we left behind still has a handlePendingUpdates() scheduled
+    // for each update, but those may be queued behind other work on the
+    // update thread. Pick it up right after this batch.
+    updateEventBase_.runInEventBaseThread(handlePendingUpdatesHelper, this);
+  }
+
   // Notify all of the updates of success, and delete them. Success is defined
   // as SwSwitch's attempt to apply them to hw, even though they might have not
   // actually been applied yet.
@@ -810,16 +995,100 @@ void SwSwitch::setStateInternal(
   CHECK(bool(newDesiredState));
   CHECK(newAppliedState->isPublished());
   CHECK(newDesiredState->isPublished());
-  folly::SpinLockGuard guard(stateLock_);
-  appliedStateDontUseDirectly_.swap(newAppliedState);
-  desiredStateDontUseDirectly_.swap(newDesiredState);
+  auto snapshot = newDesiredState;
+  {
+    folly::SpinLockGuard guard(stateLock_);
+    appliedStateDontUseDirectly_.swap(newAppliedState);
+    desiredStateDontUseDirectly_.swap(newDesiredState);
+  }
+  // Refreshing the per-core copies is comparatively expensive, do it outside
+  // stateLock_. Desired state only changes on the update thread, so there is
+  // no race with another writer here.
+  desiredStateSnapshot_.reset(std::move(snapshot));
 }
 
 void SwSwitch::setDesiredState(std::shared_ptr<SwitchState> newDesiredState) {
   CHECK(bool(newDesiredState));
   CHECK(newDesiredState->isPublished());
+  auto snapshot = newDesiredState;
+  {
+    folly::SpinLockGuard guard(stateLock_);
+    desiredStateDontUseDirectly_.swap(newDesiredState);
+  }
+  desiredStateSnapshot_.reset(std::move(snapshot));
+}
+
+void SwSwitch::setAppliedState(std::shared_ptr<SwitchState> newAppliedState) {
+  CHECK(bool(newAppliedState));
+  CHECK(newAppliedState->isPublished());
   folly::SpinLockGuard guard(stateLock_);
-  desiredStateDontUseDirectly_.swap(newDesiredState);
+  appliedStateDontUseDirectly_.swap(newAppliedState);
+}
+
+void SwSwitch::scheduleHwUpdate(
+    std::shared_ptr<SwitchState> desiredState,
+    bool allowsCoalescing) {
+  DCHECK(updateEventBase_.inRunningEventBaseThread());
+  {
+    folly::SpinLockGuard guard(pendingHwUpdatesLock_);
+    pendingHwUpdates_.push_back({std::move(desiredState), allowsCoalescing});
+  }
+  hwUpdateEventBase_.runInEventBaseThread(handlePendingHwUpdatesHelper, this);
+}
+
+void SwSwitch::handlePendingHwUpdatesHelper(SwSwitch* sw) {
+  sw->handlePendingHwUpdates();
+}
+
+void SwSwitch::handlePendingHwUpdates() {
+  // Only the most recent of a run of coalescible desired states needs to be
+  // programmed. As with pendingUpdates_, we stop at a desired state that
+  // resulted from a non coalescible update, so that the hardware gets to
+  // see it.
+  std::shared_ptr<SwitchState> newDesiredState;
+  {
+    folly::SpinLockGuard guard(pendingHwUpdatesLock_);
+    while (!pendingHwUpdates_.empty()) {
+      auto pending = std::move(pendingHwUpdates_.front());
+      pendingHwUpdates_.pop_front();
+      newDesiredState = std::move(pending.desiredState);
+      if (!pending.allowsCoalescing) {
+        break;
+      }
+    }
+  }
+  // A previous invocation might have already programmed everything.
+  if (!newDesiredState) {
+    return;
+  }
+  auto oldAppliedState = getAppliedState();
+  if (newDesiredState == oldAppliedState || isExiting()) {
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  XLOG(INFO) << "Updating hw state: applied_gen="
+             << oldAppliedState->getGeneration()
+             << " desired_gen=" << newDesiredState->getGeneration();
+
+  auto newAppliedState =
+      programHw(StateDelta(oldAppliedState, newDesiredState));
+  setAppliedState(newAppliedState);
+  // Anything that failed to apply shows up again in the delta computed for
+  // the next desired state we get handed.
+  fb303::fbData->setCounter(
+      "hw_out_of_sync", newAppliedState != newDesiredState);
+
+  // Observers are only ever notified from the update thread.
+  updateEventBase_.runInEventBaseThread(
+      [this, oldAppliedState, newDesiredState]() {
+        notifyStateObservers(StateDelta(oldAppliedState, newDesiredState));
+      });
+
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  stats()->stateUpdate(duration);
+  XLOG(DBG0) << "Update hw state took " << duration.count() << "us";
 }
 
 std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
@@ -840,8 +1109,6 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
     return oldState;
   }
 
-  std::shared_ptr<SwitchState> newAppliedState;
-
   // Inform the HwSwitch of the change.
   //
   // Note that at this point we have already updated the state pointer and
@@ -854,20 +1121,7 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   // take a non-trivial amount of time, and blocking other users seems
   // undesirable.  So far I don't think this brief discrepancy should cause
   // major issues.
-  try {
-    newAppliedState = hw_->stateChanged(delta);
-  } catch (const std::exception& ex) {
-    // Notify the hw_ of the crash so it can execute any device specific
-    // tasks before we fatal. An example would be to dump the current hw state.
-    //
-    // Another thing we could try here is rolling back to the old state.
-    hw_->exitFatal();
-
-    dumpBadStateUpdate(oldState, newState);
-
-    XLOG(FATAL) << "error applying state change to hardware: "
-                << folly::exceptionStr(ex);
-  }
+  auto newAppliedState = programHw(delta);
 
   setStateInternal(newAppliedState, newState);
 
@@ -885,6 +1139,25 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
   return newAppliedState;
 }
 
+std::shared_ptr<SwitchState> SwSwitch::programHw(const StateDelta& delta) {
+  std::shared_ptr<SwitchState> newAppliedState;
+  try {
+    newAppliedState = hw_->stateChanged(delta);
+  } catch (const std::exception& ex) {
+    // Notify the hw_ of the crash so it can execute any device specific
+    // tasks before we fatal. An example would be to dump the current hw state.
+    //
+    // Another thing we could try here is rolling back to the old state.
+    hw_->exitFatal();
+
+    dumpBadStateUpdate(delta.oldState(), delta.newState());
+
+    XLOG(FATAL) << "error applying state change to hardware: "
+                << folly::exceptionStr(ex);
+  }
+  return newAppliedState;
+}
+
 void SwSwitch::dumpBadStateUpdate(
     const std::shared_ptr<SwitchState>& oldState,
     const std::shared_ptr<SwitchState>& newState) const {
@@ -894,13 +1167,13 @@ void SwSwitch::dumpBadStateUpdate(
   if (!dumpStateToFile(
           platform_->getCrashBadStateUpdateOldStateFile(),
           oldState->toFollyDynamic())) {
-    XLOG(ERR) << "Unable to write old switch state JSON to "
+    XLOG(ERR) << "Unable to write old switch state to "
               << platform_->getCrashBadStateUpdateOldStateFile();
   }
   if (!dumpStateToFile(
           platform_->getCrashBadStateUpdateNewStateFile(),
           newState->toFollyDynamic())) {
-    XLOG(ERR) << "Unable to write new switch state JSON to "
+    XLOG(ERR) << "Unable to write new switch state to "
               << platform_->getCrashBadStateUpdateNewStateFile();
   }
 }
@@ -1078,7 +1351,9 @@ void SwSwitch::linkStateChanged(PortID portId, bool up) {
     return newState;
   };
   updateStateNoCoalescing(
-      "Port OperState Update", std::move(updateOperStateFn));
+      "Port OperState Update",
+      std::move(updateOperStateFn),
+      StateUpdate::Priority::HIGH);
 
   // Log event and update counters
   logLinkStateEvent(portId, up);
@@ -1091,6 +1366,11 @@ void SwSwitch::startThreads() {
       [=] { this->threadLoop("fbossBgThread", &backgroundEventBase_); }));
   updateThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossUpdateThread", &updateEventBase_); }));
+  if (isStateUpdatePipelineEnabled()) {
+    hwUpdateThread_.reset(new std::thread([=] {
+      this->threadLoop("fbossHwUpdateThread", &hwUpdateEventBase_);
+    }));
+  }
   packetTxThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossPktTxThread", &packetTxEventBase_); }));
   pcapDistributionThread_.reset(new std::thread([=] {
@@ -1119,6 +1399,10 @@ void SwSwitch::stopThreads() {
     updateEventBase_.runInEventBaseThread(
         [this] { updateEventBase_.terminateLoopSoon(); });
   }
+  if (hwUpdateThread_) {
+    hwUpdateEventBase_.runInEventBaseThread(
+        [this] { hwUpdateEventBase_.terminateLoopSoon(); });
+  }
   if (packetTxThread_) {
     packetTxEventBase_.runInEventBaseThread(
         [this] { packetTxEventBase_.terminateLoopSoon(); });
@@ -1141,6 +1425,9 @@ void SwSwitch::stopThreads() {
   if (updateThread_) {
     updateThread_->join();
   }
+  if (hwUpdateThread_) {
+    hwUpdateThread_->join();
+  }
   if (packetTxThread_) {
     packetTxThread_->join();
   }
@@ -1530,6 +1817,10 @@ bool SwSwitch::isStandaloneRibEnabled() const {
   return getFlags() & SwitchFlags::ENABLE_STANDALONE_RIB;
 }
 
+bool SwSwitch::isStateUpdatePipelineEnabled() const {
+  return getFlags() & SwitchFlags::ENABLE_STATE_UPDATE_PIPELINE;
+}
+
 template <typename AddressT>
 std::shared_ptr<Route<AddressT>> SwSwitch::longestMatch(
     std::shared_ptr<SwitchState> state,
@@ -22,10 +22,13 @@
 #include <folly/Range.h>
 #include <folly/SpinLock.h>
 #include <folly/ThreadLocal.h>
+#include <folly/concurrency/CoreCachedSharedPtr.h>
 #include <folly/io/async/EventBase.h>
 #include <optional>
 
+#include <array>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -34,6 +37,8 @@
 namespace facebook::fboss {
 
 class ArpHandler;
+class AsyncStateObserver;
+struct AsyncStateObserverOptions;
 class IPv4Handler;
 class IPv6Handler;
 class LinkAggregationManager;
@@ -51,6 +56,7 @@ class StateDelta;
 class NeighborUpdater;
 class RouteUpdateLogger;
 class StateObserver;
+class StateUpdateCoalescingPolicy;
 class TunManager;
 class MirrorManager;
 class LookupClassUpdater;
@@ -66,6 +72,7 @@ enum class SwitchFlags : int {
   PUBLISH_STATS = 4,
   ENABLE_LACP = 8,
   ENABLE_STANDALONE_RIB = 16,
+  ENABLE_STATE_UPDATE_PIPELINE = 32,
 };
 
 inline SwitchFlags operator|(SwitchFlags lhs, SwitchFlags rhs) {
@@ -158,6 +165,10 @@ class SwSwitch : public HwSwitch::Callback {
    * ENABLE_LLDP: enables periodically sending LLDP packets
    * PUBLISH_STATS: if set, we will publish the boot type (graceful or
    *                   otherwise) after we initialize the hardware.
+   * ENABLE_STATE_UPDATE_PIPELINE: program the hardware from a dedicated
+   *                   thread, so that the update thread can prepare the
+   *                   next SwitchState while the previous one is being
+   *                   applied to the hardware.
    * DEFAULT: None of the above flags are set.
    *
    */
@@ -191,9 +202,15 @@ class SwSwitch : public HwSwitch::Callback {
    * date copy of the state.
    * See the comments in SwitchState.h for more details about the copy-on-write
    * semantics of SwitchState.
+   *
+   * This is the read path for packet rx, stats and thrift threads, so it does
+   * not take stateLock_. The desired state is read from a per-core cached
+   * copy, which avoids contending on the lock and on the reference count of
+   * a single shared_ptr. Use getDesiredState() when the returned state needs
+   * to be consistent with getAppliedState().
    */
   std::shared_ptr<SwitchState> getState() const {
-    return getDesiredState();
+    return desiredStateSnapshot_.get();
   }
   /**
    * Schedule an update to the switch state.
@@ -230,8 +247,18 @@ class SwSwitch : public HwSwitch::Callback {
    * send a single update notification to the HwSwitch and other update
    * subscribers.  Therefore the StateUpdateFn may be called with an
    * unpublished SwitchState in some cases.
+   *
+   * When the state update pipeline is enabled, the StateUpdateFn is applied
+   * on top of the desired state, which may not have been applied to the
+   * hardware yet.
+   *
+   * The priority picks the lane the update is queued in, see
+   * StateUpdate::Priority.
    */
-  void updateState(folly::StringPiece name, StateUpdateFn fn);
+  void updateState(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::Priority::NORMAL);
 
   /**
    * Schedule an update to the switch state.
@@ -245,7 +272,10 @@ class SwSwitch : public HwSwitch::Callback {
    * but can be used when there is an update that MUST be seen by the hw
    * implementation, even if the inverse update is immediately applied.
    */
-  void updateStateNoCoalescing(folly::StringPiece name, StateUpdateFn fn);
+  void updateStateNoCoalescing(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::Priority::NORMAL);
 
   /*
    * A version of updateState() that doesn't return until the update has been
@@ -260,8 +290,15 @@ class SwSwitch : public HwSwitch::Callback {
    * updateStateBlocking() would schedule the update to happen in the update
    * thread, and would simply block the calling thread until the operation
    * completes.
+   *
+   * With the state update pipeline enabled, this returns once the update is
+   * part of the desired state; hardware programming of it may still be in
+   * flight on the hw update thread.
    */
-  void updateStateBlocking(folly::StringPiece name, StateUpdateFn fn);
+  void updateStateBlocking(
+      folly::StringPiece name,
+      StateUpdateFn fn,
+      StateUpdate::Priority priority = StateUpdate::Priority::NORMAL);
 
   /**
    * Apply config from the config file (specified in 'config' flag).
@@ -283,6 +320,20 @@ class SwSwitch : public HwSwitch::Callback {
   void registerStateObserver(StateObserver* observer, const std::string name);
   void unregisterStateObserver(StateObserver* observer);
 
+  /*
+   * Opt-in alternative to registerStateObserver(). The observer is notified
+   * from a thread of its own, with a bounded queue of pending deltas in
+   * between, so that a slow observer does not stall hardware updates. See
+   * AsyncStateObserver for the queueing and collapsing semantics.
+   *
+   * Observers registered this way must not assume they are called from the
+   * update thread. Use unregisterStateObserver() to unregister them.
+   */
+  void registerAsyncStateObserver(
+      StateObserver* observer,
+      const std::string name,
+      const AsyncStateObserverOptions& options);
+
   /*
    * Signal to the switch that initial config is applied.
    * The switch may then use this to start certain functions
@@ -580,6 +631,8 @@ class SwSwitch : public HwSwitch::Callback {
 
   bool isStandaloneRibEnabled() const;
 
+  bool isStateUpdatePipelineEnabled() const;
+
   /*
    * Allow hardware to perform any cleanup needed to gracefully restart the
    * agent before we exit application.
@@ -686,6 +739,15 @@ class SwSwitch : public HwSwitch::Callback {
   typedef folly::IntrusiveList<StateUpdate, &StateUpdate::listHook_>
       StateUpdateList;
 
+  /*
+   * A desired state handed off from the update thread to the hw update
+   * thread, when the state update pipeline is enabled.
+   */
+  struct PendingHwUpdate {
+    std::shared_ptr<SwitchState> desiredState;
+    bool allowsCoalescing;
+  };
+
   // Forbidden copy constructor and assignment operator
   SwSwitch(SwSwitch const&) = delete;
   SwSwitch& operator=(SwSwitch const&) = delete;
@@ -705,6 +767,7 @@ class SwSwitch : public HwSwitch::Callback {
       std::shared_ptr<SwitchState> newDesiredState);
 
   void setDesiredState(std::shared_ptr<SwitchState> newDesiredState);
+  void setAppliedState(std::shared_ptr<SwitchState> newAppliedState);
 
   void publishInitTimes(std::string name, const float& time);
   void updatePortInfo();
@@ -716,9 +779,26 @@ class SwSwitch : public HwSwitch::Callback {
 
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
+  /*
+   * Lane of pendingUpdates_ to serve next, or kNumPriorities if all are
+   * empty. Must be called with pendingUpdatesLock_ held.
+   */
+  size_t nextLaneToServeLocked(std::chrono::steady_clock::time_point now);
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& oldState,
       const std::shared_ptr<SwitchState>& newState);
+  std::shared_ptr<SwitchState> programHw(const StateDelta& delta);
+
+  /*
+   * Second stage of the state update pipeline. Runs on the hw update thread
+   * and programs the hardware with the delta between the applied state and
+   * the most recent desired state handed off by handlePendingUpdates().
+   */
+  void scheduleHwUpdate(
+      std::shared_ptr<SwitchState> desiredState,
+      bool allowsCoalescing);
+  static void handlePendingHwUpdatesHelper(SwSwitch* sw);
+  void handlePendingHwUpdates();
 
   void startThreads();
   void stopThreads();
@@ -731,6 +811,10 @@ class SwSwitch : public HwSwitch::Callback {
    */
   bool stateObserverRegistered(StateObserver* observer);
   void addStateObserver(StateObserver* observer, const std::string& name);
+  void addAsyncStateObserver(
+      StateObserver* observer,
+      const std::string& name,
+      const AsyncStateObserverOptions& options);
   void removeStateObserver(StateObserver* observer);
 
   /*
@@ -775,10 +859,30 @@ class SwSwitch : public HwSwitch::Callback {
   std::unique_ptr<TunManager> tunMgr_;
 
   /*
-   * A list of pending state updates to be applied.
+   * Pending state updates to be applied, one list per
+   * StateUpdate::Priority, highest priority first.
    */
   folly::SpinLock pendingUpdatesLock_;
-  StateUpdateList pendingUpdates_;
+  std::array<StateUpdateList, StateUpdate::kNumPriorities> pendingUpdates_;
+  std::array<size_t, StateUpdate::kNumPriorities> numPendingUpdates_{};
+  /*
+   * Updates to get the hardware back in sync with the desired state. They
+   * are not in any lane, and lead the next batch of whichever lane is
+   * served, since they don't schedule a batch of their own.
+   */
+  StateUpdateList hwSyncUpdates_;
+  /*
+   * Bounds how many pending updates get coalesced into a single hardware
+   * update. Only accessed from the update thread.
+   */
+  std::unique_ptr<StateUpdateCoalescingPolicy> coalescingPolicy_;
+
+  /*
+   * Desired states waiting to be programmed by the hw update thread. Only
+   * used when the state update pipeline is enabled.
+   */
+  folly::SpinLock pendingHwUpdatesLock_;
+  std::deque<PendingHwUpdate> pendingHwUpdates_;
 
   /*
    * The current switch state: modelled as two states:
@@ -805,6 +909,12 @@ class SwSwitch : public HwSwitch::Callback {
   std::shared_ptr<SwitchState> appliedStateDontUseDirectly_;
   std::shared_ptr<SwitchState> desiredStateDontUseDirectly_;
   mutable folly::SpinLock stateLock_;
+  /*
+   * Copy of desiredStateDontUseDirectly_ for lock free readers, see
+   * getState(). Only ever written from the update thread, right after
+   * desiredStateDontUseDirectly_ changes.
+   */
+  folly::AtomicCoreCachedSharedPtr<SwitchState> desiredStateSnapshot_;
 
   /*
    * A thread for performing various background tasks.
@@ -835,6 +945,14 @@ class SwSwitch : public HwSwitch::Callback {
   folly::EventBase updateEventBase_;
   std::unique_ptr<ThreadHeartbeat> updThreadHeartbeat_;
 
+  /*
+   * A thread for programming SwitchState deltas to the hardware. Only started
+   * when the state update pipeline is enabled, otherwise the hardware is
+   * programmed from the update thread.
+   */
+  std::unique_ptr<std::thread> hwUpdateThread_;
+  folly::EventBase hwUpdateEventBase_;
+
   /*
    * A thread dedicated to LACP processing.
    */
@@ -864,6 +982,13 @@ class SwSwitch : public HwSwitch::Callback {
    * locking when we access the container during a state update.
    */
   std::map<StateObserver*, std::string> stateObservers_;
+  /*
+   * Observers registered with registerAsyncStateObserver(), keyed by the
+   * observer itself. The AsyncStateObserver is what gets registered in
+   * stateObservers_. Only accessed from the update thread as well.
+   */
+  std::map<StateObserver*, std::unique_ptr<AsyncStateObserver>>
+      asyncStateObservers_;
 
   std::unique_ptr<ArpHandler> arp_;
   std::unique_ptr<IPv4Handler> ipv4_;
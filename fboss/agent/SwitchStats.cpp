@@ -79,7 +79,55 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      stateUpdateQueueWaitHigh_(
+          map,
+          kCounterPrefix + "state_update.queue_wait.high.us",
+          50000,
+          0,
+          1000000),
+      stateUpdateQueueWaitNormal_(
+          map,
+          kCounterPrefix + "state_update.queue_wait.normal.us",
+          50000,
+          0,
+          1000000),
+      stateUpdateQueueWaitLow_(
+          map,
+          kCounterPrefix + "state_update.queue_wait.low.us",
+          50000,
+          0,
+          1000000),
+      stateUpdateQueueDepthHigh_(
+          map,
+          kCounterPrefix + "state_update.queue_depth.high",
+          1,
+          0,
+          200),
+      stateUpdateQueueDepthNormal_(
+          map,
+          kCounterPrefix + "state_update.queue_depth.normal",
+          1,
+          0,
+          200),
+      stateUpdateQueueDepthLow_(
+          map,
+          kCounterPrefix + "state_update.queue_depth.low",
+          1,
+          0,
+          200),
+      stateUpdateBatchSize_(
+          map,
+          kCounterPrefix + "state_update.batch_size",
+          1,
+          0,
+          200),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
+      hwStatsCollection_(
+          map,
+          kCounterPrefix + "hw_stats_collection.us",
+          1000,
+          0,
+          100000),
       bgHeartbeatDelay_(
           map,
           kCounterPrefix + "bg_heartbeat_delay.ms",
@@ -15,6 +15,7 @@
 #include <chrono>
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/state/StateUpdate.h"
 #include "fboss/agent/types.h"
 
 namespace facebook::fboss {
@@ -226,6 +227,40 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  void stateUpdateQueueWait(
+      StateUpdate::Priority priority,
+      std::chrono::microseconds us) {
+    switch (priority) {
+      case StateUpdate::Priority::HIGH:
+        stateUpdateQueueWaitHigh_.addValue(us.count());
+        break;
+      case StateUpdate::Priority::NORMAL:
+        stateUpdateQueueWaitNormal_.addValue(us.count());
+        break;
+      case StateUpdate::Priority::LOW:
+        stateUpdateQueueWaitLow_.addValue(us.count());
+        break;
+    }
+  }
+
+  void stateUpdateQueueDepth(StateUpdate::Priority priority, size_t depth) {
+    switch (priority) {
+      case StateUpdate::Priority::HIGH:
+        stateUpdateQueueDepthHigh_.addValue(depth);
+        break;
+      case StateUpdate::Priority::NORMAL:
+        stateUpdateQueueDepthNormal_.addValue(depth);
+        break;
+      case StateUpdate::Priority::LOW:
+        stateUpdateQueueDepthLow_.addValue(depth);
+        break;
+    }
+  }
+
+  void stateUpdateBatchSize(uint32_t batchSize) {
+    stateUpdateBatchSize_.addValue(batchSize);
+  }
+
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
     // As syncFib() could include no routes.
     if (routes == 0) {
@@ -234,6 +269,10 @@ class SwitchStats : public boost::noncopyable {
     routeUpdate_.addRepeatedValue(us.count() / routes, routes);
   }
 
+  void hwStatsCollection(std::chrono::microseconds us) {
+    hwStatsCollection_.addValue(us.count());
+  }
+
   void bgHeartbeatDelay(int delay) {
     bgHeartbeatDelay_.addValue(delay);
   }
@@ -411,11 +450,39 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram updateState_;
 
+  /**
+   * Histograms for time state updates spend queued before the update thread
+   * picks them up (in microsecond), per StateUpdate::Priority lane
+   */
+  TLHistogram stateUpdateQueueWaitHigh_;
+  TLHistogram stateUpdateQueueWaitNormal_;
+  TLHistogram stateUpdateQueueWaitLow_;
+
+  /**
+   * Histograms for the number of pending state updates, sampled when an
+   * update is queued, per StateUpdate::Priority lane
+   */
+  TLHistogram stateUpdateQueueDepthHigh_;
+  TLHistogram stateUpdateQueueDepthNormal_;
+  TLHistogram stateUpdateQueueDepthLow_;
+
+  /**
+   * Histogram for the number of state updates coalesced into a single
+   * hardware update
+   */
+  TLHistogram stateUpdateBatchSize_;
+
   /**
    * Histogram for time used for route update (in microsecond)
    */
   TLHistogram routeUpdate_;
 
+  /**
+   * Histogram for time used to collect hardware stats, per collection
+   * cycle (in microsecond)
+   */
+  TLHistogram hwStatsCollection_;
+
   /**
    * Background thread heartbeat delay (ms)
    */
@@ -138,12 +138,14 @@ void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const std::set<folly::CIDRNetwork>* changedPrefixes,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
-  sw->updateStateBlocking("", std::move(fibUpdater));
+  sw->updateStateBlocking(
+      "", std::move(fibUpdater), facebook::fboss::StateUpdate::Priority::LOW);
 }
 
 void fillPortStats(PortInfoThrift& portInfo, int numPortQs) {
@@ -630,7 +632,8 @@ void ThriftHandler::deleteUnicastRoutesInVrf(
     newState->resetRouteTables(std::move(newRt));
     return newState;
   };
-  sw_->updateStateBlocking("delete unicast route", updateFn);
+  sw_->updateStateBlocking(
+      "delete unicast route", updateFn, StateUpdate::Priority::LOW);
 }
 
 void ThriftHandler::deleteUnicastRoutes(
@@ -755,7 +758,7 @@ void ThriftHandler::updateUnicastRoutesImpl(
     newState->resetRouteTables(std::move(newRt));
     return newState;
   };
-  sw_->updateStateBlocking(updType, updateFn);
+  sw_->updateStateBlocking(updType, updateFn, StateUpdate::Priority::LOW);
 }
 
 static void populateInterfaceDetail(
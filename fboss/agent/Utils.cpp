@@ -13,6 +13,7 @@
 #include <sys/syscall.h>
 
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/StateSerialization.h"
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/InterfaceMap.h"
@@ -91,7 +92,9 @@ void incNiceValue(const uint32_t increment) {
 }
 
 bool dumpStateToFile(const std::string& filename, const folly::dynamic& json) {
-  return folly::writeFile(folly::toPrettyJson(json), filename.c_str());
+  return folly::writeFile(
+      serializeState(json, defaultStateSerializationFormat()),
+      filename.c_str());
 }
 
 std::string getLocalHostname() {
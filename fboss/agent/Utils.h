@@ -76,7 +76,9 @@ folly::IPAddressV6 getSwitchVlanIPv6(
 void incNiceValue(const uint32_t increment);
 
 /*
- * Serialize folly dynamic to JSON and write to file
+ * Serialize folly dynamic to JSON, or the binary format selected by
+ * --binary_switch_state, and write to file. Use readStateFromFile() to read
+ * it back.
  */
 bool dumpStateToFile(const std::string& filename, const folly::dynamic& json);
 
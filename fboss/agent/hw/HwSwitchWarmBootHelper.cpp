@@ -10,11 +10,16 @@
 
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/StateSerialization.h"
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/Utils.h"
+#include "fboss/agent/state/StreamingStateWriter.h"
+#include "fboss/agent/state/SwitchState.h"
 
-#include <folly/FileUtil.h>
-#include <folly/json.h>
+#include <folly/Conv.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/logging/xlog.h>
 
 DEFINE_bool(can_warm_boot, true, "Enable/disable warm boot functionality");
@@ -22,6 +27,11 @@ DEFINE_string(
     switch_state_file,
     "switch_state",
     "File for dumping switch state JSON in on exit");
+DEFINE_uint32(
+    warm_boot_state_threads,
+    4,
+    "Number of threads to deserialize the switch state on warm boot with. "
+    "0 or 1 deserializes it on the calling thread.");
 
 namespace {
 constexpr auto wbFlagPrefix = "can_warm_boot_";
@@ -139,12 +149,46 @@ bool HwSwitchWarmBootHelper::storeWarmBootState(
   return warmBootStateWritten_;
 }
 
+bool HwSwitchWarmBootHelper::storeWarmBootState(
+    folly::dynamic switchState,
+    const std::shared_ptr<SwitchState>& swState) {
+  if (!swState) {
+    return storeWarmBootState(switchState);
+  }
+  if (!streamWarmBootState()) {
+    switchState[kSwSwitch] = swState->toFollyDynamic();
+    return storeWarmBootState(switchState);
+  }
+  StreamingStateWriter writer(warmBootSwitchStateFile());
+  writer.beginObject();
+  for (const auto& item : switchState.items()) {
+    writer.key(item.first.asString());
+    writer.value(item.second);
+  }
+  writer.key(kSwSwitch);
+  swState->writeTo(writer);
+  writer.endObject();
+  warmBootStateWritten_ = writer.finish();
+  XLOG(DBG1) << "Streamed " << writer.bytesWritten()
+             << " bytes of warm boot state";
+  return warmBootStateWritten_;
+}
+
 folly::dynamic HwSwitchWarmBootHelper::getWarmBootState() const {
-  std::string warmBootJson;
-  auto ret = folly::readFile(warmBootSwitchStateFile().c_str(), warmBootJson);
-  sysCheckError(
-      ret, "Unable to read switch state from : ", warmBootSwitchStateFile());
-  return folly::parseJson(warmBootJson);
+  return readStateFromFile(warmBootSwitchStateFile());
+}
+
+std::unique_ptr<SwitchState> HwSwitchWarmBootHelper::getWarmBootSwitchState(
+    const folly::dynamic& warmBootState) {
+  const auto& swSwitchJson = warmBootState[kSwSwitch];
+  if (FLAGS_warm_boot_state_threads <= 1) {
+    return SwitchState::uniquePtrFromFollyDynamic(swSwitchJson);
+  }
+  // Joins its threads when it goes out of scope
+  folly::CPUThreadPoolExecutor executor(
+      FLAGS_warm_boot_state_threads,
+      std::make_shared<folly::NamedThreadFactory>("WarmBootState"));
+  return SwitchState::uniquePtrFromFollyDynamic(swSwitchJson, &executor);
 }
 
 void HwSwitchWarmBootHelper::setupWarmBootFile() {
@@ -11,10 +11,13 @@
 
 #include <folly/dynamic.h>
 
+#include <memory>
 #include <string>
 
 namespace facebook::fboss {
 
+class SwitchState;
+
 /*
  * This class encapsulates much of the warm boot functionality for an individual
  * HwSwitch. It will store all the files necessary to perform warm boot on a
@@ -41,7 +44,23 @@ class HwSwitchWarmBootHelper {
   void setCanWarmBoot();
 
   bool storeWarmBootState(const folly::dynamic& switchState);
+  /*
+   * Store swState under kSwSwitch, along with the entries in switchState.
+   * If streamWarmBootState(), swState is streamed to the file without
+   * building its folly::dynamic. A null swState means switchState already
+   * holds it.
+   */
+  bool storeWarmBootState(
+      folly::dynamic switchState,
+      const std::shared_ptr<SwitchState>& swState);
   folly::dynamic getWarmBootState() const;
+  /*
+   * Rebuild the SwitchState stored under kSwSwitch in warmBootState. Its
+   * larger subtrees are deserialized in parallel, on a pool of
+   * --warm_boot_state_threads threads.
+   */
+  static std::unique_ptr<SwitchState> getWarmBootSwitchState(
+      const folly::dynamic& warmBootState);
 
   std::string startupSdkDumpFile() const;
   std::string shutdownSdkDumpFile() const;
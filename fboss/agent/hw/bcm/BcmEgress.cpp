@@ -322,12 +322,18 @@ void BcmEcmpEgress::program() {
                << paths_.size() << " paths";
   }
   CHECK_NE(id_, INVALID);
+  hw_->writableEgressManager()->ecmpEgressProgrammed(id_, paths_);
 }
 
 BcmEcmpEgress::~BcmEcmpEgress() {
   if (id_ == INVALID) {
     return;
   }
+  // Before destroying it, so that the linkscan callback is not removing
+  // paths from it
+  if (auto egressManager = hw_->writableEgressManager()) {
+    egressManager->ecmpEgressDestroyed(id_, paths_);
+  }
   bcm_l3_egress_ecmp_t obj;
   bcm_l3_egress_ecmp_t_init(&obj);
   obj.ecmp_intf = id_;
@@ -75,6 +75,54 @@ void BcmEgressManager::linkStateChangedMaybeLocked(
   }
 }
 
+void BcmEgressManager::linkDownInLinkscanCallback(bcm_port_t port) {
+  const auto portAndEgressIds =
+      getPortAndEgressIdsMap()->getPortAndEgressIdsIf(BcmPort::asGPort(port));
+  if (!portAndEgressIds) {
+    return;
+  }
+  auto egressToEcmpIds = egressToEcmpIds_.rlock();
+  for (auto egressId : portAndEgressIds->getEgressIds()) {
+    auto ecmpIds = egressToEcmpIds->find(egressId);
+    if (ecmpIds == egressToEcmpIds->end()) {
+      continue;
+    }
+    for (auto [ecmpId, pathCount] : ecmpIds->second) {
+      for (size_t i = 0; i < pathCount; ++i) {
+        BcmEcmpEgress::removeEgressIdHwNotLocked(
+            hw_->getUnit(), ecmpId, egressId);
+      }
+    }
+  }
+}
+
+void BcmEgressManager::ecmpEgressProgrammed(
+    bcm_if_t ecmpId,
+    const BcmEcmpEgress::Paths& paths) {
+  auto egressToEcmpIds = egressToEcmpIds_.wlock();
+  // Paths is a multiset, so each distinct path comes with its count
+  for (auto path = paths.begin(); path != paths.end();
+       path = paths.upper_bound(*path)) {
+    (*egressToEcmpIds)[*path][ecmpId] = paths.count(*path);
+  }
+}
+
+void BcmEgressManager::ecmpEgressDestroyed(
+    bcm_if_t ecmpId,
+    const BcmEcmpEgress::Paths& paths) {
+  auto egressToEcmpIds = egressToEcmpIds_.wlock();
+  for (auto path : paths) {
+    auto ecmpIds = egressToEcmpIds->find(path);
+    if (ecmpIds == egressToEcmpIds->end()) {
+      continue;
+    }
+    ecmpIds->second.erase(ecmpId);
+    if (ecmpIds->second.empty()) {
+      egressToEcmpIds->erase(ecmpIds);
+    }
+  }
+}
+
 int BcmEgressManager::removeAllEgressesFromEcmpCallback(
     int unit,
     bcm_l3_egress_ecmp_t* ecmp,
@@ -12,6 +12,7 @@
 #include <boost/container/flat_set.hpp>
 
 #include <folly/SpinLock.h>
+#include <folly/Synchronized.h>
 
 extern "C" {
 #include <bcm/l3.h>
@@ -46,6 +47,15 @@ class BcmEgressManager {
     linkStateChangedMaybeLocked(
         BcmTrunk::asGPort(trunk), false /*down*/, false /*not locked*/);
   }
+  /*
+   * Fast path for link down, called straight from the SDK linkscan
+   * callback rather than its bottom half, see
+   * FLAGS_ecmp_shrink_in_linkscan_callback. Only removes the port's
+   * egresses from the ECMP groups known to use them, rather than
+   * traversing all ECMP groups in HW. linkDownHwNotLocked still runs
+   * from the bottom half afterwards, and removes any egress missed here.
+   */
+  void linkDownInLinkscanCallback(bcm_port_t port);
   void linkDownHwLocked(bcm_port_t port) {
     // Just call the non locked counterpart here.
     // We don't really need the lock for link down
@@ -75,6 +85,18 @@ class BcmEgressManager {
     return portAndEgressIdsDontUseDirectly_;
   }
 
+  /*
+   * Record which ECMP groups each egress is a path of, for
+   * linkDownInLinkscanCallback. Called by BcmEcmpEgress while holding the
+   * hw lock.
+   */
+  void ecmpEgressProgrammed(
+      bcm_if_t ecmpId,
+      const BcmEcmpEgress::Paths& paths);
+  void ecmpEgressDestroyed(
+      bcm_if_t ecmpId,
+      const BcmEcmpEgress::Paths& paths);
+
   bool isResolved(const bcm_if_t egressId) const {
     return resolvedEgresses_.find(egressId) != resolvedEgresses_.end();
   }
@@ -119,6 +141,16 @@ class BcmEgressManager {
   std::shared_ptr<PortAndEgressIdsMap> portAndEgressIdsDontUseDirectly_;
   mutable folly::SpinLock portAndEgressIdsLock_;
   boost::container::flat_set<bcm_if_t> resolvedEgresses_;
+  /*
+   * ECMP groups each egress is a path of, with the number of times it is a
+   * path of each: weighted groups repeat paths, and each
+   * bcm_l3_egress_ecmp_delete only removes one of them. Read from the
+   * linkscan callback, which holds its lock while removing paths, so that
+   * no ECMP group is destroyed under it.
+   */
+  using EcmpIdToPathCount = boost::container::flat_map<bcm_if_t, size_t>;
+  folly::Synchronized<boost::container::flat_map<bcm_if_t, EcmpIdToPathCount>>
+      egressToEcmpIds_;
 };
 
 } // namespace facebook::fboss
@@ -160,6 +160,12 @@ DEFINE_int32(
     60,
     "Update BST stats for ODS interval in seconds");
 DEFINE_bool(force_init_fp, true, "Force full field processor initialization");
+DEFINE_bool(
+    ecmp_shrink_in_linkscan_callback,
+    false,
+    "Remove the egresses of a port that went down from the ECMP groups "
+    "using them in the linkscan callback itself, rather than waiting for "
+    "its bottom half");
 DEFINE_string(
     script_pre_asic_init,
     "script_pre_asic_init",
@@ -481,7 +487,9 @@ void BcmSwitch::unregisterCallbacks() {
   }
 }
 
-void BcmSwitch::gracefulExit(folly::dynamic& switchState) {
+void BcmSwitch::gracefulExit(
+    folly::dynamic& switchState,
+    const std::shared_ptr<SwitchState>& swState) {
   steady_clock::time_point begin = steady_clock::now();
   XLOG(INFO) << "[Exit] Starting BCM Switch graceful exit";
   // Ideally, preparePortsForGracefulExit() would run in update EVB of the
@@ -497,7 +505,7 @@ void BcmSwitch::gracefulExit(folly::dynamic& switchState) {
   dumpState(platform_->getWarmBootHelper()->shutdownSdkDumpFile());
 
   switchState[kHwSwitch] = toFollyDynamic();
-  unitObject_->writeWarmBootState(switchState);
+  unitObject_->writeWarmBootState(std::move(switchState), swState);
   unitObject_.reset();
   XLOG(INFO)
       << "[Exit] BRCM Graceful Exit time "
@@ -2217,6 +2225,11 @@ void BcmSwitch::linkscanCallback(
     BcmSwitch* hw = static_cast<BcmSwitch*>(unitObj->getCookie());
     bool up = info->linkstatus == BCM_PORT_LINK_STATUS_UP;
 
+    if (!up && FLAGS_ecmp_shrink_in_linkscan_callback) {
+      // The bottom half goes through all ECMP groups again, and does the
+      // rest of link down handling
+      hw->writableEgressManager()->linkDownInLinkscanCallback(bcmPort);
+    }
     hw->linkScanBottomHalfEventBase_.runInEventBaseThread(
         [hw, bcmPort, up]() { hw->linkStateChangedHwNotLocked(bcmPort, up); });
   } catch (const std::exception& ex) {
@@ -347,7 +347,9 @@ class BcmSwitch : public BcmSwitchIf {
    * state changes while we are calling cleanup
    * shutdown apis in the BCM sdk.
    */
-  void gracefulExit(folly::dynamic& switchState) override;
+  void gracefulExit(
+      folly::dynamic& switchState,
+      const std::shared_ptr<SwitchState>& swState) override;
 
   /*
    * BcmSwitch state as folly::dynamic
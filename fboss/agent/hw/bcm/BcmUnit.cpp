@@ -183,7 +183,9 @@ BcmUnit::BcmUnit(int deviceIndex, BcmPlatform* platform)
   unit_ = createHwUnit();
 }
 
-void BcmUnit::writeWarmBootState(const folly::dynamic& switchState) {
+void BcmUnit::writeWarmBootState(
+    folly::dynamic switchState,
+    const std::shared_ptr<SwitchState>& swState) {
   steady_clock::time_point begin = steady_clock::now();
   XLOG(INFO) << " [Exit] Syncing BRCM switch state to file";
   // Force the device to write out its warm boot state
@@ -196,7 +198,7 @@ void BcmUnit::writeWarmBootState(const folly::dynamic& switchState) {
       << duration_cast<duration<float>>(bcmWarmBootSyncDone - begin).count();
   // Now write our state to file
   XLOG(INFO) << " [Exit] Syncing FBOSS switch state to file";
-  if (!warmBootHelper()->storeWarmBootState(switchState)) {
+  if (!warmBootHelper()->storeWarmBootState(std::move(switchState), swState)) {
     XLOG(FATAL) << "Unable to write switch state JSON to file";
   }
   steady_clock::time_point fbossWarmBootSyncDone = steady_clock::now();
@@ -25,6 +25,7 @@ struct dynamic;
 namespace facebook::fboss {
 
 class BcmWarmBootHelper;
+class SwitchState;
 
 class BcmUnit {
  public:
@@ -48,7 +49,9 @@ class BcmUnit {
   /*
    * Flush warm boot state to disk,
    */
-  void writeWarmBootState(const folly::dynamic& switchState);
+  void writeWarmBootState(
+      folly::dynamic switchState,
+      const std::shared_ptr<SwitchState>& swState);
 
   bool isAttached() const {
     return attached_.load(std::memory_order_acquire);
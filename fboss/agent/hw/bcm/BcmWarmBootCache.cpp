@@ -21,7 +21,9 @@
 
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
+#include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/SysError.h"
+#include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/bcm/BcmAclEntry.h"
 #include "fboss/agent/hw/bcm/BcmAclTable.h"
 #include "fboss/agent/hw/bcm/BcmAddressFBConvertors.h"
@@ -181,13 +183,17 @@ folly::dynamic BcmWarmBootCache::toFollyDynamic() const {
 }
 
 folly::dynamic BcmWarmBootCache::getWarmBootState() const {
-  return hw_->getPlatform()->getWarmBootHelper()->getWarmBootState();
+  auto warmBootState =
+      hw_->getPlatform()->getWarmBootHelper()->getWarmBootState();
+  restart_time::mark(RestartEvent::WARM_BOOT_STATE_READ);
+  return warmBootState;
 }
 
 void BcmWarmBootCache::populateFromWarmBootState(
     const folly::dynamic& warmBootState) {
   dumpedSwSwitchState_ =
-      SwitchState::uniquePtrFromFollyDynamic(warmBootState[kSwSwitch]);
+      HwSwitchWarmBootHelper::getWarmBootSwitchState(warmBootState);
+  restart_time::mark(RestartEvent::WARM_BOOT_STATE_DESERIALIZED);
   // TODO(ccpowers): remove this loop once we've fully rolled out the
   // new configuration, and we store the profile ID in the WB cache
   for (auto port : *dumpedSwSwitchState_->getPorts()) {
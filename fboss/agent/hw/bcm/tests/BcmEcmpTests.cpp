@@ -25,6 +25,7 @@
 #include "fboss/agent/hw/test/ConfigFactory.h"
 
 #include <folly/IPAddress.h>
+#include <gflags/gflags.h>
 
 #include <boost/container/flat_set.hpp>
 
@@ -37,6 +38,7 @@ extern "C" {
 #include <bcm/port.h>
 }
 
+DECLARE_bool(ecmp_shrink_in_linkscan_callback);
 DECLARE_uint32(ecmp_width);
 
 using boost::container::flat_set;
@@ -270,6 +272,29 @@ TEST_F(BcmEcmpTest, L2ResolveAllNhopsInUcmpThenLinkDown) {
   ASSERT_EQ(7, pathsInHwCount);
 }
 
+// Test link down in UCMP scenario, shrinking ECMP groups from the linkscan
+// callback
+TEST_F(BcmEcmpTest, L2ResolveAllNhopsInUcmpThenLinkDownInLinkscanCallback) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_ecmp_shrink_in_linkscan_callback = true;
+  runSimpleTest({3, 1, 1, 1, 1, 1, 1, 1}, {3, 1, 1, 1, 1, 1, 1, 1}, false);
+  auto ecmpEgress = getEcmpEgress();
+  auto egressIdsInSw = ecmpEgress->paths();
+  auto port = ecmpHelper_->nhop(0).portDesc.phyPortID();
+
+  // The fast path on its own must remove every copy of the weighted path,
+  // without the bottom half's traversal of all ECMP groups
+  getHwSwitch()->writableEgressManager()->linkDownInLinkscanCallback(port);
+  auto pathsInHwCount =
+      getEcmpSizeInHw(getUnit(), ecmpEgress->getID(), egressIdsInSw.size());
+  ASSERT_EQ(7, pathsInHwCount);
+
+  bringDownPort(port);
+  pathsInHwCount =
+      getEcmpSizeInHw(getUnit(), ecmpEgress->getID(), egressIdsInSw.size());
+  ASSERT_EQ(7, pathsInHwCount);
+}
+
 // Test link flap in UCMP scenario
 TEST_F(BcmEcmpTest, L2ResolveBothNhopsInUcmpThenLinkFlap) {
   runSimpleTest({3, 1, 1, 1, 1, 1, 1, 1}, {3, 1, 1, 1, 1, 1, 1, 1}, false);
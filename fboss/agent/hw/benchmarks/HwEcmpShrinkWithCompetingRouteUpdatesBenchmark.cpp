@@ -20,6 +20,7 @@
 
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <gflags/gflags.h>
 
 #include <thread>
 
@@ -27,8 +28,19 @@ namespace facebook::fboss {
 
 using utility::getEcmpSizeInHw;
 
-BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
+namespace {
+
+/*
+ * With shrinkInLinkscanCallback, egresses are removed from ECMP groups in
+ * the linkscan callback itself, on HwSwitch implementations that support
+ * it (--ecmp_shrink_in_linkscan_callback), rather than in its bottom half.
+ */
+void ecmpShrinkWithCompetingRouteUpdates(bool shrinkInLinkscanCallback) {
   folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  if (shrinkInLinkscanCallback) {
+    gflags::SetCommandLineOption("ecmp_shrink_in_linkscan_callback", "true");
+  }
   constexpr int kEcmpWidth = 4;
   auto ensemble = createHwEnsemble(
       HwSwitch::PACKET_RX_DESIRED | HwSwitch::LINKSCAN_DESIRED);
@@ -94,4 +106,14 @@ BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
   t.join();
 }
 
+} // namespace
+
+BENCHMARK(HwEcmpGroupShrinkWithCompetingRouteUpdates) {
+  ecmpShrinkWithCompetingRouteUpdates(false);
+}
+
+BENCHMARK(HwEcmpGroupShrinkInLinkscanCallbackWithCompetingRouteUpdates) {
+  ecmpShrinkWithCompetingRouteUpdates(true);
+}
+
 } // namespace facebook::fboss
@@ -22,29 +22,54 @@
 #include <folly/init/Init.h>
 #include <folly/json.h>
 
+#include <sys/resource.h>
+
 #include <chrono>
 #include <iostream>
 
 DEFINE_bool(json, true, "Output in json form");
+DECLARE_bool(binary_switch_state);
+DECLARE_bool(stream_warm_boot_state);
 
 namespace {
 class StopWatch {
  public:
-  StopWatch() : startTime_(std::chrono::steady_clock::now()) {}
+  StopWatch()
+      : startTime_(std::chrono::steady_clock::now()),
+        startMaxRssKb_(maxRssKb()) {}
   ~StopWatch() {
     std::chrono::duration<double, std::milli> durationMillseconds =
         std::chrono::steady_clock::now() - startTime_;
+    // How far peak RSS grew past its level before exit, i.e. the memory
+    // spent on writing out warm boot state
+    auto peakRssGrowthKb = maxRssKb() - startMaxRssKb_;
     if (FLAGS_json) {
       folly::dynamic warmBootTime = folly::dynamic::object;
       warmBootTime["warm_boot_msecs"] = durationMillseconds.count();
+      warmBootTime["peak_rss_growth_kb"] = peakRssGrowthKb;
+      // Run with and without --binary_switch_state and
+      // --stream_warm_boot_state to compare
+      warmBootTime["binary_switch_state"] = FLAGS_binary_switch_state;
+      warmBootTime["stream_warm_boot_state"] = FLAGS_stream_warm_boot_state;
       std::cout << warmBootTime << std::endl;
     } else {
-      XLOG(INFO) << " warm boot msecs: " << durationMillseconds.count();
+      XLOG(INFO) << " warm boot msecs: " << durationMillseconds.count()
+                 << " peak rss growth kb: " << peakRssGrowthKb
+                 << " binary switch state: " << FLAGS_binary_switch_state
+                 << " stream warm boot state: "
+                 << FLAGS_stream_warm_boot_state;
     }
   }
 
  private:
+  static int64_t maxRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+  }
+
   std::chrono::time_point<std::chrono::steady_clock> startTime_;
+  int64_t startMaxRssKb_;
 };
 } // namespace
 namespace facebook::fboss {
@@ -92,6 +92,9 @@ SAI_ATTRIBUTE_NAME(Fdb, BridgePortId)
 
 template <>
 struct IsSaiEntryStruct<SaiFdbTraits::FdbEntry> : public std::true_type {};
+template <>
+struct AdapterKeyHasBulkApi<SaiFdbTraits::FdbEntry>
+    : public std::true_type {};
 
 class FdbApi : public SaiApi<FdbApi> {
  public:
@@ -123,6 +126,52 @@ class FdbApi : public SaiApi<FdbApi> {
     return api_->set_fdb_entry_attribute(fdbEntry.entry(), attr);
   }
 
+  sai_status_t _bulkCreate(
+      const std::vector<SaiFdbTraits::FdbEntry>& fdbEntries,
+      const uint32_t* attr_counts,
+      const sai_attribute_t** attr_lists,
+      sai_status_t* statuses) {
+    if (!api_->create_fdb_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(fdbEntries);
+    return api_->create_fdb_entries(
+        entries.size(),
+        entries.data(),
+        attr_counts,
+        attr_lists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<SaiFdbTraits::FdbEntry>& fdbEntries,
+      sai_status_t* statuses) {
+    if (!api_->remove_fdb_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(fdbEntries);
+    return api_->remove_fdb_entries(
+        entries.size(),
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkSetAttribute(
+      const std::vector<SaiFdbTraits::FdbEntry>& fdbEntries,
+      const sai_attribute_t* attr_list,
+      sai_status_t* statuses) {
+    if (!api_->set_fdb_entries_attribute) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(fdbEntries);
+    return api_->set_fdb_entries_attribute(
+        entries.size(),
+        entries.data(),
+        attr_list,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+
   sai_fdb_api_t* api_;
   friend class SaiApi<FdbApi>;
 };
@@ -94,6 +94,9 @@ SAI_ATTRIBUTE_NAME(Neighbor, DstMac)
 template <>
 struct IsSaiEntryStruct<SaiNeighborTraits::NeighborEntry>
     : public std::true_type {};
+template <>
+struct AdapterKeyHasBulkApi<SaiNeighborTraits::NeighborEntry>
+    : public std::true_type {};
 
 class NeighborApi : public SaiApi<NeighborApi> {
  public:
@@ -125,6 +128,52 @@ class NeighborApi : public SaiApi<NeighborApi> {
     return api_->set_neighbor_entry_attribute(neighborEntry.entry(), attr);
   }
 
+  sai_status_t _bulkCreate(
+      const std::vector<SaiNeighborTraits::NeighborEntry>& neighborEntries,
+      const uint32_t* attr_counts,
+      const sai_attribute_t** attr_lists,
+      sai_status_t* statuses) {
+    if (!api_->create_neighbor_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(neighborEntries);
+    return api_->create_neighbor_entries(
+        entries.size(),
+        entries.data(),
+        attr_counts,
+        attr_lists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<SaiNeighborTraits::NeighborEntry>& neighborEntries,
+      sai_status_t* statuses) {
+    if (!api_->remove_neighbor_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(neighborEntries);
+    return api_->remove_neighbor_entries(
+        entries.size(),
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkSetAttribute(
+      const std::vector<SaiNeighborTraits::NeighborEntry>& neighborEntries,
+      const sai_attribute_t* attr_list,
+      sai_status_t* statuses) {
+    if (!api_->set_neighbor_entries_attribute) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(neighborEntries);
+    return api_->set_neighbor_entries_attribute(
+        entries.size(),
+        entries.data(),
+        attr_list,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+
   sai_neighbor_api_t* api_;
   friend class SaiApi<NeighborApi>;
 };
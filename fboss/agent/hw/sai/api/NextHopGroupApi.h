@@ -19,6 +19,7 @@
 
 #include <set>
 #include <tuple>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -84,6 +85,10 @@ SAI_ATTRIBUTE_NAME(NextHopGroupMember, NextHopGroupId)
 SAI_ATTRIBUTE_NAME(NextHopGroupMember, NextHopId)
 SAI_ATTRIBUTE_NAME(NextHopGroupMember, Weight)
 
+template <>
+struct AdapterKeyHasBulkRemove<NextHopGroupMemberSaiId>
+    : public std::true_type {};
+
 class NextHopGroupApi : public SaiApi<NextHopGroupApi> {
  public:
   static constexpr sai_api_t ApiType = SAI_API_NEXT_HOP_GROUP;
@@ -137,6 +142,39 @@ class NextHopGroupApi : public SaiApi<NextHopGroupApi> {
     return api_->set_next_hop_group_member_attribute(id, attr);
   }
 
+  sai_status_t _bulkCreate(
+      NextHopGroupMemberSaiId* ids,
+      sai_object_id_t switch_id,
+      size_t count,
+      const uint32_t* attr_counts,
+      const sai_attribute_t** attr_lists,
+      sai_status_t* statuses) {
+    if (!api_->create_next_hop_group_members) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    return api_->create_next_hop_group_members(
+        switch_id,
+        count,
+        attr_counts,
+        attr_lists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        rawSaiId(ids),
+        statuses);
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<NextHopGroupMemberSaiId>& ids,
+      sai_status_t* statuses) {
+    if (!api_->remove_next_hop_group_members) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    std::vector<sai_object_id_t> rawIds(ids.begin(), ids.end());
+    return api_->remove_next_hop_group_members(
+        rawIds.size(),
+        rawIds.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+
   sai_next_hop_group_api_t* api_;
   friend class SaiApi<NextHopGroupApi>;
 };
@@ -95,6 +95,9 @@ struct SaiRouteTraits {
 };
 template <>
 struct IsSaiEntryStruct<SaiRouteTraits::RouteEntry> : public std::true_type {};
+template <>
+struct AdapterKeyHasBulkApi<SaiRouteTraits::RouteEntry>
+    : public std::true_type {};
 
 SAI_ATTRIBUTE_NAME(Route, PacketAction)
 SAI_ATTRIBUTE_NAME(Route, NextHopId)
@@ -130,6 +133,52 @@ class RouteApi : public SaiApi<RouteApi> {
     return api_->set_route_entry_attribute(routeEntry.entry(), attr);
   }
 
+  sai_status_t _bulkCreate(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      const uint32_t* attr_counts,
+      const sai_attribute_t** attr_lists,
+      sai_status_t* statuses) {
+    if (!api_->create_route_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(routeEntries);
+    return api_->create_route_entries(
+        entries.size(),
+        entries.data(),
+        attr_counts,
+        attr_lists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkRemove(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      sai_status_t* statuses) {
+    if (!api_->remove_route_entries) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(routeEntries);
+    return api_->remove_route_entries(
+        entries.size(),
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+  sai_status_t _bulkSetAttribute(
+      const std::vector<SaiRouteTraits::RouteEntry>& routeEntries,
+      const sai_attribute_t* attr_list,
+      sai_status_t* statuses) {
+    if (!api_->set_route_entries_attribute) {
+      return SAI_STATUS_NOT_IMPLEMENTED;
+    }
+    auto entries = saiEntries(routeEntries);
+    return api_->set_route_entries_attribute(
+        entries.size(),
+        entries.data(),
+        attr_list,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        statuses);
+  }
+
   sai_route_api_t* api_;
   friend class SaiApi<RouteApi>;
 };
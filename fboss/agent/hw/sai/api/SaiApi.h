@@ -14,6 +14,7 @@
 #include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiAttribute.h"
 #include "fboss/agent/hw/sai/api/SaiAttributeDataTypes.h"
+#include "fboss/agent/hw/sai/api/SaiBulkApiQueue.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
 #include "fboss/lib/TupleUtils.h"
 
@@ -22,9 +23,10 @@
 
 #include <algorithm>
 #include <exception>
-#include <mutex>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 extern "C" {
@@ -33,6 +35,19 @@ extern "C" {
 
 namespace facebook::fboss {
 
+// The SAI structs of entries, in an array as bulk calls take them
+template <typename EntryT>
+auto saiEntries(const std::vector<EntryT>& entries) {
+  using SaiEntryT = std::remove_cv_t<
+      std::remove_pointer_t<decltype(std::declval<EntryT>().entry())>>;
+  std::vector<SaiEntryT> saiEntryTs;
+  saiEntryTs.reserve(entries.size());
+  for (const auto& entry : entries) {
+    saiEntryTs.push_back(*entry.entry());
+  }
+  return saiEntryTs;
+}
+
 template <typename ApiT>
 class SaiApi {
  public:
@@ -65,7 +80,8 @@ class SaiApi {
         "invalid traits for the api");
     typename SaiObjectTraits::AdapterKey key;
     std::vector<sai_attribute_t> saiAttributeTs = saiAttrs(createAttributes);
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     sai_status_t status = impl()._create(
         &key, switch_id, saiAttributeTs.size(), saiAttributeTs.data());
     saiApiCheckError(status, ApiT::ApiType, "Failed to create sai entity");
@@ -82,8 +98,17 @@ class SaiApi {
     static_assert(
         std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
         "invalid traits for the api");
+    if constexpr (AdapterKeyHasBulkApi<
+                      typename SaiObjectTraits::AdapterKey>::value) {
+      if (auto calls = queuedCalls<BulkCreateCalls<SaiObjectTraits>>()) {
+        calls->add(entry, createAttributes);
+        return;
+      }
+    } else {
+      issueQueuedCalls();
+    }
     std::vector<sai_attribute_t> saiAttributeTs = saiAttrs(createAttributes);
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     sai_status_t status =
         impl()._create(entry, saiAttributeTs.size(), saiAttributeTs.data());
     saiApiCheckError(status, ApiT::ApiType, "Failed to create sai entity");
@@ -92,7 +117,15 @@ class SaiApi {
 
   template <typename AdapterKeyT>
   void remove(const AdapterKeyT& key) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    if constexpr (AdapterKeyHasBulkRemove<AdapterKeyT>::value) {
+      if (auto calls = queuedCalls<BulkRemoveCalls<AdapterKeyT>>()) {
+        calls->add(key);
+        return;
+      }
+    } else {
+      issueQueuedCalls();
+    }
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     sai_status_t status = impl()._remove(key);
     saiApiCheckError(status, ApiT::ApiType, "Failed to remove sai object");
     XLOGF(DBG5, "removed SAI object: {}", key);
@@ -119,7 +152,8 @@ class SaiApi {
         IsSaiAttribute<typename std::remove_reference<AttrT>::type>::value,
         "getAttribute must be called on a SaiAttribute or supported "
         "collection of SaiAttributes");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lockForRead(ApiT::ApiType);
     sai_status_t status;
     status = impl()._getAttribute(key, attr.saiAttr());
     /*
@@ -195,12 +229,111 @@ class SaiApi {
 
   template <typename AdapterKeyT, typename AttrT>
   void setAttribute(const AdapterKeyT& key, const AttrT& attr) {
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    if constexpr (AdapterKeyHasBulkApi<AdapterKeyT>::value) {
+      if (!saiAttr(attr)) {
+        issueQueuedCalls();
+      } else if (auto calls = queuedCalls<BulkSetCalls<AdapterKeyT, AttrT>>()) {
+        calls->add(key, attr);
+        return;
+      }
+    } else {
+      issueQueuedCalls();
+    }
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     auto status = impl()._setAttribute(key, saiAttr(attr));
     saiApiCheckError(status, ApiT::ApiType, "Failed to set attribute");
     XLOGF(DBG5, "set SAI attribute of {} to {}", key, attr);
   }
 
+  /*
+   * Create, remove or set an attribute of many objects at once, through the
+   * SAI bulk API, for objects which have bulk calls (see
+   * AdapterKeyHasBulkApi). They stop at the first object which fails, and
+   * raise its error. Adapters which don't implement bulk calls get the
+   * objects one at a time.
+   */
+
+  // entry struct case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<AdapterKeyIsEntryStruct<SaiObjectTraits>::value, void>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    bulkCreateLocked<SaiObjectTraits>(entries, createAttributes);
+  }
+
+  // sai_object_id_t case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsObjectId<SaiObjectTraits>::value,
+      std::vector<typename SaiObjectTraits::AdapterKey>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes,
+      sai_object_id_t switch_id) {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    BulkAttributes attributes(createAttributes);
+    std::vector<typename SaiObjectTraits::AdapterKey> keys(
+        createAttributes.size());
+    std::vector<sai_status_t> statuses(keys.size());
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    sai_status_t status = impl()._bulkCreate(
+        keys.data(),
+        switch_id,
+        keys.size(),
+        attributes.counts.data(),
+        attributes.lists.data(),
+        statuses.data());
+    if (status == SAI_STATUS_NOT_IMPLEMENTED) {
+      for (size_t i = 0; i < keys.size(); ++i) {
+        status = impl()._create(
+            &keys[i],
+            switch_id,
+            attributes.counts[i],
+            attributes.attributes[i].data());
+        saiApiCheckError(status, ApiT::ApiType, "Failed to create sai entity");
+      }
+    } else {
+      checkBulkError(status, statuses, "Failed to create sai entities");
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      XLOGF(DBG5, "created SAI object: {}: {}", keys[i], createAttributes[i]);
+    }
+    return keys;
+  }
+
+  template <typename AdapterKeyT>
+  void bulkRemove(const std::vector<AdapterKeyT>& keys) {
+    static_assert(
+        AdapterKeyHasBulkRemove<AdapterKeyT>::value,
+        "bulkRemove only supported for Sai objects with bulk remove");
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    bulkRemoveLocked(keys);
+  }
+
+  // Set attrs[i] of the object keyed by keys[i]
+  template <typename AdapterKeyT, typename AttrT>
+  void bulkSetAttribute(
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<AttrT>& attrs) {
+    static_assert(
+        AdapterKeyHasBulkApi<AdapterKeyT>::value,
+        "bulkSetAttribute only supported for Sai objects with bulk api");
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    bulkSetAttributeLocked(keys, attrs);
+  }
+
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStats(
       const typename SaiObjectTraits::AdapterKey& key,
@@ -208,7 +341,8 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    issueQueuedCalls();
+    auto g = lockForStats<SaiObjectTraits>();
     return getStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size());
   }
@@ -218,7 +352,8 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "getStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    issueQueuedCalls();
+    auto g = lockForStats<SaiObjectTraits>();
     XLOGF(DBG5, "got SAI stats for {}", key);
     return getStatsImpl<SaiObjectTraits>(
         key,
@@ -232,7 +367,8 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     return clearStatsImpl<SaiObjectTraits>(
         key, counterIds.data(), counterIds.size());
   }
@@ -241,14 +377,259 @@ class SaiApi {
     static_assert(
         SaiObjectHasStats<SaiObjectTraits>::value,
         "clearStats only supported for Sai objects with stats");
-    std::lock_guard<std::mutex> g{SaiApiLock::getInstance()->lock};
+    issueQueuedCalls();
+    auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
     return clearStatsImpl<SaiObjectTraits>(
         key,
         SaiObjectTraits::CounterIds.data(),
         SaiObjectTraits::CounterIds.size());
   }
 
+  /*
+   * Get or clear the same counters of many objects, taking the SaiApiLock
+   * once per kBulkStatsChunkSize objects rather than once per object. The
+   * lock is let go between chunks, so a stats cycle over many objects
+   * doesn't hold off programming for its whole length. The SAI version we
+   * build against has no bulk stats call, so each object is still read
+   * with its own call.
+   */
+  template <typename SaiObjectTraits>
+  std::vector<std::vector<uint64_t>> bulkGetStats(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& keys,
+      const std::vector<sai_stat_id_t>& counterIds) const {
+    static_assert(
+        SaiObjectHasStats<SaiObjectTraits>::value,
+        "bulkGetStats only supported for Sai objects with stats");
+    issueQueuedCalls();
+    std::vector<std::vector<uint64_t>> counters;
+    counters.reserve(keys.size());
+    for (size_t start = 0; start < keys.size(); start += kBulkStatsChunkSize) {
+      auto end = std::min(keys.size(), start + kBulkStatsChunkSize);
+      auto g = lockForStats<SaiObjectTraits>();
+      for (auto i = start; i < end; ++i) {
+        counters.push_back(getStatsImpl<SaiObjectTraits>(
+            keys[i], counterIds.data(), counterIds.size()));
+      }
+    }
+    return counters;
+  }
+  template <typename SaiObjectTraits>
+  std::vector<std::vector<uint64_t>> bulkGetStats(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& keys) const {
+    return bulkGetStats<SaiObjectTraits>(
+        keys,
+        std::vector<sai_stat_id_t>(
+            SaiObjectTraits::CounterIds.begin(),
+            SaiObjectTraits::CounterIds.end()));
+  }
+  template <typename SaiObjectTraits>
+  void bulkClearStats(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& keys,
+      const std::vector<sai_stat_id_t>& counterIds) const {
+    static_assert(
+        SaiObjectHasStats<SaiObjectTraits>::value,
+        "bulkClearStats only supported for Sai objects with stats");
+    issueQueuedCalls();
+    for (size_t start = 0; start < keys.size(); start += kBulkStatsChunkSize) {
+      auto end = std::min(keys.size(), start + kBulkStatsChunkSize);
+      auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+      for (auto i = start; i < end; ++i) {
+        clearStatsImpl<SaiObjectTraits>(
+            keys[i], counterIds.data(), counterIds.size());
+      }
+    }
+  }
+
  private:
+  static constexpr size_t kBulkStatsChunkSize = 32;
+
+  /*
+   * SAI attributes of each of many objects, in the form the bulk calls take
+   */
+  struct BulkAttributes {
+    template <typename CreateAttributesT>
+    explicit BulkAttributes(
+        const std::vector<CreateAttributesT>& createAttributes) {
+      attributes.reserve(createAttributes.size());
+      for (const auto& objectAttributes : createAttributes) {
+        attributes.push_back(saiAttrs(objectAttributes));
+        counts.push_back(attributes.back().size());
+        lists.push_back(attributes.back().data());
+      }
+    }
+    std::vector<std::vector<sai_attribute_t>> attributes;
+    std::vector<uint32_t> counts;
+    std::vector<const sai_attribute_t*> lists;
+  };
+
+  template <typename SaiObjectTraits>
+  void bulkCreateLocked(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) {
+    BulkAttributes attributes(createAttributes);
+    std::vector<sai_status_t> statuses(entries.size());
+    sai_status_t status = impl()._bulkCreate(
+        entries,
+        attributes.counts.data(),
+        attributes.lists.data(),
+        statuses.data());
+    if (status == SAI_STATUS_NOT_IMPLEMENTED) {
+      for (size_t i = 0; i < entries.size(); ++i) {
+        status = impl()._create(
+            entries[i],
+            attributes.counts[i],
+            attributes.attributes[i].data());
+        saiApiCheckError(status, ApiT::ApiType, "Failed to create sai entity");
+      }
+    } else {
+      checkBulkError(status, statuses, "Failed to create sai entities");
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+      XLOGF(
+          DBG5, "created SAI object: {}: {}", entries[i], createAttributes[i]);
+    }
+  }
+
+  template <typename AdapterKeyT>
+  void bulkRemoveLocked(const std::vector<AdapterKeyT>& keys) {
+    std::vector<sai_status_t> statuses(keys.size());
+    sai_status_t status = impl()._bulkRemove(keys, statuses.data());
+    if (status == SAI_STATUS_NOT_IMPLEMENTED) {
+      for (const auto& key : keys) {
+        status = impl()._remove(key);
+        saiApiCheckError(status, ApiT::ApiType, "Failed to remove sai object");
+      }
+    } else {
+      checkBulkError(status, statuses, "Failed to remove sai objects");
+    }
+    for (const auto& key : keys) {
+      XLOGF(DBG5, "removed SAI object: {}", key);
+    }
+  }
+
+  template <typename AdapterKeyT, typename AttrT>
+  void bulkSetAttributeLocked(
+      const std::vector<AdapterKeyT>& keys,
+      const std::vector<AttrT>& attrs) {
+    std::vector<sai_attribute_t> saiAttributeTs;
+    saiAttributeTs.reserve(attrs.size());
+    for (const auto& attr : attrs) {
+      saiAttributeTs.push_back(*saiAttr(attr));
+    }
+    std::vector<sai_status_t> statuses(keys.size());
+    sai_status_t status =
+        impl()._bulkSetAttribute(keys, saiAttributeTs.data(), statuses.data());
+    if (status == SAI_STATUS_NOT_IMPLEMENTED) {
+      for (size_t i = 0; i < keys.size(); ++i) {
+        status = impl()._setAttribute(keys[i], &saiAttributeTs[i]);
+        saiApiCheckError(status, ApiT::ApiType, "Failed to set attribute");
+      }
+    } else {
+      checkBulkError(status, statuses, "Failed to set attributes");
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+      XLOGF(DBG5, "set SAI attribute of {} to {}", keys[i], attrs[i]);
+    }
+  }
+
+  // Raise the error of the first object which failed, if any did
+  void checkBulkError(
+      sai_status_t status,
+      const std::vector<sai_status_t>& statuses,
+      const char* msg) const {
+    for (auto objectStatus : statuses) {
+      saiApiCheckError(objectStatus, ApiT::ApiType, msg);
+    }
+    saiApiCheckError(status, ApiT::ApiType, msg);
+  }
+
+  /*
+   * Calls queued on the SaiBulkApiQueue, to be issued as one bulk call
+   */
+  template <typename SaiObjectTraits>
+  class BulkCreateCalls : public SaiBulkApiQueue::Calls {
+   public:
+    explicit BulkCreateCalls(SaiApi& api) : api_(api) {}
+    void add(
+        const typename SaiObjectTraits::AdapterKey& entry,
+        const typename SaiObjectTraits::CreateAttributes& createAttributes) {
+      entries_.push_back(entry);
+      createAttributes_.push_back(createAttributes);
+    }
+    void issue() override {
+      auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+      api_.template bulkCreateLocked<SaiObjectTraits>(
+          entries_, createAttributes_);
+    }
+
+   private:
+    SaiApi& api_;
+    std::vector<typename SaiObjectTraits::AdapterKey> entries_;
+    std::vector<typename SaiObjectTraits::CreateAttributes> createAttributes_;
+  };
+
+  template <typename AdapterKeyT>
+  class BulkRemoveCalls : public SaiBulkApiQueue::Calls {
+   public:
+    explicit BulkRemoveCalls(SaiApi& api) : api_(api) {}
+    void add(const AdapterKeyT& key) {
+      keys_.push_back(key);
+    }
+    void issue() override {
+      auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+      api_.bulkRemoveLocked(keys_);
+    }
+
+   private:
+    SaiApi& api_;
+    std::vector<AdapterKeyT> keys_;
+  };
+
+  template <typename AdapterKeyT, typename AttrT>
+  class BulkSetCalls : public SaiBulkApiQueue::Calls {
+   public:
+    explicit BulkSetCalls(SaiApi& api) : api_(api) {}
+    void add(const AdapterKeyT& key, const AttrT& attr) {
+      keys_.push_back(key);
+      attrs_.push_back(attr);
+    }
+    void issue() override {
+      auto g = SaiApiLock::getInstance()->lock(ApiT::ApiType);
+      api_.bulkSetAttributeLocked(keys_, attrs_);
+    }
+
+   private:
+    SaiApi& api_;
+    std::vector<AdapterKeyT> keys_;
+    std::vector<AttrT> attrs_;
+  };
+
+  /*
+   * Queued calls to add this call to, if calls are being queued. Like
+   * issueQueuedCalls, it must be called before taking the SaiApiLock, as
+   * queued calls of other APIs may be issued.
+   */
+  template <typename CallsT>
+  CallsT* queuedCalls() {
+    return SaiBulkApiQueue::get().queue<CallsT>(*this);
+  }
+
+  // Issue queued calls before a call which can't be queued with them
+  void issueQueuedCalls() const {
+    SaiBulkApiQueue::get().issue();
+  }
+
+  // Stats reads which also clear the counters change the adapter's state
+  template <typename SaiObjectTraits>
+  SaiApiLock::Guard lockForStats() const {
+    if constexpr (SaiObjectTraits::CounterMode == SAI_STATS_MODE_READ) {
+      return SaiApiLock::getInstance()->lockForRead(ApiT::ApiType);
+    } else {
+      return SaiApiLock::getInstance()->lock(ApiT::ApiType);
+    }
+  }
+
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStatsImpl(
       const typename SaiObjectTraits::AdapterKey& key,
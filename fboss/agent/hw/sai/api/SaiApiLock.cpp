@@ -11,7 +11,18 @@
 #include "fboss/agent/hw/sai/api/SaiApiLock.h"
 
 #include <folly/Singleton.h>
-#include <mutex>
+#include <gflags/gflags.h>
+
+DEFINE_bool(
+    sai_per_api_lock,
+    false,
+    "Serialize SAI calls per API type rather than across all APIs. Only "
+    "for adapters which can take calls to different APIs concurrently");
+DEFINE_bool(
+    sai_shared_api_reads,
+    false,
+    "Let SAI attribute gets and stats reads share the lock of their API. "
+    "Only for adapters which can take concurrent reads");
 
 namespace {
 struct singleton_tag_type {};
@@ -21,3 +32,14 @@ static folly::Singleton<SaiApiLock, singleton_tag_type> saiApiLockSingleton{};
 std::shared_ptr<SaiApiLock> SaiApiLock::getInstance() {
   return saiApiLockSingleton.try_get();
 }
+
+folly::SharedMutex& SaiApiLock::mutex(sai_api_t apiType) {
+  if (FLAGS_sai_per_api_lock && apiType < perApi_.size()) {
+    return perApi_[apiType];
+  }
+  return global_;
+}
+
+bool SaiApiLock::sharedReads() const {
+  return FLAGS_sai_shared_api_reads;
+}
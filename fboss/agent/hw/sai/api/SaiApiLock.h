@@ -9,11 +9,68 @@
  */
 #pragma once
 
+#include <folly/SharedMutex.h>
+
+#include <array>
 #include <memory>
-#include <mutex>
 
+extern "C" {
+#include <sai.h>
+}
+
+/*
+ * Serializes calls into the SAI adapter.
+ *
+ * Adapters are not required to be thread safe, so by default every SAI
+ * call takes one process wide lock. Adapters which can take calls to
+ * different APIs at once can be given a lock per API type instead, with
+ * --sai_per_api_lock. Those which can also take concurrent reads, i.e.
+ * attribute gets and stats reads, of the same API can let readers share
+ * its lock, with --sai_shared_api_reads.
+ */
 class SaiApiLock {
  public:
+  class Guard {
+   public:
+    Guard(folly::SharedMutex& mutex, bool shared)
+        : mutex_(mutex), shared_(shared) {
+      if (shared_) {
+        mutex_.lock_shared();
+      } else {
+        mutex_.lock();
+      }
+    }
+    ~Guard() {
+      if (shared_) {
+        mutex_.unlock_shared();
+      } else {
+        mutex_.unlock();
+      }
+    }
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+   private:
+    folly::SharedMutex& mutex_;
+    bool shared_;
+  };
+
   static std::shared_ptr<SaiApiLock> getInstance();
-  std::mutex lock;
+
+  // Lock for a call which may change the state of the adapter
+  Guard lock(sai_api_t apiType) {
+    return Guard(mutex(apiType), false);
+  }
+  // Lock for a call which only reads the state of the adapter
+  Guard lockForRead(sai_api_t apiType) {
+    return Guard(mutex(apiType), sharedReads());
+  }
+
+ private:
+  folly::SharedMutex& mutex(sai_api_t apiType);
+  bool sharedReads() const;
+
+  folly::SharedMutex global_;
+  // APIs past SAI_API_MAX, e.g. extensions, share the global lock
+  std::array<folly::SharedMutex, SAI_API_MAX> perApi_;
 };
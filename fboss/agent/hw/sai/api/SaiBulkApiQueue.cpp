@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/SaiBulkApiQueue.h"
+
+#include <folly/logging/xlog.h>
+
+#include <exception>
+
+namespace facebook::fboss {
+
+SaiBulkApiQueue& SaiBulkApiQueue::get() {
+  static thread_local SaiBulkApiQueue queue;
+  return queue;
+}
+
+SaiBulkApiScope::SaiBulkApiScope()
+    : uncaughtExceptions_(std::uncaught_exceptions()) {
+  ++SaiBulkApiQueue::get().scopes_;
+}
+
+SaiBulkApiScope::~SaiBulkApiScope() {
+  auto& queue = SaiBulkApiQueue::get();
+  if (--queue.scopes_) {
+    return;
+  }
+  try {
+    queue.issue();
+  } catch (const std::exception& ex) {
+    if (std::uncaught_exceptions() > uncaughtExceptions_) {
+      // Already unwinding from an earlier failure, which is the one to report
+      XLOG(ERR) << "Failed to issue queued SAI bulk calls while unwinding: "
+                << ex.what();
+      return;
+    }
+    // The SAI no longer matches what its callers think they programmed
+    XLOG(FATAL) << "Failed to issue queued SAI bulk calls: " << ex.what();
+  }
+}
+
+} // namespace facebook::fboss
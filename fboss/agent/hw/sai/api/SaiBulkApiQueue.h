@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace facebook::fboss {
+
+/*
+ * SaiBulkApiQueue holds SAI calls which are waiting to be issued together
+ * through the SAI bulk API. Each thread has its own.
+ *
+ * While a SaiBulkApiScope is alive, SaiApi queues the creates, removes and
+ * attribute sets made from its thread of objects which have bulk calls
+ * (see AdapterKeyHasBulkApi), rather than issue them one by one. A run of
+ * calls of the same kind, e.g. route entry creates, is issued as one bulk
+ * call. Any other SAI call from the thread issues the queued calls first,
+ * so the adapter still sees its calls in the order they were made. Calls
+ * from other threads may not see queued objects until the scope ends.
+ *
+ * Errors of queued calls are only raised once they are issued, from the
+ * SAI call which issued them.
+ *
+ * Queued calls take the SaiApiLock of their API when they are issued, so
+ * the queue must not be used with one held.
+ */
+class SaiBulkApiQueue {
+ public:
+  class Calls {
+   public:
+    virtual ~Calls() = default;
+    virtual void issue() = 0;
+  };
+
+  // The queue of the calling thread
+  static SaiBulkApiQueue& get();
+
+  /*
+   * Queued calls of type CallsT to add a call to, or nullptr if calls are
+   * not being queued, in which case the call must be made
+   * right away. Either way, queued calls of any other type are issued.
+   */
+  template <typename CallsT, typename... Args>
+  CallsT* queue(Args&&... args) {
+    if (!queueing()) {
+      issue();
+      return nullptr;
+    }
+    if (auto calls = dynamic_cast<CallsT*>(queued_.get())) {
+      return calls;
+    }
+    issue();
+    auto calls = std::make_unique<CallsT>(std::forward<Args>(args)...);
+    auto rawCalls = calls.get();
+    queued_ = std::move(calls);
+    return rawCalls;
+  }
+
+  void issue() {
+    if (queued_) {
+      // Don't leave them queued if they fail
+      auto calls = std::move(queued_);
+      calls->issue();
+    }
+  }
+
+ private:
+  friend class SaiBulkApiScope;
+
+  bool queueing() const {
+    return scopes_ > 0;
+  }
+
+  std::unique_ptr<Calls> queued_;
+  int scopes_{0};
+};
+
+/*
+ * Queue calls made from this thread to the SAI bulk API until the outermost
+ * scope ends, which issues what is still queued. The queued calls are still
+ * issued if the scope ends by an exception, since the objects they were made
+ * for clean up after themselves through the SAI as the stack unwinds.
+ */
+class SaiBulkApiScope {
+ public:
+  SaiBulkApiScope();
+  ~SaiBulkApiScope();
+
+  SaiBulkApiScope(const SaiBulkApiScope&) = delete;
+  SaiBulkApiScope& operator=(const SaiBulkApiScope&) = delete;
+
+ private:
+  const int uncaughtExceptions_;
+};
+
+} // namespace facebook::fboss
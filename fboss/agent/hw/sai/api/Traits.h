@@ -169,6 +169,18 @@ struct SaiObjectHasStats : public std::false_type {};
 template <typename SaiObjectTraits>
 struct SaiObjectHasConditionalAttributes : public std::false_type {};
 
+/*
+ * Adapter keys of objects which the SAI bulk API can create, remove and set
+ * an attribute of, many at a time. Only entry structs can be created in bulk
+ * by SaiApi, as objects keyed by id must get theirs back right away.
+ */
+template <typename AdapterKeyT>
+struct AdapterKeyHasBulkApi : public std::false_type {};
+
+// Adapter keys of objects which the SAI bulk API can remove
+template <typename AdapterKeyT>
+struct AdapterKeyHasBulkRemove : public AdapterKeyHasBulkApi<AdapterKeyT> {};
+
 template <typename ObjectTrait>
 using AdapterHostKeyTrait = typename ObjectTrait::AdapterHostKey;
 
@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 using namespace facebook::fboss;
 
 class NextHopGroupApiTest : public ::testing::Test {
@@ -85,6 +87,27 @@ TEST_F(NextHopGroupApiTest, removeNextHopGroupMember) {
   nextHopGroupApi->remove(nextHopGroupMemberId);
 }
 
+TEST_F(NextHopGroupApiTest, bulkCreateRemoveNextHopGroupMembers) {
+  auto nextHopGroupId = nextHopGroupApi->create<SaiNextHopGroupTraits>(
+      {SAI_NEXT_HOP_GROUP_TYPE_ECMP}, 0);
+  checkNextHopGroup(nextHopGroupId);
+  sai_uint32_t nextHopWeight = 2;
+  std::vector<SaiNextHopGroupMemberTraits::CreateAttributes> createAttributes;
+  for (sai_object_id_t nextHopId = 42; nextHopId < 46; ++nextHopId) {
+    createAttributes.push_back({nextHopGroupId, nextHopId, nextHopWeight});
+  }
+  auto nextHopGroupMemberIds =
+      nextHopGroupApi->bulkCreate<SaiNextHopGroupMemberTraits>(
+          createAttributes, 0);
+  ASSERT_EQ(nextHopGroupMemberIds.size(), createAttributes.size());
+  for (auto nextHopGroupMemberId : nextHopGroupMemberIds) {
+    checkNextHopGroupMember(
+        nextHopGroupId, nextHopGroupMemberId, nextHopWeight);
+  }
+  nextHopGroupApi->bulkRemove(nextHopGroupMemberIds);
+  nextHopGroupApi->remove(nextHopGroupId);
+}
+
 TEST_F(NextHopGroupApiTest, formatNextHopGroupAttributes) {
   SaiNextHopGroupTraits::Attributes::Type t{SAI_NEXT_HOP_GROUP_TYPE_ECMP};
   EXPECT_EQ("Type: 0", fmt::format("{}", t));
@@ -11,10 +11,13 @@
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include <gtest/gtest.h>
 
+#include <map>
+#include <utility>
 #include <vector>
 
 using namespace facebook::fboss;
@@ -249,3 +252,70 @@ TEST_F(PortApiTest, getSome) {
       id, {SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_IN_UCAST_PKTS});
   EXPECT_EQ(stats.size(), 2);
 }
+
+namespace {
+/*
+ * The fake SAI has no dataplane, so its port counters always read 0. Keep
+ * counters which bulkGetStats can tell apart and bulkClearStats can clear.
+ */
+std::map<std::pair<sai_object_id_t, sai_stat_id_t>, uint64_t> portCounters;
+
+sai_status_t getPortCounters(
+    sai_object_id_t port,
+    uint32_t num_of_counters,
+    const sai_stat_id_t* counter_ids,
+    uint64_t* counters) {
+  for (auto i = 0; i < num_of_counters; ++i) {
+    counters[i] = portCounters[{port, counter_ids[i]}];
+  }
+  return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t clearPortCounters(
+    sai_object_id_t port,
+    uint32_t num_of_counters,
+    const sai_stat_id_t* counter_ids) {
+  for (auto i = 0; i < num_of_counters; ++i) {
+    portCounters[{port, counter_ids[i]}] = 0;
+  }
+  return SAI_STATUS_SUCCESS;
+}
+} // namespace
+
+TEST_F(PortApiTest, bulkGetStats) {
+  sai_port_api_t* fakePortApi;
+  sai_api_query(SAI_API_PORT, reinterpret_cast<void**>(&fakePortApi));
+  auto getPortStats = fakePortApi->get_port_stats;
+  auto clearPortStats = fakePortApi->clear_port_stats;
+  fakePortApi->get_port_stats = &getPortCounters;
+  fakePortApi->clear_port_stats = &clearPortCounters;
+  // Even if an assertion fails, so that later tests get the fake SAI back
+  SCOPE_EXIT {
+    fakePortApi->get_port_stats = getPortStats;
+    fakePortApi->clear_port_stats = clearPortStats;
+    portCounters.clear();
+  };
+
+  // More ports than are read under one hold of the SaiApiLock
+  std::vector<PortSaiId> ids;
+  for (uint32_t i = 0; i < 40; ++i) {
+    auto id = createPort(25000, {i}, true);
+    portCounters[{id, SAI_PORT_STAT_IF_IN_OCTETS}] = 1000 + i;
+    portCounters[{id, SAI_PORT_STAT_IF_IN_UCAST_PKTS}] = 10 + i;
+    ids.push_back(id);
+  }
+  auto stats = portApi->bulkGetStats<SaiPortTraits>(
+      ids, {SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_IN_UCAST_PKTS});
+  ASSERT_EQ(stats.size(), ids.size());
+  for (uint32_t i = 0; i < ids.size(); ++i) {
+    EXPECT_EQ(stats[i], std::vector<uint64_t>({1000 + i, 10 + i}));
+  }
+
+  portApi->bulkClearStats<SaiPortTraits>(ids, {SAI_PORT_STAT_IF_IN_OCTETS});
+  stats = portApi->bulkGetStats<SaiPortTraits>(
+      ids, {SAI_PORT_STAT_IF_IN_OCTETS, SAI_PORT_STAT_IF_IN_UCAST_PKTS});
+  ASSERT_EQ(stats.size(), ids.size());
+  for (uint32_t i = 0; i < ids.size(); ++i) {
+    EXPECT_EQ(stats[i], std::vector<uint64_t>({0, 10 + i}));
+  }
+}
@@ -11,11 +11,13 @@
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
+#include <folly/Conv.h>
 #include <folly/IPAddress.h>
 #include <folly/logging/xlog.h>
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
 #include <vector>
 
 using namespace facebook::fboss;
@@ -158,6 +160,77 @@ TEST_F(RouteApiTest, routeKeys) {
   EXPECT_EQ(routeKeys[0], r);
 }
 
+TEST_F(RouteApiTest, bulkCreateSetRemoveRoutes) {
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  std::vector<SaiRouteTraits::CreateAttributes> createAttributes;
+  for (int i = 0; i < 4; ++i) {
+    folly::CIDRNetwork prefix(
+        folly::IPAddress(folly::to<std::string>("10.0.", i, ".0")), 24);
+    routes.emplace_back(0, 0, prefix);
+    createAttributes.push_back(
+        {SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_FORWARD},
+         SaiRouteTraits::Attributes::NextHopId(i + 1),
+         std::nullopt});
+  }
+  routeApi->bulkCreate<SaiRouteTraits>(routes, createAttributes);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), routes.size());
+  for (int i = 0; i < routes.size(); ++i) {
+    EXPECT_EQ(
+        routeApi->getAttribute(
+            routes[i], SaiRouteTraits::Attributes::NextHopId()),
+        i + 1);
+  }
+
+  std::vector<SaiRouteTraits::Attributes::NextHopId> nextHopIds(
+      routes.size(), SaiRouteTraits::Attributes::NextHopId(42));
+  routeApi->bulkSetAttribute(routes, nextHopIds);
+  for (const auto& route : routes) {
+    EXPECT_EQ(
+        routeApi->getAttribute(route, SaiRouteTraits::Attributes::NextHopId()),
+        42);
+  }
+
+  routeApi->bulkRemove(routes);
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
+TEST_F(RouteApiTest, queueRouteCalls) {
+  SaiRouteTraits::RouteEntry r4(0, 0, folly::CIDRNetwork(ip4, 24));
+  SaiRouteTraits::RouteEntry r6(0, 0, folly::CIDRNetwork(ip6, 64));
+  SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+      SAI_PACKET_ACTION_DROP};
+  {
+    SaiBulkApiScope bulkApiScope;
+    routeApi->create<SaiRouteTraits>(
+        r4, {packetActionAttribute, std::nullopt, std::nullopt});
+    routeApi->create<SaiRouteTraits>(
+        r6, {packetActionAttribute, std::nullopt, std::nullopt});
+    EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+    // Issued before anything is read back
+    EXPECT_EQ(
+        routeApi->getAttribute(r4, SaiRouteTraits::Attributes::PacketAction()),
+        SAI_PACKET_ACTION_DROP);
+    EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 2);
+    routeApi->remove(r4);
+    routeApi->remove(r6);
+    EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 2);
+  }
+  // Issued at the end of the scope
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), 0);
+}
+
+TEST_F(RouteApiTest, queuedRouteCallFailsWhileUnwinding) {
+  SaiRouteTraits::RouteEntry r(0, 0, folly::CIDRNetwork(ip4, 24));
+  auto unwind = [&]() {
+    SaiBulkApiScope bulkApiScope;
+    // Fails once issued, as there is no such route
+    routeApi->remove(r);
+    throw std::runtime_error("update failed");
+  };
+  // The failure of the queued call doesn't mask the one in flight
+  EXPECT_THROW(unwind(), std::runtime_error);
+}
+
 TEST_F(RouteApiTest, formatRouteNextHopId) {
   SaiRouteTraits::Attributes::NextHopId nhid{42};
   std::string expected("NextHopId: 42");
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+#include <folly/init/Init.h>
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <sai.h>
+}
+
+DEFINE_int32(stats_readers, 4, "Number of threads reading port stats");
+DEFINE_int32(
+    stats_read_usecs,
+    20,
+    "Time each port stats read takes in the adapter. The fake SAI has no "
+    "dataplane to read, so it is made to take about as long as hardware");
+
+DECLARE_bool(sai_per_api_lock);
+DECLARE_bool(sai_shared_api_reads);
+
+/*
+ * Route programming from one thread while others collect port stats, as the
+ * update and stats threads of the agent do, with each SaiApiLock mode:
+ *  - one global lock, which every SAI call serializes on
+ *  - a lock per API type, so routes and port stats don't contend
+ *  - a lock per API type which stats reads share among themselves
+ * Each iteration creates and removes one route.
+ */
+
+namespace {
+
+sai_status_t (*fakeGetPortStats)(
+    sai_object_id_t,
+    uint32_t,
+    const sai_stat_id_t*,
+    uint64_t*) = nullptr;
+
+sai_status_t slowGetPortStats(
+    sai_object_id_t port,
+    uint32_t num_of_counters,
+    const sai_stat_id_t* counter_ids,
+    uint64_t* counters) {
+  auto end = std::chrono::steady_clock::now() +
+      std::chrono::microseconds(FLAGS_stats_read_usecs);
+  while (std::chrono::steady_clock::now() < end) {
+  }
+  return fakeGetPortStats(port, num_of_counters, counter_ids, counters);
+}
+
+void slowDownPortStats() {
+  sai_port_api_t* portApi;
+  auto status =
+      sai_api_query(SAI_API_PORT, reinterpret_cast<void**>(&portApi));
+  CHECK_EQ(status, SAI_STATUS_SUCCESS);
+  // The fake SAI fills the table in again on each query
+  if (portApi->get_port_stats != &slowGetPortStats) {
+    fakeGetPortStats = portApi->get_port_stats;
+    portApi->get_port_stats = &slowGetPortStats;
+  }
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+void routeProgrammingWithStatsReaders(
+    unsigned iters,
+    bool perApiLock,
+    bool sharedReads) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_per_api_lock = perApiLock;
+  FLAGS_sai_shared_api_reads = sharedReads;
+
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  RouteApi routeApi;
+  PortApi portApi;
+  slowDownPortStats();
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> readers;
+  for (auto i = 0; i < FLAGS_stats_readers; ++i) {
+    readers.emplace_back([&portApi, &done]() {
+      while (!done) {
+        folly::doNotOptimizeAway(
+            portApi.getStats<SaiPortTraits>(PortSaiId(0)));
+      }
+    });
+  }
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  routes.reserve(iters);
+  for (unsigned i = 0; i < iters; ++i) {
+    folly::ByteArray16 bytes{};
+    std::memcpy(bytes.data() + bytes.size() - sizeof(i), &i, sizeof(i));
+    routes.emplace_back(
+        0, 0, folly::CIDRNetwork(folly::IPAddressV6(bytes), 128));
+  }
+  SaiRouteTraits::CreateAttributes attributes{
+      SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_DROP},
+      std::nullopt,
+      std::nullopt};
+
+  suspender.dismiss();
+  for (const auto& route : routes) {
+    routeApi.create<SaiRouteTraits>(route, attributes);
+    routeApi.remove(route);
+  }
+  suspender.rehire();
+
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+BENCHMARK(RouteProgrammingGlobalLock, iters) {
+  routeProgrammingWithStatsReaders(iters, false, false);
+}
+
+BENCHMARK_RELATIVE(RouteProgrammingPerApiLock, iters) {
+  routeProgrammingWithStatsReaders(iters, true, false);
+}
+
+BENCHMARK_RELATIVE(RouteProgrammingPerApiLockSharedReads, iters) {
+  routeProgrammingWithStatsReaders(iters, true, true);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,298 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/HwSwitch.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/hw/test/HwSwitchEnsemble.h"
+#include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
+#include "fboss/agent/state/DeltaFunctions.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+
+#include <folly/Benchmark.h>
+#include <folly/dynamic.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+extern "C" {
+#include <sai.h>
+}
+
+DEFINE_bool(json, true, "Output in json form");
+// Run with and without --enable_sai_bulk_api to compare
+DECLARE_bool(enable_sai_bulk_api);
+
+/*
+ * Runs the RouteScaleGenerators workloads end to end through SaiSwitch on
+ * top of the fake SAI, so that regressions in the route programming path of
+ * the agent show up without an ASIC. For each workload, routes are added in
+ * the chunks the generator produces and then all deleted at once, and each
+ * of the two reports:
+ *  - routes per second
+ *  - time spent in computing the state delta, in the SAI API calls, and
+ *    in SaiSwitch outside of them. The last is total less SAI API time,
+ *    so it is approximate: it takes in SaiSwitch walking the delta along
+ *    with the work of its managers, and the cost of timing each SAI call
+ *  - number of allocations made
+ */
+
+namespace {
+
+std::atomic<uint64_t> allocations{0};
+
+/*
+ * Time spent in calls to the SAI API, which the fake SAI implements. It
+ * returns the same method table to every sai_api_query() for an API, which
+ * the SaiApi classes keep, so timed wrappers can be swapped into it.
+ */
+std::atomic<int64_t> saiApiNsecs{0};
+std::atomic<uint64_t> saiApiCalls{0};
+
+template <auto Method, typename FnT>
+struct TimedSaiMethod;
+
+template <auto Method, typename... Args>
+struct TimedSaiMethod<Method, sai_status_t (*)(Args...)> {
+  static inline sai_status_t (*original)(Args...) = nullptr;
+
+  static sai_status_t call(Args... args) {
+    auto start = std::chrono::steady_clock::now();
+    auto status = original(args...);
+    saiApiNsecs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    ++saiApiCalls;
+    return status;
+  }
+};
+
+template <auto Method, typename ApiT>
+void timeSaiMethod(ApiT* api) {
+  using Timed =
+      TimedSaiMethod<Method, std::remove_reference_t<decltype(api->*Method)>>;
+  // The fake SAI fills the table in again on each query
+  if (api->*Method != &Timed::call) {
+    Timed::original = api->*Method;
+    api->*Method = &Timed::call;
+  }
+}
+
+template <typename ApiT>
+ApiT* saiApi(sai_api_t apiType) {
+  ApiT* api;
+  auto status = sai_api_query(apiType, reinterpret_cast<void**>(&api));
+  CHECK_EQ(status, SAI_STATUS_SUCCESS);
+  return api;
+}
+
+// The APIs programming routes and what they point to
+void timeRouteProgrammingSaiApis() {
+  auto routeApi = saiApi<sai_route_api_t>(SAI_API_ROUTE);
+  timeSaiMethod<&sai_route_api_t::create_route_entry>(routeApi);
+  timeSaiMethod<&sai_route_api_t::remove_route_entry>(routeApi);
+  timeSaiMethod<&sai_route_api_t::set_route_entry_attribute>(routeApi);
+  timeSaiMethod<&sai_route_api_t::create_route_entries>(routeApi);
+  timeSaiMethod<&sai_route_api_t::remove_route_entries>(routeApi);
+  timeSaiMethod<&sai_route_api_t::set_route_entries_attribute>(routeApi);
+
+  auto nextHopGroupApi =
+      saiApi<sai_next_hop_group_api_t>(SAI_API_NEXT_HOP_GROUP);
+  timeSaiMethod<&sai_next_hop_group_api_t::create_next_hop_group>(
+      nextHopGroupApi);
+  timeSaiMethod<&sai_next_hop_group_api_t::remove_next_hop_group>(
+      nextHopGroupApi);
+  timeSaiMethod<&sai_next_hop_group_api_t::create_next_hop_group_member>(
+      nextHopGroupApi);
+  timeSaiMethod<&sai_next_hop_group_api_t::remove_next_hop_group_member>(
+      nextHopGroupApi);
+  timeSaiMethod<&sai_next_hop_group_api_t::create_next_hop_group_members>(
+      nextHopGroupApi);
+  timeSaiMethod<&sai_next_hop_group_api_t::remove_next_hop_group_members>(
+      nextHopGroupApi);
+
+  auto nextHopApi = saiApi<sai_next_hop_api_t>(SAI_API_NEXT_HOP);
+  timeSaiMethod<&sai_next_hop_api_t::create_next_hop>(nextHopApi);
+  timeSaiMethod<&sai_next_hop_api_t::remove_next_hop>(nextHopApi);
+}
+
+struct StageTimes {
+  std::chrono::duration<double, std::milli> total{0};
+  std::chrono::duration<double, std::milli> stateDelta{0};
+  std::chrono::duration<double, std::milli> saiApi{0};
+  uint64_t saiApiCalls{0};
+  uint64_t allocations{0};
+};
+
+/*
+ * Apply newState to the ensemble, and add up the time it took. The state
+ * delta is computed and walked once on its own first to time that stage,
+ * as SaiSwitch computes the changes lazily while it processes them.
+ */
+void applyAndTime(
+    facebook::fboss::HwSwitchEnsemble* ensemble,
+    const std::shared_ptr<facebook::fboss::SwitchState>& newState,
+    StageTimes* times) {
+  using namespace facebook::fboss;
+  newState->publish();
+  auto deltaStart = std::chrono::steady_clock::now();
+  {
+    StateDelta delta(ensemble->getProgrammedState(), newState);
+    size_t changed = 0;
+    auto count = [&changed](const auto&... /* routes */) { ++changed; };
+    for (const auto& routeTableDelta : delta.getRouteTablesDelta()) {
+      DeltaFunctions::forEachChanged(
+          routeTableDelta.getRoutesV4Delta(), count, count, count);
+      DeltaFunctions::forEachChanged(
+          routeTableDelta.getRoutesV6Delta(), count, count, count);
+    }
+    folly::doNotOptimizeAway(changed);
+  }
+  times->stateDelta += std::chrono::steady_clock::now() - deltaStart;
+
+  auto saiApiNsecsBefore = saiApiNsecs.load();
+  auto saiApiCallsBefore = saiApiCalls.load();
+  auto allocationsBefore = allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  ensemble->applyNewState(newState);
+  times->total += std::chrono::steady_clock::now() - start;
+  times->allocations += allocations.load() - allocationsBefore;
+  times->saiApi +=
+      std::chrono::nanoseconds(saiApiNsecs.load() - saiApiNsecsBefore);
+  times->saiApiCalls += saiApiCalls.load() - saiApiCallsBefore;
+}
+
+void report(
+    const std::string& workload,
+    const std::string& operation,
+    size_t numRoutes,
+    const StageTimes& times) {
+  auto routesPerSec = numRoutes / (times.total.count() / 1000);
+  // Whatever SaiSwitch does besides calling the SAI API, delta walk included
+  auto saiSwitch = times.total - times.saiApi;
+  if (FLAGS_json) {
+    folly::dynamic result = folly::dynamic::object;
+    result["workload"] = workload;
+    result["operation"] = operation;
+    result["routes"] = numRoutes;
+    result["routes_per_sec"] = routesPerSec;
+    result["total_msecs"] = times.total.count();
+    result["state_delta_msecs"] = times.stateDelta.count();
+    result["sai_switch_msecs_approx"] = saiSwitch.count();
+    result["sai_api_msecs"] = times.saiApi.count();
+    result["sai_api_calls"] = times.saiApiCalls;
+    result["allocations"] = times.allocations;
+    result["sai_bulk_api"] = FLAGS_enable_sai_bulk_api;
+    std::cout << result << std::endl;
+  } else {
+    XLOG(INFO) << workload << " " << operation << " " << numRoutes
+               << " routes: " << routesPerSec
+               << " routes/sec, total msecs: " << times.total.count()
+               << " state delta msecs: " << times.stateDelta.count()
+               << " sai switch msecs (approx): " << saiSwitch.count()
+               << " sai api msecs: " << times.saiApi.count()
+               << " sai api calls: " << times.saiApiCalls
+               << " allocations: " << times.allocations;
+  }
+}
+
+} // namespace
+
+/*
+ * Count allocations made by the whole process. Only the difference across
+ * each measured state change is reported.
+ */
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (auto ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t& /*tag*/) noexcept {
+  ++allocations;
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new[](
+    std::size_t size,
+    const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+namespace facebook::fboss {
+
+template <typename RouteScaleGeneratorT>
+void routeScaleBenchmark(const std::string& workload) {
+  auto ensemble = createHwEnsemble(
+      HwSwitch::PACKET_RX_DESIRED | HwSwitch::LINKSCAN_DESIRED);
+  auto config = utility::onePortPerVlanConfig(
+      ensemble->getHwSwitch(), ensemble->masterLogicalPortIds());
+  ensemble->applyInitialConfig(config);
+  timeRouteProgrammingSaiApis();
+
+  auto initialState = ensemble->getProgrammedState();
+  RouteScaleGeneratorT generator(initialState);
+  size_t numRoutes = 0;
+  for (const auto& chunk : generator.get()) {
+    numRoutes += chunk.size();
+  }
+  const auto& states = generator.getSwitchStates();
+
+  StageTimes addTimes;
+  for (const auto& state : states) {
+    applyAndTime(ensemble.get(), state, &addTimes);
+  }
+  report(workload, "add", numRoutes, addTimes);
+
+  StageTimes delTimes;
+  applyAndTime(ensemble.get(), initialState, &delTimes);
+  report(workload, "del", numRoutes, delTimes);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  using namespace facebook::fboss;
+  routeScaleBenchmark<utility::FSWRouteScaleGenerator>("fsw");
+  routeScaleBenchmark<utility::THAlpmRouteScaleGenerator>("th_alpm");
+  routeScaleBenchmark<utility::HgridDuRouteScaleGenerator>("hgrid_du");
+  routeScaleBenchmark<utility::HgridUuRouteScaleGenerator>("hgrid_uu");
+  return 0;
+}
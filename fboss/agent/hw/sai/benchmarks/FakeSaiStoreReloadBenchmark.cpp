@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiTable.h"
+#include "fboss/agent/hw/sai/fake/FakeSai.h"
+#include "fboss/agent/hw/sai/store/SaiStore.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV6.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include <gflags/gflags.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+DECLARE_bool(sai_per_api_lock);
+DECLARE_bool(sai_shared_api_reads);
+
+/*
+ * Warm boot reload of a SaiStore holding numRoutes routes from the fake
+ * SAI, given the adapter keys saved on exit, as SaiSwitch does. The routes
+ * are fetched on the calling thread, or on numThreads threads with the
+ * SaiApiLock shared between reads.
+ */
+
+namespace facebook::fboss {
+
+void storeReload(unsigned iters, size_t numRoutes, size_t numThreads) {
+  folly::BenchmarkSuspender suspender;
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_per_api_lock = numThreads > 1;
+  FLAGS_sai_shared_api_reads = numThreads > 1;
+
+  auto fs = FakeSai::getInstance();
+  sai_api_initialize(0, nullptr);
+  auto saiApiTable = SaiApiTable::getInstance();
+  saiApiTable->queryApis();
+  auto& routeApi = saiApiTable->routeApi();
+
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  routes.reserve(numRoutes);
+  SaiRouteTraits::CreateAttributes attributes{
+      SaiRouteTraits::Attributes::PacketAction{SAI_PACKET_ACTION_DROP},
+      std::nullopt,
+      std::nullopt};
+  for (uint32_t i = 0; i < numRoutes; ++i) {
+    folly::ByteArray16 bytes{};
+    std::memcpy(bytes.data() + bytes.size() - sizeof(i), &i, sizeof(i));
+    routes.emplace_back(
+        0, 0, folly::CIDRNetwork(folly::IPAddressV6(bytes), 128));
+    routeApi.create<SaiRouteTraits>(routes.back(), attributes);
+  }
+  folly::dynamic adapterKeys;
+  folly::dynamic adapterKeys2AdapterHostKeys;
+  {
+    SaiStore store(0);
+    store.reload();
+    adapterKeys = store.adapterKeysFollyDynamic();
+    adapterKeys2AdapterHostKeys =
+        store.adapterKeys2AdapterHostKeysFollyDynamic();
+  }
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  if (numThreads > 1) {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+  }
+
+  for (unsigned i = 0; i < iters; ++i) {
+    SaiStore store(0);
+    suspender.dismiss();
+    store.reload(&adapterKeys, &adapterKeys2AdapterHostKeys, executor.get());
+    suspender.rehire();
+  }
+
+  // Leave the fake SAI empty for the next benchmark
+  for (const auto& route : routes) {
+    routeApi.remove(route);
+  }
+}
+
+BENCHMARK_NAMED_PARAM(storeReload, 1K_routes, 1'000, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM(storeReload, 1K_routes_4_threads, 1'000, 4)
+BENCHMARK_NAMED_PARAM(storeReload, 10K_routes, 10'000, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM(storeReload, 10K_routes_4_threads, 10'000, 4)
+BENCHMARK_NAMED_PARAM(storeReload, 100K_routes, 100'000, 1)
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    storeReload,
+    100K_routes_4_threads,
+    100'000,
+    4)
+
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -65,6 +65,31 @@ struct FakeSai {
   sai_object_id_t getCpuPort();
 };
 
+/*
+ * Make a bulk call as one call per object, through call(i) for the i-th
+ * object, honoring the error mode of the bulk call.
+ */
+template <typename CallT>
+sai_status_t fakeBulkCall(
+    uint32_t object_count,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses,
+    CallT call) {
+  sai_status_t status = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = call(i);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
 } // namespace facebook::fboss
 
 sai_status_t sai_api_initialize(
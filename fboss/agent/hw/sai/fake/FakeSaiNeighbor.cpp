@@ -91,6 +91,44 @@ sai_status_t get_neighbor_entry_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t create_neighbor_entries_fn(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return facebook::fboss::fakeBulkCall(
+      object_count, mode, object_statuses, [&](uint32_t i) {
+        return create_neighbor_entry_fn(
+            &neighbor_entry[i], attr_count[i], attr_list[i]);
+      });
+}
+
+sai_status_t remove_neighbor_entries_fn(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return facebook::fboss::fakeBulkCall(
+      object_count, mode, object_statuses, [&](uint32_t i) {
+        return remove_neighbor_entry_fn(&neighbor_entry[i]);
+      });
+}
+
+sai_status_t set_neighbor_entries_attribute_fn(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    const sai_attribute_t* attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return facebook::fboss::fakeBulkCall(
+      object_count, mode, object_statuses, [&](uint32_t i) {
+        return set_neighbor_entry_attribute_fn(
+            &neighbor_entry[i], &attr_list[i]);
+      });
+}
+
 namespace facebook::fboss {
 
 static sai_neighbor_api_t _neighbor_api;
@@ -100,6 +138,10 @@ void populate_neighbor_api(sai_neighbor_api_t** neighbor_api) {
   _neighbor_api.remove_neighbor_entry = &remove_neighbor_entry_fn;
   _neighbor_api.set_neighbor_entry_attribute = &set_neighbor_entry_attribute_fn;
   _neighbor_api.get_neighbor_entry_attribute = &get_neighbor_entry_attribute_fn;
+  _neighbor_api.create_neighbor_entries = &create_neighbor_entries_fn;
+  _neighbor_api.remove_neighbor_entries = &remove_neighbor_entries_fn;
+  _neighbor_api.set_neighbor_entries_attribute =
+      &set_neighbor_entries_attribute_fn;
   *neighbor_api = &_neighbor_api;
 }
 
@@ -171,6 +171,32 @@ sai_status_t set_next_hop_group_member_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t create_next_hop_group_members_fn(
+    sai_object_id_t switch_id,
+    uint32_t object_count,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_object_id_t* object_id,
+    sai_status_t* object_statuses) {
+  return facebook::fboss::fakeBulkCall(
+      object_count, mode, object_statuses, [&](uint32_t i) {
+        return create_next_hop_group_member_fn(
+            &object_id[i], switch_id, attr_count[i], attr_list[i]);
+      });
+}
+
+sai_status_t remove_next_hop_group_members_fn(
+    uint32_t object_count,
+    const sai_object_id_t* object_id,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  return facebook::fboss::fakeBulkCall(
+      object_count, mode, object_statuses, [&](uint32_t i) {
+        return remove_next_hop_group_member_fn(object_id[i]);
+      });
+}
+
 namespace facebook::fboss {
 
 static sai_next_hop_group_api_t _next_hop_group_api;
@@ -191,6 +217,10 @@ void populate_next_hop_group_api(
       &set_next_hop_group_member_attribute_fn;
   _next_hop_group_api.get_next_hop_group_member_attribute =
       &get_next_hop_group_member_attribute_fn;
+  _next_hop_group_api.create_next_hop_group_members =
+      &create_next_hop_group_members_fn;
+  _next_hop_group_api.remove_next_hop_group_members =
+      &remove_next_hop_group_members_fn;
   *next_hop_group_api = &_next_hop_group_api;
 }
 
@@ -5,6 +5,11 @@
 namespace facebook {
 namespace fboss {
 
+SaiObjectAttributeSetCounts& SaiObjectAttributeSetCounts::get() {
+  static SaiObjectAttributeSetCounts counts;
+  return counts;
+}
+
 template <>
 folly::dynamic
 SaiObject<SaiNextHopGroupTraits>::adapterHostKeyToFollyDynamic() {
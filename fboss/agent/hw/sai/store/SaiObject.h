@@ -18,6 +18,7 @@
 
 #include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
 
+#include <atomic>
 #include <variant>
 
 namespace facebook::fboss {
@@ -153,6 +154,20 @@ typename std::
 
 } // namespace detail
 
+/*
+ * Attribute sets SaiObjects made in the SAI adapter, and those they avoided
+ * because the new value of the attribute was already programmed, across
+ * all SaiObjects. Only attributes which setAttributes could have set are
+ * counted as avoided: those with a value, other than the attributes of the
+ * AdapterHostKey, which can't change.
+ */
+struct SaiObjectAttributeSetCounts {
+  std::atomic<uint64_t> made{0};
+  std::atomic<uint64_t> avoided{0};
+
+  static SaiObjectAttributeSetCounts& get();
+};
+
 /*
  * SaiObject is a generic object which manages an object in the SAI adapter.
  *
@@ -363,6 +378,8 @@ class SaiObject {
     if (oldAttr != newAttr) {
       setNewAttributeHelper(newAttr);
       oldAttr = std::forward<AttrT>(newAttr);
+    } else {
+      countAvoidedSet(newAttr);
     }
   }
   void remove() {
@@ -411,6 +428,8 @@ class SaiObject {
     auto& api =
         SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
     api.setAttribute(adapterKey(), newAttr);
+    SaiObjectAttributeSetCounts::get().made.fetch_add(
+        1, std::memory_order_relaxed);
   }
   template <typename AttrT>
   void setNewAttributeHelper(const std::optional<AttrT>& newAttrOpt) {
@@ -421,6 +440,22 @@ class SaiObject {
       // properly
     }
   }
+  template <typename AttrT>
+  void countAvoidedSet(const AttrT& /* attr */) {
+    using AdapterHostKey = typename SaiObjectTraits::AdapterHostKey;
+    if constexpr (
+        !std::is_same_v<AttrT, AdapterHostKey> &&
+        !IsElementOfTuple<AttrT, AdapterHostKey>::value) {
+      SaiObjectAttributeSetCounts::get().avoided.fetch_add(
+          1, std::memory_order_relaxed);
+    }
+  }
+  template <typename AttrT>
+  void countAvoidedSet(const std::optional<AttrT>& attrOpt) {
+    if (attrOpt) {
+      countAvoidedSet(attrOpt.value());
+    }
+  }
   bool live_{false};
   typename SaiObjectTraits::AdapterKey adapterKey_;
   typename SaiObjectTraits::AdapterHostKey adapterHostKey_;
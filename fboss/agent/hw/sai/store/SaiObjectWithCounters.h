@@ -15,6 +15,7 @@
 #include "fboss/lib/TupleUtils.h"
 
 #include <variant>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -47,6 +48,34 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
     counters_ = api.template getStats<T>(this->adapterKey(), counterIds);
   }
 
+  /*
+   * Update or clear the stats of many objects in one batch, see
+   * SaiApi::bulkGetStats. Empty counterIds means all of CounterIds.
+   */
+  template <typename T = SaiObjectTraits>
+  static void bulkUpdateStats(
+      const std::vector<SaiObjectWithCounters*>& objects,
+      const std::vector<sai_stat_id_t>& counterIds = {}) {
+    static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
+    auto& api = SaiApiTable::getInstance()->getApi<typename T::SaiApiT>();
+    auto keys = adapterKeys(objects);
+    auto counters = counterIds.empty()
+        ? api.template bulkGetStats<T>(keys)
+        : api.template bulkGetStats<T>(keys, counterIds);
+    for (size_t i = 0; i < objects.size(); ++i) {
+      objects[i]->counters_ = std::move(counters[i]);
+    }
+  }
+
+  template <typename T = SaiObjectTraits>
+  static void bulkClearStats(
+      const std::vector<SaiObjectWithCounters*>& objects,
+      const std::vector<sai_stat_id_t>& counterIds) {
+    static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
+    const auto& api = SaiApiTable::getInstance()->getApi<typename T::SaiApiT>();
+    api.template bulkClearStats<T>(adapterKeys(objects), counterIds);
+  }
+
   template <typename T = SaiObjectTraits>
   const std::vector<uint64_t>& getStats() const {
     static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
@@ -68,6 +97,16 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
   }
 
  private:
+  static std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys(
+      const std::vector<SaiObjectWithCounters*>& objects) {
+    std::vector<typename SaiObjectTraits::AdapterKey> keys;
+    keys.reserve(objects.size());
+    for (const auto* object : objects) {
+      keys.push_back(object->adapterKey());
+    }
+    return keys;
+  }
+
   std::vector<uint64_t> counters_;
 };
 
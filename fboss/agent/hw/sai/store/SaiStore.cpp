@@ -38,9 +38,11 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
-    const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+    const folly::dynamic* adapterKeys2AdapterHostKeyJson,
+    folly::Executor* executor) {
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
+      [adapterKeysJson, adapterKeys2AdapterHostKeyJson, executor](
+          auto& store) {
         const folly::dynamic* adapterKeys = adapterKeysJson
             ? &((*adapterKeysJson)[store.objectTypeName()])
             : nullptr;
@@ -48,7 +50,7 @@ void SaiStore::reload(
             ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
             : nullptr;
 
-        store.reload(adapterKeys, adapterHostKeys);
+        store.reload(adapterKeys, adapterHostKeys, executor);
       },
       stores_);
 }
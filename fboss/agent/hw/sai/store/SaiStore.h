@@ -20,10 +20,15 @@
 #include "fboss/agent/hw/sai/store/Traits.h"
 #include "fboss/lib/RefMap.h"
 
+#include <folly/Executor.h>
 #include <folly/dynamic.h>
+#include <folly/futures/Future.h>
 
+#include <algorithm>
+#include <exception>
 #include <memory>
 #include <optional>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -87,33 +92,26 @@ class SaiObjectStore {
     return ins.first;
   }
 
+  /*
+   * Load the objects from the adapter. Their attributes are fetched in
+   * chunks of keys on executor, if there is one, and then added to the
+   * store on the calling thread.
+   */
   void reload(
       const folly::dynamic* adapterKeysJson,
-      const folly::dynamic* adapterKeys2AdapterHostKey) {
+      const folly::dynamic* adapterKeys2AdapterHostKey,
+      folly::Executor* executor = nullptr) {
     if (!switchId_) {
       XLOG(FATAL)
           << "Attempted to reload() on a SaiObjectStore without a switchId";
     }
     auto keys = getAdapterKeys(adapterKeysJson);
-    if constexpr (SaiObjectHasConditionalAttributes<SaiObjectTraits>::value) {
-      keys.erase(
-          std::remove_if(
-              keys.begin(),
-              keys.end(),
-              [](auto key) {
-                auto conditionAttributes =
-                    SaiApiTable::getInstance()
-                        ->getApi<typename SaiObjectTraits::SaiApiT>()
-                        .getAttribute(
-                            key,
-                            typename SaiObjectTraits::ConditionAttributes{});
-                return conditionAttributes !=
-                    SaiObjectTraits::kConditionAttributes;
-              }),
-          keys.end());
-    }
-    for (const auto k : keys) {
-      ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
+    auto objects = loadObjects(keys, adapterKeys2AdapterHostKey, executor);
+    for (auto& loaded : objects) {
+      if (!loaded) {
+        continue;
+      }
+      ObjectType obj = std::move(loaded.value());
       auto adapterHostKey = obj.adapterHostKey();
       XLOGF(DBG5, "SaiStore reloaded {}", obj);
       auto ins = objects_.refOrEmplace(adapterHostKey, std::move(obj));
@@ -208,6 +206,62 @@ class SaiObjectStore {
   }
 
  private:
+  static constexpr size_t kReloadChunkSize = 1024;
+
+  /*
+   * Objects of keys, loaded from the adapter. Those of another condition
+   * object trait, e.g. MPLS next hops for IP next hops, are left empty.
+   */
+  std::vector<std::optional<ObjectType>> loadObjects(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& keys,
+      const folly::dynamic* adapterKeys2AdapterHostKey,
+      folly::Executor* executor) {
+    std::vector<std::optional<ObjectType>> objects(keys.size());
+    auto load = [&](size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        if constexpr (SaiObjectHasConditionalAttributes<
+                          SaiObjectTraits>::value) {
+          auto conditionAttributes =
+              SaiApiTable::getInstance()
+                  ->getApi<typename SaiObjectTraits::SaiApiT>()
+                  .getAttribute(
+                      keys[i], typename SaiObjectTraits::ConditionAttributes{});
+          if (conditionAttributes != SaiObjectTraits::kConditionAttributes) {
+            continue;
+          }
+        }
+        objects[i].emplace(getObject(keys[i], adapterKeys2AdapterHostKey));
+      }
+    };
+    try {
+      if (!executor || keys.size() <= kReloadChunkSize) {
+        load(0, keys.size());
+        return objects;
+      }
+      std::vector<folly::Future<folly::Unit>> chunks;
+      for (size_t begin = 0; begin < keys.size(); begin += kReloadChunkSize) {
+        auto end = std::min(begin + kReloadChunkSize, keys.size());
+        chunks.push_back(
+            folly::via(executor, [&load, begin, end] { load(begin, end); }));
+      }
+      // The chunks reference objects, so wait for all of them before
+      // rethrowing the first failure
+      auto results = folly::collectAll(std::move(chunks)).get();
+      for (auto& result : results) {
+        result.throwIfFailed();
+      }
+    } catch (const std::exception&) {
+      // Don't remove what was loaded from the adapter when giving up
+      for (auto& object : objects) {
+        if (object) {
+          object->release();
+        }
+      }
+      throw;
+    }
+    return objects;
+  }
+
   ObjectType getObject(
       typename SaiObjectTraits::AdapterKey key,
       const folly::dynamic* adapterKey2AdapterHostKey) {
@@ -291,10 +345,13 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   * With an executor, the attributes of the objects of each type are
+   * fetched in parallel on it.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
-      const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
+      const folly::dynamic* adapterKeys2AdapterHostKey = nullptr,
+      folly::Executor* executor = nullptr);
 
   /*
    *
@@ -14,6 +14,10 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/store/tests/SaiStoreTest.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <vector>
+
 using namespace facebook::fboss;
 
 class NextHopStoreTest : public SaiStoreTest {
@@ -64,6 +68,36 @@ TEST_F(NextHopStoreTest, loadNextHops) {
   EXPECT_EQ(mplsNhop->adapterKey(), nextHopSaiId4);
 }
 
+TEST_F(NextHopStoreTest, loadNextHopsOnExecutor) {
+  // More than one chunk of each, so IP and MPLS next hops are told apart by
+  // their type attribute within the chunks loaded in parallel
+  std::vector<NextHopSaiId> ipNextHops;
+  std::vector<NextHopSaiId> mplsNextHops;
+  for (uint32_t i = 0; i < 1500; ++i) {
+    auto ip = folly::IPAddressV4::fromLongHBO(0x0a000000 + i);
+    ipNextHops.push_back(createNextHop(ip));
+    mplsNextHops.push_back(createMplsNextHop(ip, {1000 + i}));
+  }
+
+  SaiStore s(0);
+  folly::CPUThreadPoolExecutor executor(4);
+  s.reload(nullptr, nullptr, &executor);
+  auto& store = s.get<SaiIpNextHopTraits>();
+  auto& mplsNextHopStore = s.get<SaiMplsNextHopTraits>();
+  EXPECT_EQ(store.objects().size(), ipNextHops.size());
+  EXPECT_EQ(mplsNextHopStore.objects().size(), mplsNextHops.size());
+  for (uint32_t i = 0; i < 1500; ++i) {
+    folly::IPAddress ip(folly::IPAddressV4::fromLongHBO(0x0a000000 + i));
+    auto got = store.get(SaiIpNextHopTraits::AdapterHostKey{42, ip});
+    ASSERT_NE(got, nullptr);
+    EXPECT_EQ(got->adapterKey(), ipNextHops[i]);
+    auto mplsNhop = mplsNextHopStore.get(SaiMplsNextHopTraits::AdapterHostKey{
+        42, ip, std::vector<sai_uint32_t>{1000 + i}});
+    ASSERT_NE(mplsNhop, nullptr);
+    EXPECT_EQ(mplsNhop->adapterKey(), mplsNextHops[i]);
+  }
+}
+
 TEST_F(NextHopStoreTest, nextHopLoadCtor) {
   auto ip = folly::IPAddress("::");
   auto nextHopSaiId = createNextHop(ip);
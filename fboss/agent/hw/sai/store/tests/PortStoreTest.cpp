@@ -104,6 +104,25 @@ TEST_F(PortStoreTest, portSetSpeed) {
   EXPECT_EQ(apiSpeed, 25000);
 }
 
+TEST_F(PortStoreTest, portSetUnchangedAttributes) {
+  SaiPortTraits::CreateAttributes attrs = makeAttrs(0, 100000);
+  SaiPortTraits::AdapterHostKey adapterHostKey =
+      std::get<SaiPortTraits::Attributes::HwLaneList>(attrs);
+  SaiObject<SaiPortTraits> portObj(adapterHostKey, attrs, 0);
+  auto& counts = SaiObjectAttributeSetCounts::get();
+  auto made = counts.made.load();
+  auto avoided = counts.avoided.load();
+  // Speed and AdminState are avoided. HwLaneList is the AdapterHostKey and
+  // the other attributes are unset, so they would never have been set.
+  portObj.setAttributes(attrs);
+  EXPECT_EQ(counts.made, made);
+  EXPECT_EQ(counts.avoided, avoided + 2);
+  portObj.setAttributes(makeAttrs(0, 25000));
+  EXPECT_EQ(counts.made, made + 1);
+  EXPECT_EQ(counts.avoided, avoided + 3);
+  EXPECT_EQ(GET_ATTR(Port, Speed, portObj.attributes()), 25000);
+}
+
 TEST_F(PortStoreTest, portSetOnlySpeed) {
   auto portId = createPort(0);
   SaiObject<SaiPortTraits> portObj(portId);
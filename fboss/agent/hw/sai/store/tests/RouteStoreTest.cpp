@@ -9,12 +9,22 @@
  */
 
 #include "fboss/agent/hw/sai/api/RouteApi.h"
+#include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 #include "fboss/agent/hw/sai/store/LoggingUtil.h"
 #include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/store/tests/SaiStoreTest.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <gflags/gflags.h>
+
+#include <vector>
+
+DECLARE_bool(sai_per_api_lock);
+DECLARE_bool(sai_shared_api_reads);
+
 using namespace facebook::fboss;
 
 TEST_F(SaiStoreTest, loadRoute) {
@@ -142,3 +152,63 @@ TEST_F(SaiStoreTest, serDeserV6Route) {
 
   verifyAdapterKeySerDeser<SaiRouteTraits>({r});
 }
+
+namespace {
+std::vector<SaiRouteTraits::RouteEntry> createRoutes(
+    RouteApi& routeApi,
+    uint32_t numRoutes) {
+  std::vector<SaiRouteTraits::RouteEntry> routes;
+  SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+      SAI_PACKET_ACTION_FORWARD};
+  for (uint32_t i = 0; i < numRoutes; ++i) {
+    folly::IPAddressV4 ip = folly::IPAddressV4::fromLongHBO(0x0a000000 + i);
+    routes.emplace_back(0, 0, folly::CIDRNetwork(ip, 32));
+    routeApi.create<SaiRouteTraits>(
+        routes.back(), {packetActionAttribute, i, std::nullopt});
+  }
+  return routes;
+}
+} // namespace
+
+TEST_F(SaiStoreTest, reloadRoutesOnExecutor) {
+  // As SaiSwitch runs a reload on more than one thread
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_per_api_lock = true;
+  FLAGS_sai_shared_api_reads = true;
+  // More than one chunk of routes to load in parallel
+  auto routes = createRoutes(saiApiTable->routeApi(), 3000);
+
+  SaiStore s(0);
+  s.reload();
+  auto json = s.adapterKeysFollyDynamic();
+  SaiStore s2(0);
+  folly::CPUThreadPoolExecutor executor(4);
+  s2.reload(&json, nullptr, &executor);
+  auto& store = s2.get<SaiRouteTraits>();
+  for (size_t i = 0; i < routes.size(); ++i) {
+    auto got = store.get(routes[i]);
+    ASSERT_TRUE(got);
+    EXPECT_EQ(GET_OPT_ATTR(Route, NextHopId, got->attributes()), i);
+  }
+}
+
+TEST_F(SaiStoreTest, reloadRoutesOnExecutorFails) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_per_api_lock = true;
+  FLAGS_sai_shared_api_reads = true;
+  auto& routeApi = saiApiTable->routeApi();
+  auto routes = createRoutes(routeApi, 3000);
+
+  SaiStore s(0);
+  s.reload();
+  auto json = s.adapterKeysFollyDynamic();
+  // A route saved on exit which is gone from the adapter, in the last chunk
+  routeApi.remove(routes.back());
+  {
+    SaiStore s2(0);
+    folly::CPUThreadPoolExecutor executor(4);
+    EXPECT_ANY_THROW(s2.reload(&json, nullptr, &executor));
+  }
+  // The routes loaded before the failure are left in the adapter
+  EXPECT_EQ(getObjectCount<SaiRouteTraits>(0), routes.size() - 1);
+}
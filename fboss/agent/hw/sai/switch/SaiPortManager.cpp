@@ -368,17 +368,28 @@ const std::vector<sai_stat_id_t>& SaiPortManager::supportedStats() const {
 
 void SaiPortManager::updateStats() {
   auto now = duration_cast<seconds>(system_clock::now().time_since_epoch());
+  // Read the counters of all ports, and then of all their queues, in one
+  // batch each rather than a few calls per port
+  std::vector<std::pair<HwPortFb303Stats*, SaiPortHandle*>> enabledPorts;
+  std::vector<SaiPort*> ports;
+  std::vector<SaiQueueHandles*> queues;
   for (const auto& [portId, handle] : handles_) {
-    if (portStats_.find(portId) == portStats_.end()) {
+    auto portStatItr = portStats_.find(portId);
+    if (portStatItr == portStats_.end()) {
       // We don't maintain port stats for disabled ports.
       continue;
     }
-    handle->port->updateStats(supportedStats());
-    const auto& counters = handle->port->getStats();
+    enabledPorts.emplace_back(portStatItr->second.get(), handle.get());
+    ports.push_back(handle->port.get());
+    queues.push_back(&handle->queues);
+  }
+  SaiPort::bulkUpdateStats(ports, supportedStats());
+  managerTable_->queueManager().updateStats(queues);
+  for (auto [portStat, handle] : enabledPorts) {
     HwPortStats hwPortStats;
-    fillHwPortStats(supportedStats(), counters, hwPortStats);
-    managerTable_->queueManager().updateStats(handle->queues, hwPortStats);
-    portStats_[portId]->updateStats(hwPortStats, now);
+    fillHwPortStats(supportedStats(), handle->port->getStats(), hwPortStats);
+    managerTable_->queueManager().getStats(handle->queues, hwPortStats);
+    portStat->updateStats(hwPortStats, now);
   }
 }
 
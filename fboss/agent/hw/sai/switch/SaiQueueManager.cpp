@@ -171,16 +171,23 @@ SaiQueueHandles SaiQueueManager::loadQueues(
 void SaiQueueManager::updateStats(
     SaiQueueHandles& queueHandles,
     HwPortStats& hwPortStats) {
-  for (auto& queueHandle : queueHandles) {
-    queueHandle.second->queue->updateStats();
-  }
+  updateStats(std::vector<SaiQueueHandles*>{&queueHandles});
   getStats(queueHandles, hwPortStats);
-  // Now that we have published the stats, clear watermark
+}
+
+void SaiQueueManager::updateStats(
+    const std::vector<SaiQueueHandles*>& queueHandles) {
+  std::vector<SaiQueue*> queues;
+  for (auto* handles : queueHandles) {
+    for (auto& queueHandle : *handles) {
+      queues.push_back(queueHandle.second->queue.get());
+    }
+  }
+  SaiQueue::bulkUpdateStats(queues);
+  // Now that we have read the stats, clear watermark
   // so the next read gives us the watermark from this point
   // onwards.
-  for (auto& queueHandle : queueHandles) {
-    queueHandle.second->queue->clearStats({SAI_QUEUE_STAT_WATERMARK_BYTES});
-  }
+  SaiQueue::bulkClearStats(queues, {SAI_QUEUE_STAT_WATERMARK_BYTES});
 }
 
 void SaiQueueManager::getStats(
@@ -22,6 +22,7 @@
 #include "folly/container/F14Map.h"
 
 #include <memory>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -55,6 +56,8 @@ class SaiQueueManager {
       const SaiQueueHandles& queueHandles,
       const QueueConfig& queues);
   void updateStats(SaiQueueHandles& queueHandles, HwPortStats& stats);
+  // Update the stats of the queues of many ports in one batch
+  void updateStats(const std::vector<SaiQueueHandles*>& queueHandles);
   void getStats(SaiQueueHandles& queueHandles, HwPortStats& hwPortStats);
   QueueConfig getQueueSettings(const SaiQueueHandles& queueHandles) const;
 
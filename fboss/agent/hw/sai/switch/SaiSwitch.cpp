@@ -11,14 +11,18 @@
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 
 #include "fboss/agent/Constants.h"
+#include "fboss/agent/RestartTimeTracker.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/hw/sai/api/AdapterKeySerializers.h"
 #include "fboss/agent/hw/sai/api/FdbApi.h"
 #include "fboss/agent/hw/sai/api/HostifApi.h"
 #include "fboss/agent/hw/sai/api/LoggingUtil.h"
 #include "fboss/agent/hw/sai/api/SaiApiTable.h"
+#include "fboss/agent/hw/sai/api/SaiBulkApiQueue.h"
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/api/Types.h"
+#include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/ConcurrentIndices.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableGroupManager.h"
@@ -45,8 +49,12 @@
 #include "fboss/agent/hw/HwSwitchWarmBootHelper.h"
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 
+#include <fb303/ServiceData.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/logging/xlog.h>
 
+#include <chrono>
 #include <optional>
 
 extern "C" {
@@ -55,6 +63,18 @@ extern "C" {
 
 DEFINE_bool(enable_sai_debug_log, false, "Turn on SAI debugging logging");
 DEFINE_bool(flexports, false, "Load the agent with flexport support enabled");
+DEFINE_bool(
+    enable_sai_bulk_api,
+    false,
+    "Program routes, neighbors and next hop group members of a state "
+    "update through SAI bulk calls");
+DEFINE_uint32(
+    sai_store_reload_threads,
+    1,
+    "Number of threads to fetch the attributes of SAI objects with when "
+    "reloading the SaiStore. 0 or 1 fetches them on the calling thread. "
+    "SAI calls only run in parallel with --sai_per_api_lock and "
+    "--sai_shared_api_reads");
 
 namespace {
 auto constexpr kAclTable1 = "AclTable1";
@@ -158,6 +178,11 @@ void SaiSwitch::unregisterCallbacks() noexcept {
 }
 
 std::shared_ptr<SwitchState> SaiSwitch::stateChanged(const StateDelta& delta) {
+  // Queue SAI calls of the update for bulk calls, until it is done
+  std::optional<SaiBulkApiScope> bulkApiScope;
+  if (FLAGS_enable_sai_bulk_api) {
+    bulkApiScope.emplace();
+  }
   processDelta(
       delta.getPortsDelta(),
       managerTable_->portManager(),
@@ -313,7 +338,9 @@ void SaiSwitch::fetchL2Table(std::vector<L2EntryThrift>* l2Table) const {
   fetchL2TableLocked(lock, l2Table);
 }
 
-void SaiSwitch::gracefulExit(folly::dynamic& switchState) {
+void SaiSwitch::gracefulExit(
+    folly::dynamic& switchState,
+    const std::shared_ptr<SwitchState>& swState) {
   if (!platform_->getAsic()->isSupported(HwAsic::Feature::WARM_BOOT)) {
     XLOG(ERR) << " Asic does not support warm boot, skipping graceful exit";
     return;
@@ -335,16 +362,18 @@ void SaiSwitch::gracefulExit(folly::dynamic& switchState) {
   */
   stopNonCallbackThreads();
   std::lock_guard<std::mutex> lock(saiSwitchMutex_);
-  gracefulExitLocked(switchState, lock);
+  gracefulExitLocked(switchState, swState, lock);
 }
 
 void SaiSwitch::gracefulExitLocked(
     folly::dynamic& switchState,
+    const std::shared_ptr<SwitchState>& swState,
     const std::lock_guard<std::mutex>& lock) {
   SaiSwitchTraits::Attributes::SwitchRestartWarm restartWarm{true};
   SaiApiTable::getInstance()->switchApi().setAttribute(switchId_, restartWarm);
   switchState[kHwSwitch] = toFollyDynamicLocked(lock);
-  platform_->getWarmBootHelper()->storeWarmBootState(switchState);
+  platform_->getWarmBootHelper()->storeWarmBootState(
+      std::move(switchState), swState);
   platform_->getWarmBootHelper()->setCanWarmBoot();
   managerTable_->switchManager().gracefulExit();
 }
@@ -528,7 +557,10 @@ HwInitResult SaiSwitch::initLocked(
   sai_api_initialize(0, platform_->getServiceMethodTable());
   if (bootType_ == BootType::WARM_BOOT) {
     auto switchStateJson = wbHelper->getWarmBootState();
-    ret.switchState = SwitchState::fromFollyDynamic(switchStateJson[kSwSwitch]);
+    restart_time::mark(RestartEvent::WARM_BOOT_STATE_READ);
+    ret.switchState =
+        HwSwitchWarmBootHelper::getWarmBootSwitchState(switchStateJson);
+    restart_time::mark(RestartEvent::WARM_BOOT_STATE_DESERIALIZED);
     ret.switchState->publish();
     if (platform_->getAsic()->needsObjectKeyCache()) {
       adapterKeysJson = std::make_unique<folly::dynamic>(
@@ -560,8 +592,17 @@ HwInitResult SaiSwitch::initLocked(
   auto saiStore = SaiStore::getInstance();
   saiStore->setSwitchId(switchId_);
   if (platform_->getObjectKeysSupported()) {
+    // Joins its threads when it goes out of scope
+    std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+    if (FLAGS_sai_store_reload_threads > 1) {
+      executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+          FLAGS_sai_store_reload_threads,
+          std::make_shared<folly::NamedThreadFactory>("SaiStoreReload"));
+    }
     saiStore->reload(
-        adapterKeysJson.get(), adapterKeys2AdapterHostKeysJson.get());
+        adapterKeysJson.get(),
+        adapterKeys2AdapterHostKeysJson.get(),
+        executor.get());
   }
   managerTable_->createSaiTableManagers(platform_, concurrentIndices_.get());
   callback_ = callback;
@@ -789,9 +830,20 @@ bool SaiSwitch::sendPacketOutOfPortSyncLocked(
 
 void SaiSwitch::updateStatsLocked(
     const std::lock_guard<std::mutex>& /* lock */,
-    SwitchStats* /* switchStats */) {
+    SwitchStats* switchStats) {
+  auto start = std::chrono::steady_clock::now();
   managerTable_->portManager().updateStats();
   managerTable_->hostifManager().updateStats();
+  switchStats->hwStatsCollection(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+  const auto& setCounts = SaiObjectAttributeSetCounts::get();
+  fb303::fbData->setCounter(
+      SwitchStats::kCounterPrefix + "sai.attribute_sets.made",
+      setCounts.made.load(std::memory_order_relaxed));
+  fb303::fbData->setCounter(
+      SwitchStats::kCounterPrefix + "sai.attribute_sets.avoided",
+      setCounts.avoided.load(std::memory_order_relaxed));
 }
 
 void SaiSwitch::fetchL2TableLocked(
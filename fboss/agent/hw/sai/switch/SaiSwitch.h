@@ -63,7 +63,9 @@ class SaiSwitch : public HwSwitch {
 
   void fetchL2Table(std::vector<L2EntryThrift>* l2Table) const override;
 
-  void gracefulExit(folly::dynamic& switchState) override;
+  void gracefulExit(
+      folly::dynamic& switchState,
+      const std::shared_ptr<SwitchState>& swState) override;
 
   folly::dynamic toFollyDynamic() const override;
 
@@ -220,6 +222,7 @@ class SaiSwitch : public HwSwitch {
 
   void gracefulExitLocked(
       folly::dynamic& switchState,
+      const std::shared_ptr<SwitchState>& swState,
       const std::lock_guard<std::mutex>& lock);
   void initLinkScanLocked(const std::lock_guard<std::mutex>& lock);
   void initRxLocked(const std::lock_guard<std::mutex>& lock);
@@ -35,7 +35,9 @@ class SimSwitch : public HwSwitch {
       std::unique_ptr<TxPacket> pkt,
       PortID portID,
       std::optional<uint8_t> queue = std::nullopt) noexcept override;
-  void gracefulExit(folly::dynamic& /*switchState*/) override {}
+  void gracefulExit(
+      folly::dynamic& /*switchState*/,
+      const std::shared_ptr<SwitchState>& /*swState*/) override {}
 
   folly::dynamic toFollyDynamic() const override;
 
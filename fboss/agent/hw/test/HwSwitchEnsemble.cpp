@@ -249,8 +249,7 @@ void HwSwitchEnsemble::gracefulExit() {
   // Initiate warm boot
   folly::dynamic switchState = folly::dynamic::object;
   getHwSwitch()->unregisterCallbacks();
-  switchState[kSwSwitch] = getProgrammedState()->toFollyDynamic();
-  getHwSwitch()->gracefulExit(switchState);
+  getHwSwitch()->gracefulExit(switchState, getProgrammedState());
 }
 
 } // namespace facebook::fboss
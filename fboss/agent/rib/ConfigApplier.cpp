@@ -107,7 +107,8 @@ void ConfigApplier::updateRibAndFib() {
   // Trigger recrusive resolution
   updater.updateDone();
 
-  fibUpdateCallback_(vrf_, *v4NetworkToRoute_, *v6NetworkToRoute_, cookie_);
+  fibUpdateCallback_(
+      vrf_, *v4NetworkToRoute_, *v6NetworkToRoute_, nullptr, cookie_);
 }
 
 void ConfigApplier::addInterfaceRoutes(
@@ -17,16 +17,19 @@
 #include <folly/logging/xlog.h>
 
 #include <algorithm>
+#include <type_traits>
 
 namespace facebook::fboss::rib {
 
 ForwardingInformationBaseUpdater::ForwardingInformationBaseUpdater(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
-    const IPv6NetworkToRouteMap& v6NetworkToRoute)
+    const IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const std::set<folly::CIDRNetwork>* changedPrefixes)
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
-      v6NetworkToRoute_(v6NetworkToRoute) {}
+      v6NetworkToRoute_(v6NetworkToRoute),
+      changedPrefixes_(changedPrefixes) {}
 
 std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     const std::shared_ptr<SwitchState>& state) {
@@ -45,19 +48,23 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
 
   auto nextFibContainer = previousFibContainer->modify(&nextState);
 
-  nextFibContainer->writableFields()->fibV4 =
-      std::shared_ptr<ForwardingInformationBaseV4>(createUpdatedFib(
-          v4NetworkToRoute_, previousFibContainer->getFibV4()));
-
-  nextFibContainer->writableFields()->fibV6 =
-      std::shared_ptr<ForwardingInformationBaseV6>(createUpdatedFib(
-          v6NetworkToRoute_, previousFibContainer->getFibV6()));
+  if (changedPrefixes_) {
+    nextFibContainer->writableFields()->fibV4 =
+        patchFib(v4NetworkToRoute_, previousFibContainer->getFibV4());
+    nextFibContainer->writableFields()->fibV6 =
+        patchFib(v6NetworkToRoute_, previousFibContainer->getFibV6());
+  } else {
+    nextFibContainer->writableFields()->fibV4 =
+        createUpdatedFib(v4NetworkToRoute_, previousFibContainer->getFibV4());
+    nextFibContainer->writableFields()->fibV6 =
+        createUpdatedFib(v6NetworkToRoute_, previousFibContainer->getFibV6());
+  }
 
   return nextState;
 }
 
 template <typename AddressT>
-std::unique_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
 ForwardingInformationBaseUpdater::createUpdatedFib(
     const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
     const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
@@ -82,15 +89,15 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
                                                      ribRoute.prefix().mask};
     std::shared_ptr<facebook::fboss::Route<AddressT>> fibRoute =
         fib->getNodeIf(fibPrefix);
+    auto fibNextHopEntry = fibNextHop(ribRoute.getForwardInfo());
     if (fibRoute) {
-      if (toFibNextHop(ribRoute.getForwardInfo()) ==
-          fibRoute->getForwardInfo()) {
+      if (fibNextHopEntry == fibRoute->getForwardInfo()) {
         // Reuse prior FIB route
       } else {
-        fibRoute = toFibRoute(ribRoute);
+        fibRoute = toFibRoute(ribRoute, fibNextHopEntry);
       }
     } else {
-      fibRoute = toFibRoute(ribRoute);
+      fibRoute = toFibRoute(ribRoute, fibNextHopEntry);
     }
 
     updatedFib.emplace_hint(updatedFib.cend(), fibPrefix, fibRoute);
@@ -106,10 +113,64 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
             return entry.value().isResolved();
           }));
 
-  return std::make_unique<ForwardingInformationBase<AddressT>>(
+  return std::make_shared<ForwardingInformationBase<AddressT>>(
       std::move(updatedFib));
 }
 
+template <typename AddressT>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+ForwardingInformationBaseUpdater::patchFib(
+    const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fib) {
+  constexpr bool kIsV4 = std::is_same_v<AddressT, folly::IPAddressV4>;
+
+  // Only cloned once an entry actually changes, so that a FIB with no
+  // changes is shared with the previous SwitchState
+  std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>
+      updatedFib;
+  auto writableFib = [&]() {
+    if (!updatedFib) {
+      updatedFib = fib->clone();
+    }
+    return updatedFib.get();
+  };
+
+  for (const auto& prefix : *changedPrefixes_) {
+    if (prefix.first.isV4() != kIsV4) {
+      continue;
+    }
+    AddressT network;
+    if constexpr (kIsV4) {
+      network = prefix.first.asV4();
+    } else {
+      network = prefix.first.asV6();
+    }
+    facebook::fboss::RoutePrefix<AddressT> fibPrefix{network, prefix.second};
+    auto fibRoute = fib->getNodeIf(fibPrefix);
+
+    auto ribIt = rib.exactMatch(network, prefix.second);
+    if (ribIt == rib.end() || !ribIt->value().isResolved()) {
+      if (fibRoute) {
+        writableFib()->removeNode(fibPrefix);
+      }
+      continue;
+    }
+
+    const auto& ribRoute = ribIt->value();
+    auto fibNextHopEntry = fibNextHop(ribRoute.getForwardInfo());
+    if (!fibRoute) {
+      writableFib()->addNode(toFibRoute(ribRoute, fibNextHopEntry));
+    } else if (
+        !(fibNextHopEntry == fibRoute->getForwardInfo()) ||
+        ribRoute.isConnected() != fibRoute->isConnected()) {
+      writableFib()->updateNode(toFibRoute(ribRoute, fibNextHopEntry));
+    }
+  }
+
+  return updatedFib ? updatedFib : fib;
+}
+
 facebook::fboss::RouteNextHopEntry
 ForwardingInformationBaseUpdater::toFibNextHop(
     const RouteNextHopEntry& ribNextHopEntry) {
@@ -138,9 +199,31 @@ ForwardingInformationBaseUpdater::toFibNextHop(
   XLOG(FATAL) << "Unknown RouteNextHopEntry::Action value";
 }
 
+facebook::fboss::RouteNextHopEntry ForwardingInformationBaseUpdater::fibNextHop(
+    const RouteNextHopEntry& ribNextHopEntry) {
+  if (ribNextHopEntry.getAction() !=
+      facebook::fboss::rib::RouteNextHopEntry::Action::NEXTHOPS) {
+    return toFibNextHop(ribNextHopEntry);
+  }
+  auto& fibNextHopSet = fibNextHopSets_[&ribNextHopEntry.getNextHopSet()];
+  if (!fibNextHopSet) {
+    fibNextHopSet = toFibNextHop(ribNextHopEntry).getSharedNextHopSet();
+  }
+  return facebook::fboss::RouteNextHopEntry(
+      fibNextHopSet, ribNextHopEntry.getAdminDistance());
+}
+
 template <typename AddrT>
 std::unique_ptr<facebook::fboss::Route<AddrT>>
 ForwardingInformationBaseUpdater::toFibRoute(const Route<AddrT>& ribRoute) {
+  return toFibRoute(ribRoute, toFibNextHop(ribRoute.getForwardInfo()));
+}
+
+template <typename AddrT>
+std::unique_ptr<facebook::fboss::Route<AddrT>>
+ForwardingInformationBaseUpdater::toFibRoute(
+    const Route<AddrT>& ribRoute,
+    const facebook::fboss::RouteNextHopEntry& fibNextHopEntry) {
   CHECK(ribRoute.isResolved());
 
   facebook::fboss::RoutePrefix<AddrT> fibPrefix;
@@ -149,7 +232,7 @@ ForwardingInformationBaseUpdater::toFibRoute(const Route<AddrT>& ribRoute) {
 
   auto fibRoute = std::make_unique<facebook::fboss::Route<AddrT>>(fibPrefix);
 
-  fibRoute->setResolved(toFibNextHop(ribRoute.getForwardInfo()));
+  fibRoute->setResolved(fibNextHopEntry);
   if (ribRoute.isConnected()) {
     fibRoute->setConnected();
   }
@@ -17,6 +17,8 @@
 #include "fboss/agent/types.h"
 
 #include <memory>
+#include <set>
+#include <unordered_map>
 
 namespace facebook::fboss {
 
@@ -28,12 +30,22 @@ namespace facebook::fboss::rib {
 
 class RouteNextHopEntry;
 
+/*
+ * Updates the FIBs of a VRF in the SwitchState to match its RIB.
+ *
+ * If changedPrefixes is given, it must hold every prefix whose route may
+ * have been added, deleted or resolved differently since the FIBs were
+ * last updated from this RIB. Only those FIB entries are updated, in a
+ * clone of the previous FIB. Otherwise the FIBs are built again from the
+ * whole RIB.
+ */
 class ForwardingInformationBaseUpdater {
  public:
   ForwardingInformationBaseUpdater(
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
-      const IPv6NetworkToRouteMap& v6NetworkToRoute);
+      const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const std::set<folly::CIDRNetwork>* changedPrefixes = nullptr);
 
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
@@ -46,15 +58,38 @@ class ForwardingInformationBaseUpdater {
 
  private:
   template <typename AddressT>
-  std::unique_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
   createUpdatedFib(
       const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
       const std::shared_ptr<
           facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+  template <typename AddressT>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  patchFib(
+      const facebook::fboss::rib::NetworkToRouteMap<AddressT>& rib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+
+  /*
+   * As toFibNextHop, but converts each next hop set once per update, as
+   * most routes share one of a few sets.
+   */
+  facebook::fboss::RouteNextHopEntry fibNextHop(
+      const RouteNextHopEntry& ribNextHopEntry);
+  template <typename AddrT>
+  static std::unique_ptr<facebook::fboss::Route<AddrT>> toFibRoute(
+      const Route<AddrT>& ribRoute,
+      const facebook::fboss::RouteNextHopEntry& fibNextHopEntry);
 
   RouterID vrf_;
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
+  const std::set<folly::CIDRNetwork>* changedPrefixes_;
+  // Interned RIB next hop set to the interned FIB one it converts to
+  std::unordered_map<
+      const void*,
+      std::shared_ptr<const facebook::fboss::RouteNextHopEntry::NextHopSet>>
+      fibNextHopSets_;
 };
 
 } // namespace facebook::fboss::rib
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include "fboss/agent/rib/NextHopDependencies.h"
 #include "fboss/agent/rib/Route.h"
 #include "fboss/lib/RadixTree.h"
 
@@ -16,6 +17,8 @@
 #include <folly/dynamic.h>
 
 #include <memory>
+#include <tuple>
+#include <vector>
 
 namespace facebook::fboss::rib {
 
@@ -39,15 +42,31 @@ class NetworkToRouteMap
       const folly::dynamic& routes) {
     NetworkToRouteMap<AddressT> networkToRouteMap;
 
-    auto routesJson = routes[kRoutes];
+    const auto& routesJson = routes[kRoutes];
+    std::vector<std::tuple<AddressT, uint8_t, Route<AddressT>>> entries;
+    entries.reserve(routesJson.size());
     for (const auto& routeJson : routesJson) {
       auto route = Route<AddressT>::fromFollyDynamic(routeJson);
       RoutePrefix<AddressT> prefix = route.prefix();
-      networkToRouteMap.insert(prefix.network, prefix.mask, std::move(route));
+      entries.emplace_back(prefix.network, prefix.mask, std::move(route));
     }
+    networkToRouteMap.bulkInsert(std::move(entries));
 
     return networkToRouteMap;
   }
+
+  /*
+   * Maintained by RouteUpdater, see NextHopDependencies
+   */
+  const NextHopDependencies& nextHopDependencies() const {
+    return nextHopDependencies_;
+  }
+  NextHopDependencies& nextHopDependencies() {
+    return nextHopDependencies_;
+  }
+
+ private:
+  NextHopDependencies nextHopDependencies_;
 };
 
 using IPv4NetworkToRouteMap = NetworkToRouteMap<folly::IPAddressV4>;
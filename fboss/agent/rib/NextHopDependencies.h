@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace facebook::fboss::rib {
+
+/*
+ * NextHopDependencies records, for one address family of a route table,
+ * which routes looked up which next hop addresses during recursive
+ * resolution, and which route each of those next hops resolved through.
+ *
+ * RouteUpdater uses it to find the routes an update can affect, so that it
+ * only re-resolves those rather than the whole table. A route's resolution
+ * only depends on the routes its next hops resolve through, so if a prefix
+ * is added, deleted or re-resolved, the only routes that can change are
+ * those with a next hop inside that prefix, that resolved through the
+ * prefix itself, a shorter one, or nothing at all.
+ *
+ * The next hops are tracked in the table of their own address family,
+ * whatever the family of the route using them. The next hops looked up by
+ * a route are tracked in the table of the route's family.
+ *
+ * The dependencies start out invalid, and are only valid once a full
+ * resolution of the table has recorded them.
+ */
+class NextHopDependencies {
+ public:
+  bool isValid() const {
+    return valid_;
+  }
+  void setValid() {
+    valid_ = true;
+  }
+  void clear() {
+    nextHops_.clear();
+    lookups_.clear();
+    valid_ = false;
+  }
+
+  /*
+   * Record that resolving route looked up nextHop, and that it resolved
+   * through the route for via (std::nullopt if no route matched).
+   */
+  void addNextHopUser(
+      const folly::IPAddress& nextHop,
+      const std::optional<folly::CIDRNetwork>& via,
+      const folly::CIDRNetwork& route) {
+    auto& info = nextHops_[nextHop];
+    info.via = via;
+    info.users.insert(route);
+  }
+
+  void removeNextHopUser(
+      const folly::IPAddress& nextHop,
+      const folly::CIDRNetwork& route) {
+    auto it = nextHops_.find(nextHop);
+    if (it == nextHops_.end()) {
+      return;
+    }
+    it->second.users.erase(route);
+    if (it->second.users.empty()) {
+      nextHops_.erase(it);
+    }
+  }
+
+  /*
+   * Next hops looked up while resolving route, which must belong to this
+   * address family.
+   */
+  void addLookup(
+      const folly::CIDRNetwork& route,
+      const folly::IPAddress& nextHop) {
+    lookups_[route].push_back(nextHop);
+  }
+
+  std::vector<folly::IPAddress> takeLookups(const folly::CIDRNetwork& route) {
+    std::vector<folly::IPAddress> nextHops;
+    auto it = lookups_.find(route);
+    if (it != lookups_.end()) {
+      nextHops = std::move(it->second);
+      lookups_.erase(it);
+    }
+    return nextHops;
+  }
+
+  /*
+   * Call fn on every route that may resolve differently if the route for
+   * prefix, which must belong to this address family, changes.
+   */
+  template <typename Fn>
+  void forEachAffectedUser(const folly::CIDRNetwork& prefix, Fn fn) const {
+    // Addresses in prefix are contiguous in nextHops_
+    for (auto it = nextHops_.lower_bound(prefix.first);
+         it != nextHops_.end() &&
+         it->first.inSubnet(prefix.first, prefix.second);
+         ++it) {
+      const auto& via = it->second.via;
+      // Next hops resolved through a longer prefix are unaffected
+      if (via && via->second > prefix.second) {
+        continue;
+      }
+      for (const auto& user : it->second.users) {
+        fn(user);
+      }
+    }
+  }
+
+ private:
+  struct NextHopInfo {
+    std::optional<folly::CIDRNetwork> via;
+    std::set<folly::CIDRNetwork> users;
+  };
+
+  std::map<folly::IPAddress, NextHopInfo> nextHops_;
+  std::map<folly::CIDRNetwork, std::vector<folly::IPAddress>> lookups_;
+  bool valid_{false};
+};
+
+} // namespace facebook::fboss::rib
@@ -65,8 +65,8 @@ std::vector<NextHopThrift> fromRouteNextHopSet(RouteNextHopSet const& nhs) {
 RouteNextHopEntry::RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance)
     : adminDistance_(distance),
       action_(Action::NEXTHOPS),
-      nhopSet_(std::move(nhopSet)) {
-  if (nhopSet_.size() == 0) {
+      nhopSet_(NextHopSetInterner::intern(std::move(nhopSet))) {
+  if (nhopSet_->size() == 0) {
     throw FbossError("Empty nexthop set is passed to the RouteNextHopEntry");
   }
 }
@@ -97,9 +97,10 @@ std::string RouteNextHopEntry::str() const {
 }
 
 bool operator==(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
+  // Equal next hop sets are the same interned set
   return (
       a.getAction() == b.getAction() and
-      a.getNextHopSet() == b.getNextHopSet() and
+      &a.getNextHopSet() == &b.getNextHopSet() and
       a.getAdminDistance() == b.getAdminDistance());
 }
 
@@ -107,9 +108,11 @@ bool operator<(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
   if (a.getAdminDistance() != b.getAdminDistance()) {
     return a.getAdminDistance() < b.getAdminDistance();
   }
-  return (
-      (a.getAction() == b.getAction()) ? (a.getNextHopSet() < b.getNextHopSet())
-                                       : a.getAction() < b.getAction());
+  if (a.getAction() != b.getAction()) {
+    return a.getAction() < b.getAction();
+  }
+  return &a.getNextHopSet() != &b.getNextHopSet() &&
+      a.getNextHopSet() < b.getNextHopSet();
 }
 
 // Methods for RouteNextHopEntry
@@ -148,7 +151,7 @@ folly::dynamic RouteNextHopEntry::toFollyDynamic() const {
   folly::dynamic entry = folly::dynamic::object;
   entry[kAction] = forwardActionStr(action_);
   folly::dynamic nhops = folly::dynamic::array;
-  for (const auto& nhop : nhopSet_) {
+  for (const auto& nhop : *nhopSet_) {
     nhops.push_back(nhop.toFollyDynamic());
   }
   entry[kNexthops] = std::move(nhops);
@@ -165,9 +168,11 @@ RouteNextHopEntry RouteNextHopEntry::fromFollyDynamic(
       : AdminDistance(entryJson[kAdminDistance].asInt());
   RouteNextHopEntry entry(Action::DROP, adminDistance);
   entry.action_ = action;
+  NextHopSet nhopSet;
   for (const auto& nhop : entryJson[kNexthops]) {
-    entry.nhopSet_.insert(util::nextHopFromFollyDynamic(nhop));
+    nhopSet.insert(util::nextHopFromFollyDynamic(nhop));
   }
+  entry.nhopSet_ = NextHopSetInterner::intern(std::move(nhopSet));
   return entry;
 }
 
@@ -194,7 +199,7 @@ bool RouteNextHopEntry::isValid(bool forMplsRoute) const {
   bool valid = true;
   if (!forMplsRoute) {
     /* for ip2mpls routes, next hop label forwarding action must be push */
-    for (const auto& nexthop : nhopSet_) {
+    for (const auto& nexthop : *nhopSet_) {
       if (action_ != Action::NEXTHOPS) {
         continue;
       }
@@ -12,9 +12,11 @@
 #include <boost/container/flat_set.hpp>
 
 #include <folly/dynamic.h>
+#include <folly/hash/Hash.h>
 
 #include "fboss/agent/rib/RouteNextHop.h"
 #include "fboss/agent/rib/RouteTypes.h"
+#include "fboss/lib/Interner.h"
 
 #include "fboss/agent/if/gen-cpp2/ctrl_types.h"
 
@@ -35,6 +37,18 @@ class RouteNextHopEntry {
   using Action = RouteForwardAction;
   using NextHopSet = boost::container::flat_set<NextHop>;
 
+  // Hashes the addresses and weights of the next hops, for the Interner
+  struct NextHopSetHash {
+    size_t operator()(const NextHopSet& nhops) const {
+      size_t hash = nhops.size();
+      for (const auto& nhop : nhops) {
+        hash = folly::hash::hash_combine(hash, nhop.addr(), nhop.weight());
+      }
+      return hash;
+    }
+  };
+  using NextHopSetInterner = Interner<NextHopSet, NextHopSetHash>;
+
   RouteNextHopEntry(Action action, AdminDistance distance)
       : adminDistance_(distance), action_(action) {
     CHECK_NE(action_, Action::NEXTHOPS);
@@ -44,9 +58,18 @@ class RouteNextHopEntry {
 
   RouteNextHopEntry(NextHop nhop, AdminDistance distance)
       : adminDistance_(distance), action_(Action::NEXTHOPS) {
-    nhopSet_.emplace(std::move(nhop));
+    NextHopSet nhopSet;
+    nhopSet.emplace(std::move(nhop));
+    nhopSet_ = NextHopSetInterner::intern(std::move(nhopSet));
   }
 
+  /*
+   * Copied rather than moved from, even by a move, so that a moved from
+   * entry still has a next hop set.
+   */
+  RouteNextHopEntry(const RouteNextHopEntry&) = default;
+  RouteNextHopEntry& operator=(const RouteNextHopEntry&) = default;
+
   AdminDistance getAdminDistance() const {
     return adminDistance_;
   }
@@ -56,6 +79,14 @@ class RouteNextHopEntry {
   }
 
   const NextHopSet& getNextHopSet() const {
+    return *nhopSet_;
+  }
+
+  /*
+   * Next hop sets are interned: all entries with equal next hops share the
+   * same NextHopSet, so the set can be compared, or keyed on, by address.
+   */
+  const std::shared_ptr<const NextHopSet>& getSharedNextHopSet() const {
     return nhopSet_;
   }
 
@@ -87,7 +118,7 @@ class RouteNextHopEntry {
 
   // Reset the NextHopSet
   void reset() {
-    nhopSet_.clear();
+    nhopSet_ = NextHopSetInterner::defaultValue();
     action_ = Action::DROP;
   }
 
@@ -107,7 +138,8 @@ class RouteNextHopEntry {
  private:
   AdminDistance adminDistance_;
   Action action_{Action::DROP};
-  NextHopSet nhopSet_;
+  std::shared_ptr<const NextHopSet> nhopSet_{
+      NextHopSetInterner::defaultValue()};
 };
 
 /**
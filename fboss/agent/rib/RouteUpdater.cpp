@@ -11,6 +11,7 @@
 #include "RouteUpdater.h"
 
 #include <numeric>
+#include <type_traits>
 
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
@@ -55,10 +56,12 @@ void RouteUpdater::addRouteImpl(
     }
 
     route->update(clientID, entry);
+    changedPrefixes_.emplace_back(prefix.network, prefix.mask);
     return;
   }
 
   CHECK(it == routes->end());
+  changedPrefixes_.emplace_back(prefix.network, prefix.mask);
   routes->insert(
       prefix.network, prefix.mask, Route<AddressT>(prefix, clientID, entry));
 }
@@ -120,7 +123,11 @@ void RouteUpdater::delRouteImpl(
   }
 
   Route<AddressT>& route = it->value();
+  if (!route.getEntryForClient(clientID)) {
+    return;
+  }
   route.delEntryForClient(clientID);
+  changedPrefixes_.emplace_back(prefix.network, prefix.mask);
 
   XLOG(DBG3) << "Deleted next-hops for prefix " << prefix.str()
              << "from client " << folly::to<std::string>(clientID);
@@ -149,26 +156,36 @@ template <typename AddressT>
 void RouteUpdater::removeAllRoutesFromClientImpl(
     NetworkToRouteMap<AddressT>* routes,
     ClientID clientID) {
-  std::vector<typename NetworkToRouteMap<AddressT>::Iterator> toDelete;
-
-  for (auto it = routes->begin(); it != routes->end(); ++it) {
-    auto& route = it->value();
-    route.delEntryForClient(clientID);
-    if (route.hasNoEntry()) {
-      // The nexthops we removed was the only one.  Delete the route.
-      toDelete.push_back(it);
+  for (auto& entry : *routes) {
+    auto& route = entry.value();
+    if (!route.getEntryForClient(clientID)) {
+      continue;
     }
-  }
-
-  // Now, delete whatever routes went from 1 nexthoplist to 0.
-  for (auto it : toDelete) {
-    routes->erase(it);
+    route.delEntryForClient(clientID);
+    changedPrefixes_.emplace_back(route.prefix().network, route.prefix().mask);
   }
 }
 
 void RouteUpdater::removeAllRoutesForClient(ClientID clientID) {
   removeAllRoutesFromClientImpl<IPAddressV4>(v4Routes_, clientID);
   removeAllRoutesFromClientImpl<IPAddressV6>(v6Routes_, clientID);
+  // Routes left with no entry are only deleted in updateDone(), as the
+  // client usually adds most of them back straight away (e.g. syncFib)
+  hasRoutesWithNoEntry_ = true;
+}
+
+template <typename AddressT>
+void RouteUpdater::deleteRoutesWithNoEntry(
+    NetworkToRouteMap<AddressT>* routes) {
+  std::vector<std::pair<AddressT, uint8_t>> toDelete;
+  for (const auto& entry : *routes) {
+    const auto& route = entry.value();
+    if (route.hasNoEntry()) {
+      XLOG(DBG3) << "Deleted route " << route.str();
+      toDelete.emplace_back(route.prefix().network, route.prefix().mask);
+    }
+  }
+  routes->bulkErase(std::move(toDelete));
 }
 
 // Some helper functions for recursive weight resolution
@@ -383,12 +400,24 @@ RouteNextHopSet mergeForwardInfos(
 template <typename AddressT>
 void RouteUpdater::getFwdInfoFromNhop(
     NetworkToRouteMap<AddressT>* routes,
+    const folly::CIDRNetwork& user,
     const AddressT& nh,
     const std::optional<LabelForwardingAction>& labelAction,
     bool* hasToCpu,
     bool* hasDrop,
-    RouteNextHopSet& fwd) {
+    RouteNextHopSet& fwd,
+    NextHopSetResolution* resolution) {
   auto it = routes->longestMatch(nh, nh.bitCount());
+
+  std::optional<folly::CIDRNetwork> via;
+  if (it != routes->end()) {
+    const auto& viaPrefix = it->value().prefix();
+    via = folly::CIDRNetwork(viaPrefix.network, viaPrefix.mask);
+  }
+  routes->nextHopDependencies().addNextHopUser(nh, via, user);
+  nextHopDependencies(user.first).addLookup(user, nh);
+  resolution->lookups.emplace_back(nh, via);
+
   if (it == routes->end()) {
     XLOG(DBG3) << "Could not find subnet for next-hop:  " << nh;
     // Unresolvable next hop
@@ -401,6 +430,9 @@ void RouteUpdater::getFwdInfoFromNhop(
   if (route->needResolve()) {
     resolveOne(route);
   }
+  if (route->isProcessing()) {
+    resolution->reusable = false;
+  }
   if (route->isResolved()) {
     const auto& fwdInfo = route->getForwardInfo();
     if (fwdInfo.isDrop()) {
@@ -446,15 +478,23 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
   bool hasDrop{false};
   RouteNextHopSet fwd;
 
+  const folly::CIDRNetwork prefix(
+      route->prefix().network, route->prefix().mask);
   auto bestPair = route->getBestEntry();
   const auto clientId = bestPair.first;
   const auto bestEntry = bestPair.second;
   const auto action = bestEntry->getAction();
+  NextHopSetResolution resolution;
   if (action == RouteForwardAction::DROP) {
     hasDrop = true;
   } else if (action == RouteForwardAction::TO_CPU) {
     hasToCpu = true;
+  } else if (
+      clientId != kInterfaceRouteClientId &&
+      reuseNextHopSetResolution(route, *bestEntry)) {
+    return;
   } else {
+    resolution.nextHops = bestEntry->getSharedNextHopSet();
     NextHopForwardInfos nhToFwds;
     // loop through all nexthops to find out the forward info
     for (const auto& nh : bestEntry->getNextHopSet()) {
@@ -476,20 +516,24 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
       if (addr.isV4()) {
         getFwdInfoFromNhop(
             v4Routes_,
+            prefix,
             nh.addr().asV4(),
             nh.labelForwardingAction(),
             &hasToCpu,
             &hasDrop,
-            nhToFwds[nh]);
+            nhToFwds[nh],
+            &resolution);
       } else {
         CHECK(addr.isV6());
         getFwdInfoFromNhop(
             v6Routes_,
+            prefix,
             nh.addr().asV6(),
             nh.labelForwardingAction(),
             &hasToCpu,
             &hasDrop,
-            nhToFwds[nh]);
+            nhToFwds[nh],
+            &resolution);
       }
     }
 
@@ -514,6 +558,45 @@ void RouteUpdater::resolveOne(Route<AddressT>* route) {
 
   XLOG(DBG3) << (route->isResolved() ? "Resolved" : "Cannot resolve")
              << " route " << route->str();
+
+  // Interface routes are also connected, which the other routes with the
+  // same next hops are not
+  if (resolution.nextHops && resolution.reusable &&
+      clientId != kInterfaceRouteClientId) {
+    if (route->isResolved()) {
+      resolution.forwardInfo = route->getForwardInfo();
+    }
+    auto nextHops = resolution.nextHops.get();
+    nextHopSetResolutions_.emplace(nextHops, std::move(resolution));
+  }
+}
+
+template <typename AddressT>
+bool RouteUpdater::reuseNextHopSetResolution(
+    Route<AddressT>* route,
+    const RouteNextHopEntry& bestEntry) {
+  auto it = nextHopSetResolutions_.find(&bestEntry.getNextHopSet());
+  if (it == nextHopSetResolutions_.end()) {
+    return false;
+  }
+  // The routes the next hops resolved through are all done resolving, so
+  // none of them is this route, and they resolve this route the same way
+  const auto& resolution = it->second;
+  const folly::CIDRNetwork prefix(
+      route->prefix().network, route->prefix().mask);
+  for (const auto& [nextHop, via] : resolution.lookups) {
+    nextHopDependencies(nextHop).addNextHopUser(nextHop, via, prefix);
+    nextHopDependencies(prefix.first).addLookup(prefix, nextHop);
+  }
+  if (resolution.forwardInfo) {
+    route->setResolved(*resolution.forwardInfo);
+  } else {
+    route->setUnresolvable();
+  }
+  XLOG(DBG3) << (route->isResolved() ? "Resolved" : "Cannot resolve")
+             << " route " << route->str() << " as other routes to "
+             << bestEntry.getNextHopSet();
+  return true;
 }
 
 template <typename AddressT>
@@ -535,9 +618,132 @@ void RouteUpdater::updateDoneImpl(NetworkToRouteMap<AddressT>* routes) {
   resolve(routes);
 }
 
+template <typename AddressT>
+std::vector<RouteUpdater::AffectedRoute<AddressT>> RouteUpdater::clearAffected(
+    NetworkToRouteMap<AddressT>* routes,
+    const std::set<folly::CIDRNetwork>& affected) {
+  constexpr bool kIsV4 = std::is_same_v<AddressT, IPAddressV4>;
+  std::vector<AffectedRoute<AddressT>> toResolve;
+  for (const auto& prefix : affected) {
+    if (prefix.first.isV4() != kIsV4) {
+      continue;
+    }
+    removeDependencies(prefix);
+    AddressT network;
+    if constexpr (kIsV4) {
+      network = prefix.first.asV4();
+    } else {
+      network = prefix.first.asV6();
+    }
+    auto it = routes->exactMatch(network, prefix.second);
+    if (it == routes->end()) {
+      continue;
+    }
+    auto& route = it->value();
+    std::optional<RouteNextHopEntry> previousForwardInfo;
+    if (route.isResolved()) {
+      previousForwardInfo = route.getForwardInfo();
+    }
+    route.clearForward();
+    toResolve.emplace_back(&route, std::move(previousForwardInfo));
+  }
+  return toResolve;
+}
+
+void RouteUpdater::resolveAffected() {
+  // The changed prefixes, and all the routes that resolve through them
+  std::set<folly::CIDRNetwork> affected(
+      changedPrefixes_.begin(), changedPrefixes_.end());
+  std::vector<folly::CIDRNetwork> toVisit(affected.begin(), affected.end());
+  while (!toVisit.empty()) {
+    auto prefix = toVisit.back();
+    toVisit.pop_back();
+    nextHopDependencies(prefix.first)
+        .forEachAffectedUser(prefix, [&](const folly::CIDRNetwork& user) {
+          if (affected.insert(user).second) {
+            toVisit.push_back(user);
+          }
+        });
+  }
+  XLOG(DBG3) << changedPrefixes_.size() << " prefixes changed, re-resolving "
+             << affected.size() << " routes";
+
+  // Clear all of them before resolving any, as v4 routes can resolve
+  // through v6 ones and vice versa
+  auto v4ToResolve = clearAffected(v4Routes_, affected);
+  auto v6ToResolve = clearAffected(v6Routes_, affected);
+  // affected is ordered by network, then mask, which is the order a full
+  // resolve() walks each table in. Keep to it, so that routes in a loop
+  // are resolved the same way.
+  for (auto& affectedRoute : v4ToResolve) {
+    if (affectedRoute.first->needResolve()) {
+      resolveOne(affectedRoute.first);
+    }
+  }
+  for (auto& affectedRoute : v6ToResolve) {
+    if (affectedRoute.first->needResolve()) {
+      resolveOne(affectedRoute.first);
+    }
+  }
+  // Prefixes added, deleted or changed by this update are reported as they
+  // are, the others only if they now resolve differently
+  forwardingChanges_.emplace(changedPrefixes_.begin(), changedPrefixes_.end());
+  recordForwardingChanges(v4ToResolve);
+  recordForwardingChanges(v6ToResolve);
+}
+
+template <typename AddressT>
+void RouteUpdater::recordForwardingChanges(
+    const std::vector<AffectedRoute<AddressT>>& resolved) {
+  for (const auto& [route, previousForwardInfo] : resolved) {
+    bool changed = route->isResolved()
+        ? !previousForwardInfo ||
+            !(*previousForwardInfo == route->getForwardInfo())
+        : previousForwardInfo.has_value();
+    if (changed) {
+      const auto& prefix = route->prefix();
+      forwardingChanges_->emplace(prefix.network, prefix.mask);
+    }
+  }
+}
+
+NextHopDependencies& RouteUpdater::nextHopDependencies(
+    const folly::IPAddress& addr) {
+  return addr.isV4() ? v4Routes_->nextHopDependencies()
+                     : v6Routes_->nextHopDependencies();
+}
+
+void RouteUpdater::removeDependencies(const folly::CIDRNetwork& route) {
+  for (const auto& nextHop :
+       nextHopDependencies(route.first).takeLookups(route)) {
+    nextHopDependencies(nextHop).removeNextHopUser(nextHop, route);
+  }
+}
+
 void RouteUpdater::updateDone() {
-  updateDoneImpl(v4Routes_);
-  updateDoneImpl(v6Routes_);
+  if (hasRoutesWithNoEntry_) {
+    deleteRoutesWithNoEntry(v4Routes_);
+    deleteRoutesWithNoEntry(v6Routes_);
+    hasRoutesWithNoEntry_ = false;
+  }
+
+  auto& v4Dependencies = v4Routes_->nextHopDependencies();
+  auto& v6Dependencies = v6Routes_->nextHopDependencies();
+  if (v4Dependencies.isValid() && v6Dependencies.isValid()) {
+    resolveAffected();
+  } else {
+    // Nothing recorded about these tables yet (e.g. they were just created
+    // or deserialized), so resolve all of them, recording dependencies
+    v4Dependencies.clear();
+    v6Dependencies.clear();
+    updateDoneImpl(v4Routes_);
+    updateDoneImpl(v6Routes_);
+    forwardingChanges_.reset();
+    v4Dependencies.setValid();
+    v6Dependencies.setValid();
+  }
+  changedPrefixes_.clear();
+  nextHopSetResolutions_.clear();
 }
 
 } // namespace facebook::fboss::rib
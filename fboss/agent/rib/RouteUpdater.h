@@ -20,6 +20,13 @@
 
 #include <folly/IPAddress.h>
 
+#include <optional>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace facebook::fboss::rib {
 
 /**
@@ -45,6 +52,19 @@ namespace facebook::fboss::rib {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * updateDone() only re-resolves the routes that were added, changed or
+ * deleted, and the routes that (transitively) resolve through them, as
+ * recorded in each table's NextHopDependencies. The result is the same as
+ * resolving the whole table again. The first update to a table resolves
+ * all of it, and records its dependencies.
+ *
+ * Next hop sets are interned, and routes with the same next hop set
+ * resolve the same way, so each set is only resolved once per
+ * updateDone(), and the other routes using it copy its result. This only
+ * saves resolution work: each route keeps its own forward info, so when a
+ * next hop goes away, every route using it still changes in the FIB and
+ * is reprogrammed in hardware on its own.
  */
 class RouteUpdater {
  public:
@@ -72,9 +92,41 @@ class RouteUpdater {
 
   void updateDone();
 
+  /*
+   * The prefixes whose routes the last updateDone() added, deleted or
+   * resolved differently, or nullptr if it resolved the whole table again
+   * and any of them may have changed.
+   */
+  const std::set<folly::CIDRNetwork>* getForwardingChanges() const {
+    return forwardingChanges_ ? &*forwardingChanges_ : nullptr;
+  }
+
  private:
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
+  // Prefixes whose entries changed since the last updateDone()
+  std::vector<folly::CIDRNetwork> changedPrefixes_;
+  std::optional<std::set<folly::CIDRNetwork>> forwardingChanges_;
+  // Set by removeAllRoutesForClient(), see deleteRoutesWithNoEntry()
+  bool hasRoutesWithNoEntry_{false};
+
+  /*
+   * How a next hop set resolved in this updateDone(): the route each next
+   * hop resolved through, and the forward info (std::nullopt if it did not
+   * resolve). Not reusable if a next hop resolved through a route that was
+   * still being resolved, as the set then resolves differently depending
+   * on which route uses it. Only kept until the end of updateDone(), as a
+   * cache for the routes resolved after the first one using the set.
+   */
+  struct NextHopSetResolution {
+    std::shared_ptr<const RouteNextHopSet> nextHops;
+    std::vector<std::pair<folly::IPAddress, std::optional<folly::CIDRNetwork>>>
+        lookups;
+    std::optional<RouteNextHopEntry> forwardInfo;
+    bool reusable{true};
+  };
+  std::unordered_map<const RouteNextHopSet*, NextHopSetResolution>
+      nextHopSetResolutions_;
 
   // TODO(samank): rename in original file
   template <typename AddressT>
@@ -97,21 +149,45 @@ class RouteUpdater {
       NetworkToRouteMap<AddressT>* routes,
       ClientID clientID);
   template <typename AddressT>
+  void deleteRoutesWithNoEntry(NetworkToRouteMap<AddressT>* routes);
+  template <typename AddressT>
   void updateDoneImpl(NetworkToRouteMap<AddressT>* routes);
+  void resolveAffected();
+  // An affected route, and what it forwarded to before it was cleared
+  template <typename AddressT>
+  using AffectedRoute =
+      std::pair<Route<AddressT>*, std::optional<RouteNextHopEntry>>;
+  template <typename AddressT>
+  std::vector<AffectedRoute<AddressT>> clearAffected(
+      NetworkToRouteMap<AddressT>* routes,
+      const std::set<folly::CIDRNetwork>& affected);
+
+  template <typename AddressT>
+  void recordForwardingChanges(
+      const std::vector<AffectedRoute<AddressT>>& resolved);
+
+  NextHopDependencies& nextHopDependencies(const folly::IPAddress& addr);
+  void removeDependencies(const folly::CIDRNetwork& route);
 
   template <typename AddressT>
   void resolve(NetworkToRouteMap<AddressT>* routes);
   template <typename AddressT>
   void resolveOne(Route<AddressT>* route);
+  template <typename AddressT>
+  bool reuseNextHopSetResolution(
+      Route<AddressT>* route,
+      const RouteNextHopEntry& bestEntry);
 
   template <typename AddressT>
   void getFwdInfoFromNhop(
       NetworkToRouteMap<AddressT>* routes,
+      const folly::CIDRNetwork& user,
       const AddressT& nh,
       const std::optional<LabelForwardingAction>& labelAction,
       bool* hasToCpu,
       bool* hasDrop,
-      RouteNextHopSet& fwd);
+      RouteNextHopSet& fwd,
+      NextHopSetResolution* resolution);
 };
 
 } // namespace facebook::fboss::rib
@@ -17,6 +17,7 @@
 #include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteUpdater.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -79,6 +80,9 @@ void RoutingInformationBase::reconfigure(
   for (auto& vrfAndRouteTable : *lockedRouteTables) {
     auto vrf = vrfAndRouteTable.first;
     const auto& interfaceRoutes = configRouterIDToInterfaceRoutes.at(vrf);
+    // Uncontended, since no update() can run without the lock we hold on
+    // the map of VRFs
+    auto lockedRouteTable = vrfAndRouteTable.second->wlock();
 
     // A ConfigApplier object should be independent of the VRF whose routes it
     // is processing. However, because interface and static routes for _all_
@@ -89,8 +93,8 @@ void RoutingInformationBase::reconfigure(
     // processing by the use of boost::filter_iterator.
     ConfigApplier configApplier(
         vrf,
-        &(vrfAndRouteTable.second.v4NetworkToRoute),
-        &(vrfAndRouteTable.second.v6NetworkToRoute),
+        &(lockedRouteTable->v4NetworkToRoute),
+        &(lockedRouteTable->v6NetworkToRoute),
         folly::range(interfaceRoutes.cbegin(), interfaceRoutes.cend()),
         folly::range(staticRoutesToCpu.cbegin(), staticRoutesToCpu.cend()),
         folly::range(staticRoutesToNull.cbegin(), staticRoutesToNull.cend()),
@@ -100,6 +104,8 @@ void RoutingInformationBase::reconfigure(
         cookie);
 
     configApplier.updateRibAndFib();
+    // The state ConfigApplier updated the FIB in may yet be discarded
+    lockedRouteTable->fibInSync = false;
   }
 }
 
@@ -117,15 +123,18 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
 
   Timer updateTimer(&stats.duration);
 
-  auto lockedRouteTables = synchronizedRouteTables_.wlock();
+  // Shared, so that updates to other VRFs can go ahead
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
 
   auto it = lockedRouteTables->find(routerID);
   if (it == lockedRouteTables->end()) {
     throw FbossError("VRF ", routerID, " not configured");
   }
+  auto lockedRouteTable = it->second->wlock();
+  auto& routeTable = *lockedRouteTable;
 
   RouteUpdater updater(
-      &(it->second.v4NetworkToRoute), &(it->second.v6NetworkToRoute));
+      &(routeTable.v4NetworkToRoute), &(routeTable.v6NetworkToRoute));
 
   if (resetClientsRoutes) {
     updater.removeAllRoutesForClient(clientID);
@@ -163,11 +172,17 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
 
   updater.updateDone();
 
+  auto changedPrefixes =
+      routeTable.fibInSync ? updater.getForwardingChanges() : nullptr;
+  // Until the callback returns, the FIB may not reflect this update
+  routeTable.fibInSync = false;
   fibUpdateCallback(
       routerID,
-      it->second.v4NetworkToRoute,
-      it->second.v6NetworkToRoute,
+      routeTable.v4NetworkToRoute,
+      routeTable.v6NetworkToRoute,
+      changedPrefixes,
       cookie);
+  routeTable.fibInSync = true;
 
   return stats;
 }
@@ -176,15 +191,14 @@ folly::dynamic RoutingInformationBase::toFollyDynamic() const {
   folly::dynamic rib = folly::dynamic::object;
 
   auto lockedRouteTables = synchronizedRouteTables_.rlock();
-  for (const auto& routeTable : *lockedRouteTables) {
+  for (const auto& vrfAndRouteTable : *lockedRouteTables) {
     auto routerIdStr =
-        folly::to<std::string>(static_cast<uint32_t>(routeTable.first));
+        folly::to<std::string>(static_cast<uint32_t>(vrfAndRouteTable.first));
+    auto routeTable = vrfAndRouteTable.second->rlock();
     rib[routerIdStr] = folly::dynamic::object;
-    rib[routerIdStr][kRouterId] = static_cast<uint32_t>(routeTable.first);
-    rib[routerIdStr][kRibV4] =
-        routeTable.second.v4NetworkToRoute.toFollyDynamic();
-    rib[routerIdStr][kRibV6] =
-        routeTable.second.v6NetworkToRoute.toFollyDynamic();
+    rib[routerIdStr][kRouterId] = static_cast<uint32_t>(vrfAndRouteTable.first);
+    rib[routerIdStr][kRibV4] = routeTable->v4NetworkToRoute.toFollyDynamic();
+    rib[routerIdStr][kRibV6] = routeTable->v6NetworkToRoute.toFollyDynamic();
   }
 
   return rib;
@@ -198,10 +212,10 @@ RoutingInformationBase RoutingInformationBase::fromFollyDynamic(
   for (const auto& routeTable : ribJson.items()) {
     lockedRouteTables->insert(std::make_pair(
         RouterID(routeTable.first.asInt()),
-        RouteTable{
+        std::make_unique<SynchronizedRouteTable>(RouteTable{
             IPv4NetworkToRouteMap::fromFollyDynamic(routeTable.second[kRibV4]),
             IPv6NetworkToRouteMap::fromFollyDynamic(routeTable.second[kRibV6]),
-            UpdateStatistics{}}));
+            UpdateStatistics{}})));
   }
 
   return rib;
@@ -209,7 +223,8 @@ RoutingInformationBase RoutingInformationBase::fromFollyDynamic(
 
 void RoutingInformationBase::createVrf(RouterID rid) {
   auto lockedRouteTables = synchronizedRouteTables_.wlock();
-  lockedRouteTables->insert(std::make_pair(rid, RouteTable()));
+  lockedRouteTables->insert(
+      std::make_pair(rid, std::make_unique<SynchronizedRouteTable>()));
 }
 
 std::vector<RouterID> RoutingInformationBase::getVrfList() const {
@@ -224,19 +239,19 @@ std::vector<RouterID> RoutingInformationBase::getVrfList() const {
 std::vector<RouteDetails> RoutingInformationBase::getRouteTableDetails(
     RouterID rid) const {
   std::vector<RouteDetails> routeDetails;
-  SYNCHRONIZED_CONST(synchronizedRouteTables_) {
-    const auto it = synchronizedRouteTables_.find(rid);
-    if (it != synchronizedRouteTables_.end()) {
-      for (auto rit = it->second.v4NetworkToRoute.begin();
-           rit != it->second.v4NetworkToRoute.end();
-           ++rit) {
-        routeDetails.emplace_back(rit->value().toRouteDetails());
-      }
-      for (auto rit = it->second.v6NetworkToRoute.begin();
-           rit != it->second.v6NetworkToRoute.end();
-           ++rit) {
-        routeDetails.emplace_back(rit->value().toRouteDetails());
-      }
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  const auto it = lockedRouteTables->find(rid);
+  if (it != lockedRouteTables->end()) {
+    auto routeTable = it->second->rlock();
+    for (auto rit = routeTable->v4NetworkToRoute.begin();
+         rit != routeTable->v4NetworkToRoute.end();
+         ++rit) {
+      routeDetails.emplace_back(rit->value().toRouteDetails());
+    }
+    for (auto rit = routeTable->v6NetworkToRoute.begin();
+         rit != routeTable->v6NetworkToRoute.end();
+         ++rit) {
+      routeDetails.emplace_back(rit->value().toRouteDetails());
     }
   }
   return routeDetails;
@@ -249,24 +264,26 @@ RoutingInformationBase::constructRouteTables(
     const {
   RouterIDToRouteTable newRouteTables;
 
-  RouterIDToRouteTable::iterator newRouteTablesIter;
   for (const auto& routerIDAndInterfaceRoutes :
        configRouterIDToInterfaceRoutes) {
     const RouterID configVrf = routerIDAndInterfaceRoutes.first;
 
-    newRouteTablesIter = newRouteTables.emplace_hint(
-        newRouteTables.cend(), configVrf, RouteTable());
-
     auto oldRouteTablesIter = lockedRouteTables->find(configVrf);
     if (oldRouteTablesIter == lockedRouteTables->end()) {
-      // configVrf did not exist in the RIB, so it has been added to
+      // configVrf did not exist in the RIB, so it is added to
       // newRouteTables with an empty set of routes
+      newRouteTables.emplace_hint(
+          newRouteTables.cend(),
+          configVrf,
+          std::make_unique<SynchronizedRouteTable>());
       continue;
     }
 
-    // configVrf exists in the RIB, so it will be shallow copied into
-    // newRouteTables.
-    newRouteTablesIter->second = std::move(oldRouteTablesIter->second);
+    // configVrf exists in the RIB, so it will be moved into newRouteTables.
+    newRouteTables.emplace_hint(
+        newRouteTables.cend(),
+        configVrf,
+        std::move(oldRouteTablesIter->second));
   }
 
   return newRouteTables;
@@ -277,7 +294,16 @@ bool RoutingInformationBase::operator==(
   const auto& routeTables = synchronizedRouteTables_.rlock();
   const auto& otherTables = other.synchronizedRouteTables_.rlock();
 
-  return *routeTables == *otherTables;
+  return std::equal(
+      routeTables->begin(),
+      routeTables->end(),
+      otherTables->begin(),
+      otherTables->end(),
+      [](const auto& vrfAndRouteTable, const auto& otherVrfAndRouteTable) {
+        return vrfAndRouteTable.first == otherVrfAndRouteTable.first &&
+            *vrfAndRouteTable.second->rlock() ==
+            *otherVrfAndRouteTable.second->rlock();
+      });
 }
 
 } // namespace facebook::fboss::rib
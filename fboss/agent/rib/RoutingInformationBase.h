@@ -18,6 +18,7 @@
 
 #include <functional>
 #include <memory>
+#include <set>
 #include <thread>
 #include <vector>
 
@@ -25,10 +26,17 @@ namespace facebook::fboss::rib {
 
 class RoutingInformationBase {
  public:
+  /*
+   * changedPrefixes holds every prefix whose route may have been added,
+   * deleted or resolved differently since the FIB of vrf was last updated,
+   * so that only those need to be updated. It is null when that is not
+   * known, and the FIB has to be built again from the whole RIB.
+   */
   using FibUpdateFunction = std::function<void(
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
+      const std::set<folly::CIDRNetwork>* changedPrefixes,
       void* cookie)>;
 
   struct UpdateStatistics {
@@ -40,8 +48,8 @@ class RoutingInformationBase {
   };
 
   /*
-   * `update()` first acquires exclusive ownership of the RIB and executes the
-   * following sequence of actions:
+   * `update()` first acquires exclusive ownership of the route table of
+   * `routerID` and executes the following sequence of actions:
    * 1. Injects and removes routes in `toAdd` and `toDelete`, respectively.
    * 2. Triggers recursive (IP) resolution.
    * 3. Updates the FIB synchronously.
@@ -52,6 +60,9 @@ class RoutingInformationBase {
    * this mapping is exposed via SwSwitch, which we can't a dependency on here.
    * The adminDistanceFromClientID allows callsites to propogate admin distances
    * per client.
+   *
+   * Updates to different VRFs may run concurrently, so fibUpdateCallback
+   * must be safe to call from several threads at once for different VRFs.
    */
   UpdateStatistics update(
       RouterID routerID,
@@ -106,6 +117,9 @@ class RoutingInformationBase {
     IPv6NetworkToRouteMap v6NetworkToRoute;
 
     UpdateStatistics lastUpdateStats_;
+    // Whether the FIB was last updated from this table by update(), and
+    // succeeded, so the next update() can pass on only what it changed
+    bool fibInSync{false};
 
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
@@ -117,13 +131,17 @@ class RoutingInformationBase {
   };
 
   /*
-   * Currently, route updates to separate VRFs are made to be sequential. In the
-   * event FBOSS has to operate in a routing architecture with numerous VRFs,
-   * we can avoid a slow down by a factor of number of VRFs by parallelizing
-   * route updates across VRFs. This can be accomplished simply by associating
-   * the mutex implicit in folly::Synchronized with an individual RouteTable.
+   * Each RouteTable has its own lock, so that route updates to separate VRFs
+   * (resolution and building their FIBs) can proceed concurrently. The lock
+   * on the map of VRFs is held shared by update() and the readers, and only
+   * exclusively when the set of VRFs changes.
+   *
+   * Locks are always taken in that order: the map of VRFs, then the
+   * RouteTables in RouterID order.
    */
-  using RouterIDToRouteTable = boost::container::flat_map<RouterID, RouteTable>;
+  using SynchronizedRouteTable = folly::Synchronized<RouteTable>;
+  using RouterIDToRouteTable = boost::container::
+      flat_map<RouterID, std::unique_ptr<SynchronizedRouteTable>>;
   using SynchronizedRouteTables = folly::Synchronized<RouterIDToRouteTable>;
 
   RouterIDToRouteTable constructRouteTables(
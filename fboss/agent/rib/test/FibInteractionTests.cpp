@@ -46,9 +46,10 @@ void dynamicFibUpdate(
     facebook::fboss::RouterID vrf,
     const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const std::set<folly::CIDRNetwork>* changedPrefixes,
     void* cookie) {
   facebook::fboss::rib::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateBlocking("", std::move(fibUpdater));
@@ -620,3 +621,98 @@ TEST(ForwardingInformationBaseUpdater, Deduplication) {
   ASSERT_TRUE(route3);
   EXPECT_NE(route, route3);
 }
+
+namespace {
+// Updates the FIB from only the prefixes the RIB reports as changed, and
+// checks the result against building the FIB again from the whole RIB
+void checkedFibUpdate(
+    facebook::fboss::RouterID vrf,
+    const facebook::fboss::rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const facebook::fboss::rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const std::set<folly::CIDRNetwork>* changedPrefixes,
+    void* cookie) {
+  auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
+  facebook::fboss::rib::ForwardingInformationBaseUpdater fullUpdater(
+      vrf, v4NetworkToRoute, v6NetworkToRoute);
+  auto fullState = fullUpdater(sw->getState());
+
+  dynamicFibUpdate(
+      vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes, cookie);
+
+  const auto& fibContainer = sw->getState()->getFibs()->getFibContainer(vrf);
+  const auto& fullFibContainer = fullState->getFibs()->getFibContainer(vrf);
+  EXPECT_EQ(
+      fibContainer->getFibV4()->toFollyDynamic(),
+      fullFibContainer->getFibV4()->toFollyDynamic());
+  EXPECT_EQ(
+      fibContainer->getFibV6()->toFollyDynamic(),
+      fullFibContainer->getFibV6()->toFollyDynamic());
+}
+} // namespace
+
+TEST(ForwardingInformationBaseUpdater, IncrementalUpdate) {
+  using namespace facebook::fboss;
+
+  const RouterID vrfZero{0};
+  RoutePrefixV6 prefix{folly::IPAddressV6("2a03:2880:ff:1e::"), 64};
+  RoutePrefixV6 recursivePrefix{folly::IPAddressV6("2a03:2880:ff:2e::"), 64};
+
+  cfg::SwitchConfig config;
+  config.vlans_ref()->resize(1);
+  *config.vlans[0].id_ref() = 1;
+  config.interfaces_ref()->resize(1);
+  *config.interfaces[0].intfID_ref() = 1;
+  *config.interfaces[0].vlanID_ref() = 1;
+  *config.interfaces[0].routerID_ref() = vrfZero;
+  config.interfaces_ref()[0].__isset.mac = true;
+  config.interfaces_ref()[0].mac_ref().value_unchecked() = "00:00:00:00:00:11";
+  config.interfaces_ref()[0].ipAddresses_ref()->resize(2);
+  config.interfaces[0].ipAddresses_ref()[0] = "10.120.70.44/31";
+  config.interfaces[0].ipAddresses_ref()[1] =
+      "2401:db00:e003:9100:1006::2c/127";
+
+  auto testHandle =
+      createTestHandle(&config, SwitchFlags::ENABLE_STANDALONE_RIB);
+  auto sw = testHandle->getSw();
+
+  auto update = [&](const std::vector<UnicastRoute>& toAdd,
+                    const std::vector<IpPrefix>& toDelete) {
+    sw->getRib()->update(
+        vrfZero,
+        ClientID(0),
+        AdminDistance::EBGP,
+        toAdd,
+        toDelete,
+        false /* sync */,
+        "incremental FIB unit test",
+        &checkedFibUpdate,
+        static_cast<void*>(sw));
+  };
+
+  update(
+      {createUnicastRoute(
+          prefix.network,
+          prefix.mask,
+          folly::IPAddress("2401:db00:e003:9100:1006::2c"))},
+      {});
+  EXPECT_ROUTE(sw->getState(), vrfZero, prefix.network, prefix.mask);
+
+  // Resolves through prefix
+  update(
+      {createUnicastRoute(
+          recursivePrefix.network,
+          recursivePrefix.mask,
+          folly::IPAddress("2a03:2880:ff:1e::1"))},
+      {});
+  EXPECT_ROUTE(
+      sw->getState(), vrfZero, recursivePrefix.network, recursivePrefix.mask);
+
+  // Deleting prefix leaves recursivePrefix unresolved, so both leave the FIB
+  IpPrefix toDelete;
+  toDelete.set_ip(facebook::network::toBinaryAddress(prefix.network));
+  toDelete.set_prefixLength(prefix.mask);
+  update({}, {toDelete});
+  EXPECT_NO_ROUTE(sw->getState(), vrfZero, prefix.network, prefix.mask);
+  EXPECT_NO_ROUTE(
+      sw->getState(), vrfZero, recursivePrefix.network, recursivePrefix.mask);
+}
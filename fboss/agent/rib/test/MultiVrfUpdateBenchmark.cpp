@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/if/gen-cpp2/ctrl_types.h"
+#include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/ForwardingInformationBaseContainer.h"
+#include "fboss/agent/state/ForwardingInformationBaseMap.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr auto kEcmpWidth = 4;
+constexpr auto kRoutesPerVrf = 20000;
+constexpr auto kRoutesPerUpdate = 1000;
+
+// Interface route of vrf, as 1.<vrf>.0.0/16
+folly::IPAddressV4 interfaceAddress(uint32_t vrf, uint32_t host) {
+  return folly::IPAddressV4::fromLongHBO((1 << 24) | (vrf << 16) | host);
+}
+
+std::shared_ptr<SwitchState> emptyFibState(RouterID vrf) {
+  auto fibContainer = std::make_shared<ForwardingInformationBaseContainer>(vrf);
+  fibContainer->writableFields()->fibV4 =
+      std::make_shared<ForwardingInformationBaseV4>();
+  fibContainer->writableFields()->fibV6 =
+      std::make_shared<ForwardingInformationBaseV6>();
+  auto fibMap = std::make_shared<ForwardingInformationBaseMap>();
+  fibMap->addNode(fibContainer);
+  auto state = std::make_shared<SwitchState>();
+  state->resetForwardingInformationBases(fibMap);
+  return state;
+}
+
+// Builds the FIB of vrf in the unpublished SwitchState cookie points to
+void fibUpdate(
+    RouterID vrf,
+    const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+    const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+    const std::set<folly::CIDRNetwork>* changedPrefixes,
+    void* cookie) {
+  rib::ForwardingInformationBaseUpdater fibUpdater(
+      vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes);
+  auto state = static_cast<std::shared_ptr<SwitchState>*>(cookie);
+  *state = fibUpdater(*state);
+}
+
+void noFibUpdate(
+    RouterID /* vrf */,
+    const rib::IPv4NetworkToRouteMap& /* v4NetworkToRoute */,
+    const rib::IPv6NetworkToRouteMap& /* v6NetworkToRoute */,
+    const std::set<folly::CIDRNetwork>* /* changedPrefixes */,
+    void* /* cookie */) {}
+
+std::vector<std::vector<UnicastRoute>> routeUpdates(uint32_t vrf) {
+  std::vector<std::vector<UnicastRoute>> updates;
+  for (uint32_t i = 0; i < kRoutesPerVrf; ++i) {
+    if (i % kRoutesPerUpdate == 0) {
+      updates.emplace_back();
+    }
+    UnicastRoute route;
+    IpPrefix prefix;
+    prefix.set_ip(facebook::network::toBinaryAddress(
+        folly::IPAddressV4::fromLongHBO((10 << 24) + (i << 8))));
+    prefix.set_prefixLength(24);
+    route.set_dest(prefix);
+    std::vector<NextHopThrift> nexthops(kEcmpWidth);
+    for (auto j = 0; j < kEcmpWidth; ++j) {
+      nexthops[j].address_ref() = facebook::network::toBinaryAddress(
+          interfaceAddress(vrf, 10 + (i + j) % kEcmpWidth));
+      nexthops[j].weight_ref() = ECMP_WEIGHT;
+    }
+    route.nextHops_ref() = std::move(nexthops);
+    updates.back().push_back(std::move(route));
+  }
+  return updates;
+}
+
+/*
+ * Time to program kRoutesPerVrf routes into each of numVrfs VRFs, in
+ * updates of kRoutesPerUpdate routes, with resolution and building the FIB
+ * of each VRF. With concurrent set, each VRF is updated from its own
+ * thread, the way separate routing clients would.
+ */
+void runMultiVrfBenchmark(unsigned iters, size_t numVrfs, bool concurrent) {
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    // Suspend benchamrking for setup.
+    folly::BenchmarkSuspender suspender;
+
+    rib::RoutingInformationBase rib;
+    rib::RoutingInformationBase::RouterIDAndNetworkToInterfaceRoutes
+        interfaceRoutes;
+    std::vector<std::shared_ptr<SwitchState>> states;
+    std::vector<std::vector<std::vector<UnicastRoute>>> updates;
+    for (uint32_t vrf = 0; vrf < numVrfs; ++vrf) {
+      interfaceRoutes[RouterID(vrf)].emplace(
+          folly::CIDRNetwork(interfaceAddress(vrf, 0), 16),
+          std::make_pair(InterfaceID(vrf + 1), interfaceAddress(vrf, 1)));
+      states.push_back(emptyFibState(RouterID(vrf)));
+      updates.push_back(routeUpdates(vrf));
+    }
+    rib.reconfigure(interfaceRoutes, {}, {}, {}, &noFibUpdate, nullptr);
+
+    auto updateVrf = [&](uint32_t vrf) {
+      for (const auto& toAdd : updates[vrf]) {
+        rib.update(
+            RouterID(vrf),
+            ClientID::BGPD,
+            AdminDistance::EBGP,
+            toAdd,
+            {},
+            false,
+            "multi-VRF benchmark",
+            &fibUpdate,
+            &states[vrf]);
+      }
+    };
+
+    // Resume benchmakring post-setup.
+    suspender.dismiss();
+
+    if (concurrent) {
+      std::vector<std::thread> threads;
+      for (uint32_t vrf = 0; vrf < numVrfs; ++vrf) {
+        threads.emplace_back(updateVrf, vrf);
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    } else {
+      for (uint32_t vrf = 0; vrf < numVrfs; ++vrf) {
+        updateVrf(vrf);
+      }
+    }
+
+    suspender.rehire();
+  }
+}
+
+void serialUpdates(unsigned iters, size_t numVrfs) {
+  runMultiVrfBenchmark(iters, numVrfs, false);
+}
+
+void concurrentUpdates(unsigned iters, size_t numVrfs) {
+  runMultiVrfBenchmark(iters, numVrfs, true);
+}
+
+} // namespace
+
+BENCHMARK_PARAM(serialUpdates, 4)
+BENCHMARK_RELATIVE_PARAM(concurrentUpdates, 4)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(serialUpdates, 16)
+BENCHMARK_RELATIVE_PARAM(concurrentUpdates, 16)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(serialUpdates, 32)
+BENCHMARK_RELATIVE_PARAM(concurrentUpdates, 32)
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
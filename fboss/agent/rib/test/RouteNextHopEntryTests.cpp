@@ -158,3 +158,25 @@ TEST(RouteNextHopEntry, EmptyListIsDrop) {
   ASSERT_EQ(nextHopEntry.getAdminDistance(), kDefaultAdminDistance);
   ASSERT_EQ(nextHopEntry.getNextHopSet().size(), 0);
 }
+
+TEST(RouteNextHopEntry, EqualNextHopSetsShared) {
+  UnicastRoute route;
+  route.set_dest(kDestPrefix);
+  route.nextHops_ref() = nextHopsThrift();
+
+  auto entry1 = RouteNextHopEntry::from(route, kDefaultAdminDistance);
+  auto entry2 = RouteNextHopEntry::fromFollyDynamic(entry1.toFollyDynamic());
+  ASSERT_EQ(entry1, entry2);
+  ASSERT_EQ(entry1.getSharedNextHopSet(), entry2.getSharedNextHopSet());
+
+  auto nextHopSet = entry1.getNextHopSet();
+  nextHopSet.erase(nextHopSet.begin());
+  RouteNextHopEntry entry3(nextHopSet, kDefaultAdminDistance);
+  ASSERT_FALSE(entry1 == entry3);
+  ASSERT_NE(entry1.getSharedNextHopSet(), entry3.getSharedNextHopSet());
+
+  // Drop entries share the empty set
+  ASSERT_EQ(
+      RouteNextHopEntry::createDrop().getSharedNextHopSet(),
+      RouteNextHopEntry::createToCpu().getSharedNextHopSet());
+}
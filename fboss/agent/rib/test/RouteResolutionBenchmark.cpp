@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RouteNextHop.h"
+#include "fboss/agent/rib/RouteNextHopEntry.h"
+#include "fboss/agent/rib/RouteUpdater.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::rib;
+
+namespace {
+
+constexpr auto kEcmpWidth = 4;
+const ClientID kBgpClient = ClientID::BGPD;
+
+RouteNextHopEntry ecmpNextHops(uint32_t firstInterface) {
+  RouteNextHopSet nhops;
+  for (auto i = 0; i < kEcmpWidth; ++i) {
+    auto intf = (firstInterface + i) % kEcmpWidth + 1;
+    nhops.emplace(UnresolvedNextHop(
+        folly::IPAddressV4::fromLongHBO((intf << 24) | (intf << 16) | 10),
+        ECMP_WEIGHT));
+  }
+  return RouteNextHopEntry(std::move(nhops), AdminDistance::EBGP);
+}
+
+/*
+ * One interface route per next hop, and numRoutes /24s from 10.0.0.0/24
+ * on resolving through them, the way BGP routes to a set of peers would.
+ */
+void populate(
+    IPv4NetworkToRouteMap* v4Routes,
+    IPv6NetworkToRouteMap* v6Routes,
+    size_t numRoutes) {
+  RouteUpdater updater(v4Routes, v6Routes);
+  for (uint32_t intf = 1; intf <= kEcmpWidth; ++intf) {
+    auto network = (intf << 24) | (intf << 16);
+    updater.addInterfaceRoute(
+        folly::IPAddressV4::fromLongHBO(network),
+        16,
+        folly::IPAddressV4::fromLongHBO(network | 1),
+        InterfaceID(intf));
+  }
+  for (uint32_t i = 0; i < numRoutes; ++i) {
+    updater.addRoute(
+        folly::IPAddressV4::fromLongHBO((10 << 24) + (i << 8)),
+        24,
+        kBgpClient,
+        ecmpNextHops(i));
+  }
+  updater.updateDone();
+}
+
+/*
+ * Latency of an update that adds or removes a single prefix, with a
+ * table of numRoutes routes. With fullResolution, the table's
+ * NextHopDependencies are dropped before each update, so that the whole
+ * table gets resolved again as it was before incremental resolution.
+ */
+void runSinglePrefixUpdateBenchmark(
+    unsigned iters,
+    size_t numRoutes,
+    bool fullResolution) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+  IPv4NetworkToRouteMap v4Routes;
+  IPv6NetworkToRouteMap v6Routes;
+  populate(&v4Routes, &v6Routes, numRoutes);
+  const folly::IPAddressV4 prefix("200.0.0.0");
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    if (fullResolution) {
+      v4Routes.nextHopDependencies().clear();
+    }
+    RouteUpdater updater(&v4Routes, &v6Routes);
+    if (i % 2) {
+      updater.delRoute(prefix, 24, kBgpClient);
+    } else {
+      updater.addRoute(prefix, 24, kBgpClient, ecmpNextHops(i));
+    }
+    updater.updateDone();
+  }
+
+  suspender.rehire();
+}
+
+void fullResolution(unsigned iters, size_t numRoutes) {
+  runSinglePrefixUpdateBenchmark(iters, numRoutes, true);
+}
+
+void incrementalResolution(unsigned iters, size_t numRoutes) {
+  runSinglePrefixUpdateBenchmark(iters, numRoutes, false);
+}
+
+/*
+ * Latency of losing the interface of one of the next hops, and getting it
+ * back, with a table of numRoutes routes which all use it. The routes
+ * share one next hop set, which is resolved once for all of them, but each
+ * route is still updated on its own, so this grows with numRoutes.
+ */
+void nextHopLoss(unsigned iters, size_t numRoutes) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+  IPv4NetworkToRouteMap v4Routes;
+  IPv6NetworkToRouteMap v6Routes;
+  populate(&v4Routes, &v6Routes, numRoutes);
+  const auto network = folly::IPAddressV4::fromLongHBO((1 << 24) | (1 << 16));
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    RouteUpdater updater(&v4Routes, &v6Routes);
+    if (i % 2) {
+      updater.addInterfaceRoute(
+          network,
+          16,
+          folly::IPAddressV4::fromLongHBO(network.toLongHBO() | 1),
+          InterfaceID(1));
+    } else {
+      updater.delRoute(network, 16, ClientID::INTERFACE_ROUTE);
+    }
+    updater.updateDone();
+  }
+
+  suspender.rehire();
+}
+
+} // namespace
+
+BENCHMARK_PARAM(fullResolution, 1000)
+BENCHMARK_RELATIVE_PARAM(incrementalResolution, 1000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(fullResolution, 10000)
+BENCHMARK_RELATIVE_PARAM(incrementalResolution, 10000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(fullResolution, 100000)
+BENCHMARK_RELATIVE_PARAM(incrementalResolution, 100000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(fullResolution, 200000)
+BENCHMARK_RELATIVE_PARAM(incrementalResolution, 200000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(nextHopLoss, 10000)
+BENCHMARK_PARAM(nextHopLoss, 100000)
+BENCHMARK_PARAM(nextHopLoss, 200000)
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -293,6 +293,172 @@ TEST(Route, resolve) {
   }
 }
 
+namespace {
+// Resolve a copy of the route tables from scratch, and check that it
+// matches what incremental resolution produced
+void EXPECT_MATCHES_FULL_RESOLUTION(
+    const IPv4NetworkToRouteMap& v4Routes,
+    const IPv6NetworkToRouteMap& v6Routes) {
+  auto v4Full = IPv4NetworkToRouteMap::fromFollyDynamic(
+      v4Routes.toFollyDynamic());
+  auto v6Full = IPv6NetworkToRouteMap::fromFollyDynamic(
+      v6Routes.toFollyDynamic());
+  RouteUpdater updater(&v4Full, &v6Full);
+  updater.updateDone();
+  EXPECT_ROUTES_MATCH(&v4Routes, &v4Full);
+  EXPECT_ROUTES_MATCH(&v6Routes, &v6Full);
+}
+} // namespace
+
+TEST(Route, resolveIncrementally) {
+  IPv4NetworkToRouteMap v4Routes;
+  IPv6NetworkToRouteMap v6Routes;
+
+  configRoutes(&v4Routes, &v6Routes);
+  {
+    // 10/8 and 20/8 resolve through 1.1.3/24, 30/8 through 20/8, and
+    // 40/8 over a v6 next hop through 1000::/16
+    RouteUpdater u1(&v4Routes, &v6Routes);
+    u1.addRoute(
+        IPAddress("1.1.3.0"),
+        24,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"1.1.1.10"}), kDistance));
+    u1.addRoute(
+        IPAddress("10.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"1.1.3.10"}), kDistance));
+    u1.addRoute(
+        IPAddress("20.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"1.1.3.20", "2.2.2.20"}), kDistance));
+    u1.addRoute(
+        IPAddress("30.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"20.1.1.1"}), kDistance));
+    u1.addRoute(
+        IPAddress("1000::"),
+        16,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"3::10"}), kDistance));
+    u1.addRoute(
+        IPAddress("40.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"1000::1"}), kDistance));
+    u1.updateDone();
+    EXPECT_RESOLVED(getRoute(v4Routes, "30.0.0.0/8"));
+    EXPECT_RESOLVED(getRoute(v4Routes, "40.0.0.0/8"));
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+  {
+    // A longer prefix now covers the next hop of 10/8 only
+    RouteUpdater u2(&v4Routes, &v6Routes);
+    u2.addRoute(
+        IPAddress("1.1.3.0"),
+        28,
+        kClientB,
+        RouteNextHopEntry(makeNextHops({"4.4.4.10"}), kDistance));
+    u2.updateDone();
+    EXPECT_FWD_INFO(
+        getRoute(v4Routes, "10.0.0.0/8"), InterfaceID(4), "4.4.4.10");
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+  {
+    // Changing 1.1.3/24 changes 20/8, and with it 30/8
+    RouteUpdater u3(&v4Routes, &v6Routes);
+    u3.addRoute(
+        IPAddress("1.1.3.0"),
+        24,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"3.3.3.10"}), kDistance));
+    u3.updateDone();
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+  {
+    // Deleting the v6 route leaves 40/8 unresolvable, deleting 1.1.3/28
+    // moves 10/8 back to 1.1.3/24
+    RouteUpdater u4(&v4Routes, &v6Routes);
+    u4.delRoute(IPAddress("1000::"), 16, kClientA);
+    u4.delRoute(IPAddress("1.1.3.0"), 28, kClientB);
+    u4.updateDone();
+    EXPECT_TRUE(getRoute(v4Routes, "40.0.0.0/8")->isUnresolvable());
+    EXPECT_FWD_INFO(
+        getRoute(v4Routes, "10.0.0.0/8"), InterfaceID(3), "3.3.3.10");
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+  {
+    // Close a loop: 20/8 now resolves through 30/8, which resolves
+    // through 20/8
+    RouteUpdater u5(&v4Routes, &v6Routes);
+    u5.addRoute(
+        IPAddress("20.0.0.0"),
+        8,
+        kClientA,
+        RouteNextHopEntry(makeNextHops({"30.1.1.1"}), kDistance));
+    u5.updateDone();
+    EXPECT_TRUE(getRoute(v4Routes, "20.0.0.0/8")->isUnresolvable());
+    EXPECT_TRUE(getRoute(v4Routes, "30.0.0.0/8")->isUnresolvable());
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+  {
+    // Removing all of client A's routes
+    RouteUpdater u6(&v4Routes, &v6Routes);
+    u6.removeAllRoutesForClient(kClientA);
+    u6.updateDone();
+    EXPECT_TRUE(
+        v4Routes.exactMatch(IPAddressV4("10.0.0.0"), 8) == v4Routes.end());
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+}
+
+TEST(Route, resolveSharedNextHops) {
+  IPv4NetworkToRouteMap v4Routes;
+  IPv6NetworkToRouteMap v6Routes;
+
+  configRoutes(&v4Routes, &v6Routes);
+  constexpr auto kNumRoutes = 16;
+  {
+    RouteUpdater u1(&v4Routes, &v6Routes);
+    for (auto i = 0; i < kNumRoutes; ++i) {
+      u1.addRoute(
+          IPAddressV4::fromLongHBO((10 << 24) | (i << 16)),
+          16,
+          kClientA,
+          RouteNextHopEntry(
+              makeNextHops({"1.1.1.10", "2.2.2.10"}), kDistance));
+    }
+    u1.updateDone();
+    const auto& forwardInfo =
+        getRoute(v4Routes, "10.0.0.0/16")->getForwardInfo();
+    EXPECT_EQ(2, forwardInfo.getNextHopSet().size());
+    for (auto i = 0; i < kNumRoutes; ++i) {
+      auto route = longestMatch(
+          v4Routes, IPAddressV4::fromLongHBO((10 << 24) | (i << 16)));
+      EXPECT_EQ(
+          &forwardInfo.getNextHopSet(),
+          &route->getForwardInfo().getNextHopSet());
+    }
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+  {
+    // Losing interface 2 repairs all the routes sharing its next hop
+    RouteUpdater u2(&v4Routes, &v6Routes);
+    u2.delRoute(IPAddress("2.2.2.0"), 24, ClientID::INTERFACE_ROUTE);
+    u2.updateDone();
+    EXPECT_EQ(kNumRoutes + 1, u2.getForwardingChanges()->size());
+    for (auto i = 0; i < kNumRoutes; ++i) {
+      auto route = longestMatch(
+          v4Routes, IPAddressV4::fromLongHBO((10 << 24) | (i << 16)));
+      EXPECT_FWD_INFO(route, InterfaceID(1), "1.1.1.10");
+    }
+    EXPECT_MATCHES_FULL_RESOLUTION(v4Routes, v6Routes);
+  }
+}
+
 TEST(Route, resolveDropToCPUMix) {
   IPv4NetworkToRouteMap v4Routes;
   IPv6NetworkToRouteMap v6Routes;
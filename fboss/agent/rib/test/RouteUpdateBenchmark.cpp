@@ -14,6 +14,7 @@
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RouteNextHopEntry.h"
 #include "fboss/agent/rib/RouteTypes.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
@@ -23,6 +24,8 @@
 
 #include <folly/Benchmark.h>
 
+#include <set>
+
 using namespace facebook::fboss;
 
 auto constexpr kEcmpWidth = 4;
@@ -48,6 +51,53 @@ std::vector<NextHopThrift> nextHopsThrift(
   return nexthops;
 }
 
+/*
+ * Memory taken by the next hop sets of the routes of Generator, as each
+ * route used to hold its own copy of its set, and now that they are
+ * interned.
+ */
+template <typename Generator>
+void printNextHopSetMemory(const std::string& name) {
+  using NextHopSet = rib::RouteNextHopEntry::NextHopSet;
+  using NextHopSetInterner = rib::RouteNextHopEntry::NextHopSetInterner;
+
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle = createTestHandle(&config, SwitchFlags::DEFAULT);
+  auto sw = testHandle->getSw();
+
+  auto setBytes = [](const NextHopSet& nhops) {
+    return sizeof(NextHopSet) + nhops.capacity() * sizeof(rib::NextHop);
+  };
+  auto setsBefore = NextHopSetInterner::size();
+  std::vector<rib::RouteNextHopEntry> entries;
+  size_t copiedBytes = 0;
+  auto generator = Generator(sw->getAppliedState(), 1337, kEcmpWidth);
+  for (const auto& chunk : generator.get()) {
+    for (const auto& route : chunk) {
+      auto nhops = rib::util::toRouteNextHopSet(nextHopsThrift(route.nhops));
+      copiedBytes += setBytes(nhops);
+      entries.emplace_back(std::move(nhops), AdminDistance::EBGP);
+    }
+  }
+  auto sharedBytes = entries.size() * sizeof(std::shared_ptr<NextHopSet>);
+  std::set<const NextHopSet*> sets;
+  for (const auto& entry : entries) {
+    if (sets.insert(&entry.getNextHopSet()).second) {
+      sharedBytes += setBytes(entry.getNextHopSet());
+    }
+  }
+  CHECK_EQ(NextHopSetInterner::size() - setsBefore, sets.size());
+  LOG(INFO) << name << ": " << entries.size() << " routes, " << sets.size()
+            << " next hop sets, " << copiedBytes << " bytes copied per route, "
+            << sharedBytes << " bytes interned";
+}
+
 } // namespace
 
 template <typename Generator>
@@ -149,9 +199,10 @@ static void runNewRibTest() {
         [](RouterID vrf,
            const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
            const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+           const std::set<folly::CIDRNetwork>* changedPrefixes,
            void* cookie) {
           rib::ForwardingInformationBaseUpdater fibUpdater(
-              vrf, v4NetworkToRoute, v6NetworkToRoute);
+              vrf, v4NetworkToRoute, v6NetworkToRoute, changedPrefixes);
           static_cast<SwSwitch*>(cookie)->updateStateBlocking(
               "", std::move(fibUpdater));
         },
@@ -193,6 +244,8 @@ BENCHMARK_RELATIVE(FibSyncHgridUu) {
 
 int main(int argc, char** argv) {
   facebook::initFacebook(&argc, &argv);
+  printNextHopSetMemory<utility::FSWRouteScaleGenerator>("FSW");
+  printNextHopSetMemory<utility::THAlpmRouteScaleGenerator>("THAlpm");
   folly::runBenchmarks();
   return EXIT_SUCCESS;
 }
@@ -11,11 +11,20 @@
 
 #include "fboss/agent/state/NodeMap-defs.h"
 
+#include <utility>
+
 namespace facebook::fboss {
 
 template <typename AddressT>
 ForwardingInformationBase<AddressT>::ForwardingInformationBase() {}
 
+template <typename AddressT>
+ForwardingInformationBase<AddressT>::ForwardingInformationBase(
+    const ForwardingInformationBase* orig)
+    : Base(orig),
+      lookupTrie_(orig->lookupTrie_),
+      lookupTrieVersion_(orig->lookupTrieVersion_) {}
+
 template <typename AddressT>
 ForwardingInformationBase<AddressT>::~ForwardingInformationBase() {}
 
@@ -30,6 +39,74 @@ template <typename AddressT>
 std::shared_ptr<Route<AddressT>>
 ForwardingInformationBase<AddressT>::longestMatch(
     const AddressT& address) const {
+  if (!this->isPublished()) {
+    return longestMatchUnpublished(address);
+  }
+  auto route = lookupTrie_.longestMatch(address);
+  return route ? *route : nullptr;
+}
+
+template <typename AddressT>
+std::vector<std::shared_ptr<Route<AddressT>>>
+ForwardingInformationBase<AddressT>::longestMatch(
+    folly::Range<const AddressT*> addresses) const {
+  std::vector<std::shared_ptr<Route<AddressT>>> routes;
+  routes.reserve(addresses.size());
+  if (!this->isPublished()) {
+    for (const auto& address : addresses) {
+      routes.push_back(longestMatchUnpublished(address));
+    }
+    return routes;
+  }
+  std::vector<const std::shared_ptr<Route<AddressT>>*> matches(
+      addresses.size());
+  lookupTrie_.longestMatch(addresses, matches.data());
+  for (auto match : matches) {
+    routes.push_back(match ? *match : nullptr);
+  }
+  return routes;
+}
+
+template <typename AddressT>
+void ForwardingInformationBase<AddressT>::publish() {
+  if (this->isPublished()) {
+    return;
+  }
+  const auto& journal = this->getFields()->journal;
+  auto changedPrefixes = lookupTrieVersion_
+      ? journal.changedKeysSince(*lookupTrieVersion_)
+      : std::nullopt;
+  if (changedPrefixes) {
+    std::vector<typename LookupTrie::Change> changes;
+    changes.reserve(changedPrefixes->size());
+    for (const auto& prefix : *changedPrefixes) {
+      // Routes no longer in the FIB leave the value unset, to remove them
+      typename LookupTrie::Change change{prefix.network, prefix.mask};
+      if (auto route = exactMatch(prefix)) {
+        change.value = std::move(route);
+      }
+      changes.push_back(std::move(change));
+    }
+    lookupTrie_.update(std::move(changes));
+  } else {
+    std::vector<typename LookupTrie::Prefix> prefixes;
+    prefixes.reserve(this->size());
+    for (const auto& prefixAndRoute : Base::getAllNodes()) {
+      prefixes.push_back(typename LookupTrie::Prefix{
+          prefixAndRoute.first.network,
+          prefixAndRoute.first.mask,
+          prefixAndRoute.second});
+    }
+    lookupTrie_ = LookupTrie(std::move(prefixes));
+  }
+  lookupTrieVersion_ = journal.getVersion();
+  Base::publish();
+}
+
+template <typename AddressT>
+std::shared_ptr<Route<AddressT>>
+ForwardingInformationBase<AddressT>::longestMatchUnpublished(
+    const AddressT& address) const {
   std::shared_ptr<Route<AddressT>> longestMatchRoute = nullptr;
   // longestCommonLength must be wider than int8_t because it needs to hold
   // values in the range [-1, 128].
@@ -10,17 +10,29 @@
 #pragma once
 
 #include "fboss/agent/state/NodeMap.h"
+#include "fboss/agent/state/PersistentBTreeMap.h"
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/lib/MultibitTrie.h"
 
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/Range.h>
+
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace facebook::fboss {
 
 template <typename AddressT>
-using ForwardingInformationBaseTraits =
-    NodeMapTraits<RoutePrefix<AddressT>, Route<AddressT>>;
+using ForwardingInformationBaseTraits = NodeMapTraits<
+    RoutePrefix<AddressT>,
+    Route<AddressT>,
+    NodeMapNoExtraFields,
+    PersistentBTreeMap<
+        RoutePrefix<AddressT>,
+        std::shared_ptr<Route<AddressT>>>>;
 
 template <typename AddressT>
 class ForwardingInformationBase
@@ -38,12 +50,41 @@ class ForwardingInformationBase
   std::shared_ptr<Route<AddressT>> exactMatch(
       const RoutePrefix<AddressT>& prefix) const;
 
+  /*
+   * Once the FIB is published, lookups go through a MultibitTrie built by
+   * publish(). Unpublished FIBs can still change, so they are searched
+   * directly.
+   */
   std::shared_ptr<Route<AddressT>> longestMatch(const AddressT& address) const;
+  std::vector<std::shared_ptr<Route<AddressT>>> longestMatch(
+      folly::Range<const AddressT*> addresses) const;
+
+  /*
+   * Bring the lookup trie up to date before marking the FIB published.
+   * Clones start off with the trie of the FIB they were cloned from, so
+   * this only applies the routes changed since, as found in the change
+   * journal. The trie is only built from scratch for the first FIB, or
+   * when the journal can't tell what changed.
+   */
+  void publish() override;
 
  private:
+  using LookupTrie = facebook::network::
+      MultibitTrie<AddressT, std::shared_ptr<Route<AddressT>>>;
+
+  std::shared_ptr<Route<AddressT>> longestMatchUnpublished(
+      const AddressT& address) const;
+
   // Inherit the constructors required for clone()
   using Base::Base;
   friend class CloneAllocator;
+
+  // Used by clone(), shares the trie of the FIB we are cloned from
+  explicit ForwardingInformationBase(const ForwardingInformationBase* orig);
+
+  // Trie for the routes as of the map version lookupTrieVersion_, if any
+  LookupTrie lookupTrie_;
+  std::optional<uint64_t> lookupTrieVersion_;
 };
 
 using ForwardingInformationBaseV4 =
@@ -12,6 +12,7 @@
 #include "fboss/agent/state/MacEntry.h"
 #include "fboss/agent/state/NodeMap.h"
 #include "fboss/agent/state/NodeMapDelta.h"
+#include "fboss/agent/state/PersistentBTreeMap.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/types.h"
 
@@ -19,7 +20,11 @@
 
 namespace facebook::fboss {
 
-using MacTableTraits = NodeMapTraits<folly::MacAddress, MacEntry>;
+using MacTableTraits = NodeMapTraits<
+    folly::MacAddress,
+    MacEntry,
+    NodeMapNoExtraFields,
+    PersistentBTreeMap<folly::MacAddress, std::shared_ptr<MacEntry>>>;
 
 class MacTable : public NodeMapT<MacTable, MacTableTraits> {
  public:
@@ -48,17 +53,16 @@ class MacTable : public NodeMapT<MacTable, MacTableTraits> {
       PortDescriptor portDescr,
       std::optional<cfg::AclLookupClass> classID) {
     CHECK(!this->isPublished());
-    auto& nodes = this->writableNodes();
-    auto it = nodes.find(mac);
-    if (it == nodes.end()) {
+    auto oldEntry = getNodeIf(mac);
+    if (!oldEntry) {
       throw FbossError("Mac entry for ", mac.toString(), " does not exist");
     }
-    auto entry = it->second->clone();
+    auto entry = oldEntry->clone();
 
     entry->setMac(mac);
     entry->setPort(portDescr);
     entry->setClassID(classID);
-    it->second = entry;
+    updateNode(entry);
   }
 
  private:
@@ -14,6 +14,7 @@
 #include <folly/json.h>
 #include "fboss/agent/state/NeighborEntry.h"
 #include "fboss/agent/state/NodeMap.h"
+#include "fboss/agent/state/PersistentBTreeMap.h"
 #include "fboss/agent/state/PortDescriptor.h"
 
 namespace {
@@ -30,6 +31,7 @@ struct NeighborTableTraits {
   typedef IPADDR KeyType;
   typedef ENTRY Node;
   typedef NodeMapNoExtraFields ExtraFields;
+  typedef PersistentBTreeMap<KeyType, std::shared_ptr<Node>> NodeContainer;
 
   static KeyType getKey(const std::shared_ptr<Node>& entry) {
     return entry->getIP();
@@ -39,12 +41,8 @@ struct NeighborTableTraits {
 /*
  * A map of IP --> MAC for the IP addresses of other nodes on a VLAN.
  *
- * TODO: We should switch from NodeMap to PrefixMap when the new PrefixMap
- * implementation is ready.
- *
- * Any change to a NodeMap is O(N), so it is really only suitable for small
- * maps that do not change frequently.  Our new PrefixMap implementation will
- * allow us to perform cheaper copy-on-write updates.
+ * Entries are kept in a PersistentBTreeMap, so the copy-on-write update of a
+ * single entry is O(log N) even for large tables.
  */
 template <typename IPADDR, typename ENTRY, typename SUBCLASS>
 class NeighborTable
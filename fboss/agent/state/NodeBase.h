@@ -10,6 +10,7 @@
 #pragma once
 
 #include "fboss/agent/Utils.h"
+#include "fboss/agent/state/StreamingStateWriter.h"
 #include "fboss/agent/types.h"
 
 #include <boost/cast.hpp>
@@ -223,6 +224,15 @@ class NodeBaseT : public NodeBase {
     return folly::toJson(toFollyDynamic());
   }
 
+  /*
+   * Write the same JSON toFollyDynamic() generates to writer. Nodes with
+   * large subtrees override this to write their children one at a time,
+   * rather than building a folly::dynamic for the whole subtree.
+   */
+  virtual void writeTo(StreamingStateWriter& writer) const {
+    writer.value(toFollyDynamic());
+  }
+
   template <typename... Args>
   explicit NodeBaseT(Args&&... args) : fields_(std::forward<Args>(args)...) {}
 
@@ -49,33 +49,39 @@ std::shared_ptr<typename TraitsT::Node> NodeMapT<MapTypeT, TraitsT>::getNodeIf(
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::addNode(const std::shared_ptr<Node>& node) {
-  auto& nodes = writableNodes();
-  auto ret = nodes.insert(std::make_pair(TraitsT::getKey(node), node));
+  auto fields = this->writableFields();
+  auto key = TraitsT::getKey(node);
+  auto ret = fields->nodes.insert(std::make_pair(key, node));
   if (!ret.second) {
-    throw FbossError("duplicate node ID ", TraitsT::getKey(node));
+    throw FbossError("duplicate node ID ", key);
   }
+  fields->journal.record(key, fields->nodes.size());
 }
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::updateNode(
     const std::shared_ptr<Node>& node) {
-  auto& nodes = writableNodes();
-  auto it = nodes.find(TraitsT::getKey(node));
-  if (it == nodes.end()) {
-    throw FbossError("node ID ", TraitsT::getKey(node), " does not exist");
+  auto fields = this->writableFields();
+  auto key = TraitsT::getKey(node);
+  if (fields->nodes.find(key) == fields->nodes.end()) {
+    throw FbossError("node ID ", key, " does not exist");
   }
-  it->second = node;
+  // Some NodeContainers (e.g. PersistentBTreeMap) only have const iterators
+  fields->nodes[key] = node;
+  fields->journal.record(key, fields->nodes.size());
 }
 
 template <typename MapTypeT, typename TraitsT>
 void NodeMapT<MapTypeT, TraitsT>::removeNode(
     const std::shared_ptr<Node>& node) {
-  auto& nodes = writableNodes();
-  auto it = nodes.find(TraitsT::getKey(node));
-  if (it == nodes.end()) {
-    throw FbossError("node ID ", TraitsT::getKey(node), " does not exist");
+  auto fields = this->writableFields();
+  auto key = TraitsT::getKey(node);
+  auto it = fields->nodes.find(key);
+  if (it == fields->nodes.end()) {
+    throw FbossError("node ID ", key, " does not exist");
   }
-  nodes.erase(it);
+  fields->nodes.erase(it);
+  fields->journal.record(key, fields->nodes.size());
 }
 
 template <typename MapTypeT, typename TraitsT>
@@ -91,13 +97,14 @@ std::shared_ptr<typename TraitsT::Node> NodeMapT<MapTypeT, TraitsT>::removeNode(
 template <typename MapTypeT, typename TraitsT>
 std::shared_ptr<typename TraitsT::Node>
 NodeMapT<MapTypeT, TraitsT>::removeNodeIf(const KeyType& key) {
-  auto& nodes = writableNodes();
-  auto it = nodes.find(key);
-  if (it == nodes.end()) {
+  auto fields = this->writableFields();
+  auto it = fields->nodes.find(key);
+  if (it == fields->nodes.end()) {
     return nullptr;
   }
   std::shared_ptr<Node> node = it->second;
-  nodes.erase(it);
+  fields->nodes.erase(it);
+  fields->journal.record(key, fields->nodes.size());
   return node;
 }
 
@@ -113,11 +120,26 @@ folly::dynamic NodeMapT<MapTypeT, TraitsT>::toFollyDynamic() const {
   return json;
 }
 
+template <typename MapTypeT, typename TraitsT>
+void NodeMapT<MapTypeT, TraitsT>::writeNodeMapTo(
+    StreamingStateWriter& writer) const {
+  writer.beginObject();
+  writer.key(kEntries);
+  writer.beginArray();
+  for (const auto& node : *this) {
+    node->writeTo(writer);
+  }
+  writer.endArray();
+  writer.key(kExtraFields);
+  writer.value(getExtraFields().toFollyDynamic());
+  writer.endObject();
+}
+
 template <typename MapTypeT, typename TraitsT>
 std::shared_ptr<MapTypeT> NodeMapT<MapTypeT, TraitsT>::fromFollyDynamic(
     const folly::dynamic& nodesJson) {
   auto nodeMap = std::make_shared<MapTypeT>();
-  auto entries = nodesJson[kEntries];
+  const auto& entries = nodesJson[kEntries];
   for (const auto& entry : entries) {
     nodeMap->addNode(Node::fromFollyDynamic(entry));
   }
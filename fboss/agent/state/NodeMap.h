@@ -12,7 +12,12 @@
 #include <boost/container/flat_map.hpp>
 
 #include "fboss/agent/state/NodeBase.h"
+#include "fboss/agent/state/NodeMapChangeJournal.h"
 #include "fboss/agent/state/NodeMapIterator.h"
+#include "fboss/agent/state/PersistentBTreeMap.h"
+
+#include <optional>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -24,24 +29,32 @@ struct NodeMapFields {
   using KeyType = typename TraitsT::KeyType;
   using Node = typename TraitsT::Node;
   using ExtraFields = typename TraitsT::ExtraFields;
-  using NodeContainer =
-      boost::container::flat_map<KeyType, std::shared_ptr<Node>>;
+  using NodeContainer = typename TraitsT::NodeContainer;
 
   NodeMapFields() {}
   NodeMapFields(NodeContainer nodes) : nodes(std::move(nodes)) {}
   NodeMapFields(const NodeMapFields& other, NodeContainer nodes)
       : nodes(std::move(nodes)), extra(other.extra) {}
 
+  /*
+   * Only used by publish(). A PersistentBTreeMap skips the nodes it shares
+   * with the published map it was cloned from, as they are published already.
+   */
   template <typename Fn>
   void forEachChild(Fn fn) {
-    for (const auto& nodePtr : nodes) {
-      fn(nodePtr.second.get());
+    if constexpr (IsPersistentBTreeMap<NodeContainer>::value) {
+      nodes.sealNewEntries([&fn](const auto& node) { fn(node.get()); });
+    } else {
+      for (const auto& nodePtr : nodes) {
+        fn(nodePtr.second.get());
+      }
     }
     extra.forEachChild(fn);
   }
 
   NodeContainer nodes;
   ExtraFields extra;
+  NodeMapChangeJournal<KeyType> journal;
 };
 
 struct NodeMapNoExtraFields {
@@ -57,11 +70,23 @@ struct NodeMapNoExtraFields {
   }
 };
 
-template <typename KeyT, typename NodeT, typename ExtraT = NodeMapNoExtraFields>
+/*
+ * The NodeContainer holds the map's nodes, sorted by key. flat_map is compact
+ * and fast to iterate, but every clone() copies all of it. Large maps that
+ * are updated frequently can use PersistentBTreeMap instead, which shares
+ * most of its storage between clones.
+ */
+template <
+    typename KeyT,
+    typename NodeT,
+    typename ExtraT = NodeMapNoExtraFields,
+    typename NodeContainerT =
+        boost::container::flat_map<KeyT, std::shared_ptr<NodeT>>>
 struct NodeMapTraits {
   using KeyType = KeyT;
   using Node = NodeT;
   using ExtraFields = ExtraT;
+  using NodeContainer = NodeContainerT;
 
   static KeyType getKey(const std::shared_ptr<Node>& node) {
     return node->getID();
@@ -99,8 +124,15 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
   const NodeContainer& getAllNodes() const {
     return this->getFields()->nodes;
   }
+  /*
+   * Direct access to the nodes bypasses the change journal, so deltas against
+   * this map will have to compare it in full. Prefer addNode(), updateNode()
+   * and removeNode() where possible.
+   */
   NodeContainer& writableNodes() {
-    return this->writableFields()->nodes;
+    auto fields = this->writableFields();
+    fields->journal.invalidate();
+    return fields->nodes;
   }
 
   const ExtraFields& getExtraFields() const {
@@ -134,11 +166,31 @@ class NodeMapT : public NodeBaseT<MapTypeT, NodeMapFields<TraitsT>> {
   std::shared_ptr<Node> removeNode(const KeyType& key);
   std::shared_ptr<Node> removeNodeIf(const KeyType& key);
 
+  /*
+   * Keys of the nodes that may have been added, removed or modified since
+   * the given map, sorted in map order. Only possible if this map was cloned
+   * (directly or through a few generations) from other, and then modified
+   * through the functions above. Returns std::nullopt otherwise, in which
+   * case the two maps have to be compared in full.
+   */
+  std::optional<std::vector<KeyType>> changedKeysSince(
+      const MapTypeT& other) const {
+    return this->getFields()->journal.changedKeysSince(
+        other.getFields()->journal.getVersion());
+  }
+
   /*
    * Serialize to folly::dynamic
    */
   folly::dynamic toFollyDynamic() const override;
 
+  /*
+   * Write what NodeMapT::toFollyDynamic() generates to writer, one node at a
+   * time. Maps that keep the default serialization can use this to
+   * implement writeTo().
+   */
+  void writeNodeMapTo(StreamingStateWriter& writer) const;
+
   /*
    * Serialize to json string
    */
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * NodeMapChangeJournal tracks which keys of a NodeMapT have been modified
+ * since the map was cloned from each of its recent ancestors.
+ *
+ * Every map version gets a unique version number, and a map gets a new one
+ * on each modification. Cloning a map copies its journal, and records the
+ * version it was cloned from as an ancestor. Keys touched through the
+ * NodeMapT modifiers are then appended to the journal. Since an unpublished
+ * map can still be modified after it was cloned, the version its clones
+ * know it by only stands for its contents at the time of the clone.
+ * NodeMapDelta uses this to only look at the keys that may have changed
+ * between two versions of a map, rather than walking both maps in full.
+ *
+ * Once the journal grows to a sizeable fraction of the map, or the map has
+ * been modified in ways the journal can't see (e.g. through writableNodes()),
+ * it gives up on its ancestors and NodeMapDelta falls back to a full walk.
+ */
+template <typename KeyT>
+class NodeMapChangeJournal {
+ public:
+  // Number of ancestors to remember changes since
+  static constexpr size_t kMaxAncestors = 64;
+  // Number of keys we always allow to journal, regardless of map size
+  static constexpr size_t kMinKeys = 64;
+
+  NodeMapChangeJournal() : version_(nextVersion()) {}
+
+  /*
+   * Used by clone(), the new journal starts off as a descendant of parent.
+   */
+  NodeMapChangeJournal(const NodeMapChangeJournal& parent)
+      : version_(nextVersion()),
+        ancestors_(parent.ancestors_),
+        changedKeys_(parent.changedKeys_) {
+    ancestors_.emplace_back(parent.version_, changedKeys_.size());
+    if (ancestors_.size() > kMaxAncestors) {
+      // Forget the oldest ancestor, along with the keys that only it needed
+      ancestors_.erase(ancestors_.begin());
+      auto dropKeys = ancestors_.front().second;
+      changedKeys_.erase(
+          changedKeys_.begin(), changedKeys_.begin() + dropKeys);
+      for (auto& ancestor : ancestors_) {
+        ancestor.second -= dropKeys;
+      }
+    }
+  }
+
+  /*
+   * Wholesale assignment of map fields can change anything, so the journal
+   * starts over as a brand new version.
+   */
+  NodeMapChangeJournal& operator=(const NodeMapChangeJournal& /*other*/) {
+    invalidate();
+    return *this;
+  }
+
+  uint64_t getVersion() const {
+    return version_;
+  }
+
+  /*
+   * Note that the node with the given key was added, updated or removed.
+   * mapSize is the number of nodes in the map, used to decide when the
+   * journal is no longer worth keeping.
+   */
+  void record(const KeyT& key, size_t mapSize) {
+    version_ = nextVersion();
+    if (ancestors_.empty()) {
+      return;
+    }
+    changedKeys_.push_back(key);
+    if (changedKeys_.size() > std::max(kMinKeys, mapSize / 4)) {
+      invalidate();
+    }
+  }
+
+  /*
+   * Forget about all ancestors. Used when the map was modified in a way the
+   * journal can't track.
+   */
+  void invalidate() {
+    version_ = nextVersion();
+    ancestors_.clear();
+    changedKeys_.clear();
+  }
+
+  /*
+   * Sorted, deduplicated keys that may differ between the map version with
+   * the given version number and this one, or std::nullopt if that version
+   * is not a known ancestor.
+   */
+  std::optional<std::vector<KeyT>> changedKeysSince(uint64_t version) const {
+    auto it = std::find_if(
+        ancestors_.rbegin(), ancestors_.rend(), [version](const auto& entry) {
+          return entry.first == version;
+        });
+    if (it == ancestors_.rend()) {
+      return std::nullopt;
+    }
+    std::vector<KeyT> keys(
+        changedKeys_.begin() + it->second, changedKeys_.end());
+    std::sort(keys.begin(), keys.end());
+    // Only rely on the ordering flat_map needs from keys
+    auto last = std::unique(
+        keys.begin(), keys.end(), [](const KeyT& lhs, const KeyT& rhs) {
+          return !(lhs < rhs) && !(rhs < lhs);
+        });
+    keys.erase(last, keys.end());
+    return keys;
+  }
+
+ private:
+  static uint64_t nextVersion() {
+    static std::atomic<uint64_t> lastVersion{0};
+    return ++lastVersion;
+  }
+
+  uint64_t version_;
+  // Ancestor version, and the size of changedKeys_ when we derived from it
+  std::vector<std::pair<uint64_t, size_t>> ancestors_;
+  std::vector<KeyT> changedKeys_;
+};
+
+} // namespace facebook::fboss
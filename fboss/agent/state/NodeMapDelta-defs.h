@@ -38,6 +38,22 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
   updateValue();
 }
 
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator(
+    const MapType* oldMap,
+    const MapType* newMap,
+    std::shared_ptr<const std::vector<KeyType>> changedKeys,
+    size_t changedKeyIdx)
+    : oldIt_(oldMap->end()),
+      newIt_(newMap->end()),
+      oldMap_(oldMap),
+      newMap_(newMap),
+      changedKeys_(std::move(changedKeys)),
+      changedKeyIdx_(changedKeyIdx),
+      value_(nullNode_, nullNode_) {
+  skipUnchangedKeys();
+}
+
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::Iterator()
     : oldIt_(),
@@ -71,8 +87,43 @@ void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::updateValue() {
   }
 }
 
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+const std::shared_ptr<typename MAP::Node>&
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::findNode(
+    const MapType* map,
+    const KeyType& key) {
+  const auto& nodes = map->getAllNodes();
+  auto it = nodes.find(key);
+  return it == nodes.end() ? nullNode_ : it->second;
+}
+
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::skipUnchangedKeys() {
+  // The journal may list keys that were modified and then reverted, or added
+  // and removed again, so look for an actual difference.
+  while (changedKeyIdx_ < changedKeys_->size()) {
+    const auto& key = (*changedKeys_)[changedKeyIdx_];
+    const auto& oldNode = findNode(oldMap_, key);
+    const auto& newNode = findNode(newMap_, key);
+    if (oldNode != newNode) {
+      value_.reset(oldNode, newNode);
+      return;
+    }
+    ++changedKeyIdx_;
+  }
+  value_.reset(nullNode_, nullNode_);
+}
+
 template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
 void NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator::advance() {
+  if (changedKeys_) {
+    // advance() shouldn't be called if we are already at the end
+    CHECK_LT(changedKeyIdx_, changedKeys_->size());
+    ++changedKeyIdx_;
+    skipUnchangedKeys();
+    return;
+  }
+
   // If we have already hit the end of one side, advance the other.
   // We are immediately done after this.
   if (oldIt_ == oldMap_->end()) {
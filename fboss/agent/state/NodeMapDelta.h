@@ -13,6 +13,7 @@
 #include <functional>
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <folly/functional/ApplyTuple.h>
 
@@ -65,6 +66,7 @@ class NodeMapDelta {
   using MapPointerType = typename MAPPOINTERTRAITS::MapPointerType;
   using RawConstPointerType = typename MAPPOINTERTRAITS::RawConstPointerType;
   using Node = typename MAP::Node;
+  using KeyType = typename MAP::KeyType;
   class Iterator;
 
   NodeMapDelta(MapPointerType&& oldMap, MapPointerType&& newMap)
@@ -88,6 +90,13 @@ class NodeMapDelta {
   Iterator end() const;
 
  private:
+  /*
+   * Keys that may differ between the two maps, if the new map knows how it
+   * was derived from the old one. Computed on first use, nullptr if the maps
+   * need to be compared in full.
+   */
+  const std::shared_ptr<const std::vector<KeyType>>& getChangedKeys() const;
+
   /*
    * NodeMapDelta is used by StateDelta.  StateDelta holds a shared_ptr to
    * the old and new SwitchState objects, which in turn holds
@@ -100,6 +109,8 @@ class NodeMapDelta {
    */
   MapPointerType old_;
   MapPointerType new_;
+  mutable std::shared_ptr<const std::vector<KeyType>> changedKeys_;
+  mutable bool changedKeysComputed_{false};
 };
 
 template <typename NODE>
@@ -151,11 +162,21 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   using pointer = VALUE*;
   using reference = VALUE&;
 
+  using KeyType = typename MAP::KeyType;
+
   Iterator(
       const MapType* oldMap,
       typename MapType::Iterator oldIt,
       const MapType* newMap,
       typename MapType::Iterator newIt);
+  /*
+   * Walk only the given keys, rather than both maps in full.
+   */
+  Iterator(
+      const MapType* oldMap,
+      const MapType* newMap,
+      std::shared_ptr<const std::vector<KeyType>> changedKeys,
+      size_t changedKeyIdx);
   Iterator();
 
   const value_type& operator*() const {
@@ -176,7 +197,8 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
   }
 
   bool operator==(const Iterator& other) const {
-    return oldIt_ == other.oldIt_ && newIt_ == other.newIt_;
+    return oldIt_ == other.oldIt_ && newIt_ == other.newIt_ &&
+        changedKeyIdx_ == other.changedKeyIdx_;
   }
   bool operator!=(const Iterator& other) const {
     return !operator==(other);
@@ -188,11 +210,18 @@ class NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::Iterator {
 
   void advance();
   void updateValue();
+  void skipUnchangedKeys();
+  static const std::shared_ptr<Node>& findNode(
+      const MapType* map,
+      const KeyType& key);
 
   InnerIter oldIt_{nullptr};
   InnerIter newIt_{nullptr};
   const MapType* oldMap_{nullptr};
   const MapType* newMap_{nullptr};
+  // Only set when walking the keys from the new map's change journal
+  std::shared_ptr<const std::vector<KeyType>> changedKeys_;
+  size_t changedKeyIdx_{0};
   VALUE value_;
 
   static std::shared_ptr<Node> nullNode_;
@@ -214,6 +243,9 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::begin() const {
   if (!new_) {
     return Iterator(getOld(), old_->begin(), getOld(), old_->end());
   }
+  if (const auto& changedKeys = getChangedKeys()) {
+    return Iterator(getOld(), getNew(), changedKeys, 0);
+  }
   return Iterator(getOld(), old_->begin(), getNew(), new_->begin());
 }
 
@@ -226,7 +258,26 @@ NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::end() const {
   if (!new_) {
     return Iterator(getOld(), old_->end(), getOld(), old_->end());
   }
+  if (const auto& changedKeys = getChangedKeys()) {
+    return Iterator(getOld(), getNew(), changedKeys, changedKeys->size());
+  }
   return Iterator(getOld(), old_->end(), getNew(), new_->end());
 }
 
+template <typename MAP, typename VALUE, typename MAPPOINTERTRAITS>
+const std::shared_ptr<const std::vector<typename MAP::KeyType>>&
+NodeMapDelta<MAP, VALUE, MAPPOINTERTRAITS>::getChangedKeys() const {
+  if (!changedKeysComputed_) {
+    changedKeysComputed_ = true;
+    if (old_ && new_ && old_ != new_) {
+      auto changedKeys = getNew()->changedKeysSince(*getOld());
+      if (changedKeys) {
+        changedKeys_ = std::make_shared<const std::vector<KeyType>>(
+            std::move(*changedKeys));
+      }
+    }
+  }
+  return changedKeys_;
+}
+
 } // namespace facebook::fboss
@@ -0,0 +1,559 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * PersistentBTreeMap is a sorted map with structural sharing, meant as a
+ * NodeContainer for NodeMapT instances holding many nodes (routes, neighbor
+ * and MAC entries).
+ *
+ * With the default flat_map container, cloning a NodeMap copies every
+ * shared_ptr in the map, making each copy-on-write update O(n). Copying a
+ * PersistentBTreeMap only copies the root pointer. Modifying the copy then
+ * copies just the B+tree nodes on the path to the modified entry, which
+ * leaves the cost of an update at O(log n), and lets the old and new versions
+ * share everything else.
+ *
+ * The interface mirrors the subset of boost::container::flat_map that
+ * NodeMapT and its users rely on. Iterators are read only, since writing
+ * through an iterator could modify a tree node shared with other copies.
+ * Entries are modified through insert(), erase() and operator[] instead,
+ * which copy shared tree nodes before modifying them.
+ *
+ * A tree node whose shared_ptr is unique belongs to this copy alone and is
+ * modified in place, so building up a map with a sequence of inserts does not
+ * keep copying nodes.
+ *
+ * Like other state containers, a PersistentBTreeMap may be read concurrently
+ * from multiple threads, but must only be modified by one thread.
+ */
+template <typename KeyT, typename ValueT, size_t kMaxEntries = 32>
+class PersistentBTreeMap {
+ private:
+  struct TreeNode;
+
+ public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = std::pair<KeyT, ValueT>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  class const_iterator;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  static_assert(kMaxEntries >= 4, "B+tree nodes need room for a few entries");
+
+  PersistentBTreeMap() = default;
+
+  const_iterator begin() const {
+    const_iterator it(root_.get());
+    it.descendFirst(root_.get());
+    return it;
+  }
+  const_iterator end() const {
+    return const_iterator(root_.get());
+  }
+  const_iterator cbegin() const {
+    return begin();
+  }
+  const_iterator cend() const {
+    return end();
+  }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  const_iterator find(const KeyT& key) const {
+    auto it = lower_bound(key);
+    if (it != end() && !(key < it->first)) {
+      return it;
+    }
+    return end();
+  }
+
+  size_type count(const KeyT& key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  /*
+   * First entry whose key is not less than the given key.
+   */
+  const_iterator lower_bound(const KeyT& key) const {
+    const_iterator it(root_.get());
+    const TreeNode* node = root_.get();
+    if (!node) {
+      return it;
+    }
+    while (!node->isLeaf()) {
+      auto idx = node->childIndex(key);
+      it.push(node, idx);
+      node = node->children[idx].get();
+    }
+    auto pos = std::lower_bound(
+        node->entries.begin(),
+        node->entries.end(),
+        key,
+        [](const value_type& entry, const KeyT& k) { return entry.first < k; });
+    it.push(node, pos - node->entries.begin());
+    if (pos == node->entries.end()) {
+      // Ran off the end of this leaf, the next entry is in the next one
+      it.nextLeaf();
+    }
+    return it;
+  }
+
+  std::pair<const_iterator, bool> insert(value_type value) {
+    auto it = find(value.first);
+    if (it != end()) {
+      return std::make_pair(it, false);
+    }
+    auto key = value.first;
+    insertNew(std::move(value));
+    return std::make_pair(find(key), true);
+  }
+
+  template <typename... Args>
+  std::pair<const_iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  /*
+   * The hint is ignored, the tree is always searched from the root.
+   */
+  template <typename... Args>
+  const_iterator emplace_hint(const_iterator /*hint*/, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  /*
+   * Reference to the value for the given key, default constructing it if
+   * missing. Copies any tree node on the way that is shared with another
+   * map, so the reference can be written to. Like for flat_map, it is
+   * invalidated by the next modification to the map.
+   */
+  ValueT& operator[](const KeyT& key) {
+    if (find(key) == end()) {
+      insertNew(value_type(key, ValueT()));
+    }
+    std::shared_ptr<TreeNode>* node = &root_;
+    while (true) {
+      makeUnique(*node);
+      if ((*node)->isLeaf()) {
+        auto pos = (*node)->entryIndex(key);
+        return (*node)->entries[pos].second;
+      }
+      node = &(*node)->children[(*node)->childIndex(key)];
+    }
+  }
+
+  size_type erase(const KeyT& key) {
+    if (find(key) == end()) {
+      return 0;
+    }
+    makeUnique(root_);
+    eraseFrom(root_.get(), key);
+    --size_;
+    if (root_->isLeaf() ? root_->entries.empty() : root_->children.empty()) {
+      root_.reset();
+    } else if (!root_->isLeaf() && root_->children.size() == 1) {
+      // Shrink the tree when the root is left with a single child
+      root_ = root_->children.front();
+    }
+    return 1;
+  }
+
+  /*
+   * Erase the entry at pos, returning an iterator to the entry after it.
+   */
+  const_iterator erase(const_iterator pos) {
+    auto key = pos->first;
+    erase(key);
+    return lower_bound(key);
+  }
+
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+  /*
+   * Call fn on the value of each entry in a tree node not yet sealed by
+   * an earlier call, then seal those tree nodes.
+   *
+   * Modifying a map unseals the tree nodes it touches, which are the ones
+   * copied from other maps on the way. So once a map is sealed, a copy of
+   * it only visits the entries on the paths it has modified since, which is
+   * O(changes * log n) rather than O(n). NodeMapT uses this to publish just
+   * the nodes a cloned map does not share with the map it was cloned from.
+   */
+  template <typename Fn>
+  void sealNewEntries(Fn fn) {
+    sealFrom(root_.get(), fn);
+  }
+
+  class const_iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = PersistentBTreeMap::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+
+    reference operator*() const {
+      return leaf().node->entries[leaf().idx];
+    }
+    pointer operator->() const {
+      return &operator*();
+    }
+
+    const_iterator& operator++() {
+      DCHECK_GT(depth_, 0);
+      if (++leaf().idx >= leaf().node->entries.size()) {
+        nextLeaf();
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    const_iterator& operator--() {
+      if (depth_ == 0) {
+        // Decrementing end() lands on the last entry
+        descendLast(root_);
+        return *this;
+      }
+      if (leaf().idx > 0) {
+        --leaf().idx;
+        return *this;
+      }
+      // Back up to the closest ancestor with a child before the one we came
+      // down through, and descend to the last entry under that child.
+      --depth_;
+      while (depth_ > 0 && frames_[depth_ - 1].idx == 0) {
+        --depth_;
+      }
+      DCHECK_GT(depth_, 0) << "decrementing begin()";
+      auto& frame = frames_[depth_ - 1];
+      --frame.idx;
+      descendLast(frame.node->children[frame.idx].get());
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator tmp(*this);
+      --*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      if (depth_ == 0 || other.depth_ == 0) {
+        return depth_ == other.depth_;
+      }
+      return leaf().node == other.leaf().node && leaf().idx == other.leaf().idx;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return !operator==(other);
+    }
+
+   private:
+    friend class PersistentBTreeMap;
+
+    // Nodes are at least half full when split, so the tree grows a level
+    // for every kMaxEntries / 2 fold increase in size. This is deep enough
+    // for anything that fits in memory.
+    static constexpr size_t kMaxDepth = kMaxEntries >= 16 ? 16 : 64;
+
+    struct Frame {
+      const TreeNode* node;
+      size_t idx;
+    };
+
+    explicit const_iterator(const TreeNode* root) : root_(root) {}
+
+    Frame& leaf() {
+      return frames_[depth_ - 1];
+    }
+    const Frame& leaf() const {
+      return frames_[depth_ - 1];
+    }
+
+    void push(const TreeNode* node, size_t idx) {
+      CHECK_LT(depth_, kMaxDepth);
+      frames_[depth_++] = Frame{node, idx};
+    }
+
+    void descendFirst(const TreeNode* node) {
+      if (!node) {
+        return;
+      }
+      while (!node->isLeaf()) {
+        push(node, 0);
+        node = node->children.front().get();
+      }
+      push(node, 0);
+    }
+
+    void descendLast(const TreeNode* node) {
+      while (!node->isLeaf()) {
+        push(node, node->children.size() - 1);
+        node = node->children.back().get();
+      }
+      push(node, node->entries.size() - 1);
+    }
+
+    /*
+     * Move to the first entry of the leaf after the current one, or to end().
+     */
+    void nextLeaf() {
+      --depth_;
+      while (depth_ > 0) {
+        auto& frame = frames_[depth_ - 1];
+        if (++frame.idx < frame.node->children.size()) {
+          descendFirst(frame.node->children[frame.idx].get());
+          return;
+        }
+        --depth_;
+      }
+    }
+
+    const TreeNode* root_{nullptr};
+    std::array<Frame, kMaxDepth> frames_{};
+    size_t depth_{0};
+  };
+
+ private:
+  /*
+   * Leaves hold the entries. Internal nodes hold children, and keys[i]
+   * separates children[i] from children[i + 1]: every key under children[i]
+   * is less than keys[i], which is no greater than any key under
+   * children[i + 1].
+   */
+  struct TreeNode {
+    bool isLeaf() const {
+      return children.empty();
+    }
+    size_t size() const {
+      return isLeaf() ? entries.size() : children.size();
+    }
+    size_t childIndex(const KeyT& key) const {
+      return std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+    }
+    size_t entryIndex(const KeyT& key) const {
+      return std::lower_bound(
+                 entries.begin(),
+                 entries.end(),
+                 key,
+                 [](const value_type& entry, const KeyT& k) {
+                   return entry.first < k;
+                 }) -
+          entries.begin();
+    }
+
+    std::vector<value_type> entries;
+    std::vector<KeyT> keys;
+    std::vector<std::shared_ptr<TreeNode>> children;
+    // Set by sealNewEntries() once fn has seen every entry below this node
+    bool sealed{false};
+  };
+
+  struct Split {
+    KeyT key;
+    std::shared_ptr<TreeNode> right;
+  };
+
+  /*
+   * Copy the node if it is shared with another map. A node we hold the only
+   * reference to can't be reachable from any other map, so it is safe to
+   * modify in place. Either way the node is about to change, so it is
+   * unsealed for the next sealNewEntries() to visit.
+   */
+  static void makeUnique(std::shared_ptr<TreeNode>& node) {
+    if (node.use_count() > 1) {
+      node = std::make_shared<TreeNode>(*node);
+    }
+    node->sealed = false;
+  }
+
+  template <typename Fn>
+  static void sealFrom(TreeNode* node, Fn& fn) {
+    if (!node || node->sealed) {
+      return;
+    }
+    if (node->isLeaf()) {
+      for (const auto& entry : node->entries) {
+        fn(entry.second);
+      }
+    } else {
+      for (const auto& child : node->children) {
+        sealFrom(child.get(), fn);
+      }
+    }
+    node->sealed = true;
+  }
+
+  void insertNew(value_type value) {
+    if (!root_) {
+      root_ = std::make_shared<TreeNode>();
+    }
+    makeUnique(root_);
+    auto split = insertInto(root_.get(), std::move(value));
+    if (split.right) {
+      auto newRoot = std::make_shared<TreeNode>();
+      newRoot->keys.push_back(std::move(split.key));
+      newRoot->children.push_back(std::move(root_));
+      newRoot->children.push_back(std::move(split.right));
+      root_ = std::move(newRoot);
+    }
+    ++size_;
+  }
+
+  /*
+   * Insert into a node we already made unique, returning the new right
+   * sibling if the node had to be split.
+   */
+  static Split insertInto(TreeNode* node, value_type value) {
+    if (node->isLeaf()) {
+      auto pos = node->entryIndex(value.first);
+      node->entries.insert(node->entries.begin() + pos, std::move(value));
+      if (node->entries.size() <= kMaxEntries) {
+        return Split{KeyT(), nullptr};
+      }
+      auto right = std::make_shared<TreeNode>();
+      auto mid = node->entries.begin() + node->entries.size() / 2;
+      right->entries.assign(
+          std::make_move_iterator(mid),
+          std::make_move_iterator(node->entries.end()));
+      node->entries.erase(mid, node->entries.end());
+      return Split{right->entries.front().first, std::move(right)};
+    }
+
+    auto idx = node->childIndex(value.first);
+    makeUnique(node->children[idx]);
+    auto split = insertInto(node->children[idx].get(), std::move(value));
+    if (!split.right) {
+      return split;
+    }
+    node->keys.insert(node->keys.begin() + idx, std::move(split.key));
+    node->children.insert(
+        node->children.begin() + idx + 1, std::move(split.right));
+    if (node->children.size() <= kMaxEntries) {
+      return Split{KeyT(), nullptr};
+    }
+    // Split the internal node, moving the middle key up to the parent
+    auto right = std::make_shared<TreeNode>();
+    auto midChild = node->children.size() / 2;
+    auto upKey = std::move(node->keys[midChild - 1]);
+    right->keys.assign(
+        std::make_move_iterator(node->keys.begin() + midChild),
+        std::make_move_iterator(node->keys.end()));
+    right->children.assign(
+        std::make_move_iterator(node->children.begin() + midChild),
+        std::make_move_iterator(node->children.end()));
+    node->keys.erase(node->keys.begin() + midChild - 1, node->keys.end());
+    node->children.erase(
+        node->children.begin() + midChild, node->children.end());
+    return Split{std::move(upKey), std::move(right)};
+  }
+
+  /*
+   * Erase a key known to be present from a node we already made unique.
+   * Children left empty are removed, and children left sparse are merged
+   * with a sibling when they fit in a single node.
+   */
+  static void eraseFrom(TreeNode* node, const KeyT& key) {
+    if (node->isLeaf()) {
+      node->entries.erase(node->entries.begin() + node->entryIndex(key));
+      return;
+    }
+    auto idx = node->childIndex(key);
+    makeUnique(node->children[idx]);
+    auto child = node->children[idx].get();
+    eraseFrom(child, key);
+
+    if (child->size() == 0) {
+      node->children.erase(node->children.begin() + idx);
+      if (!node->keys.empty()) {
+        node->keys.erase(node->keys.begin() + (idx > 0 ? idx - 1 : 0));
+      }
+      return;
+    }
+    if (child->size() >= kMaxEntries / 4 || node->children.size() < 2) {
+      return;
+    }
+    // Merge the sparse child with one of its siblings, if they fit together
+    auto left = idx > 0 ? idx - 1 : idx;
+    auto right = left + 1;
+    auto& leftChild = node->children[left];
+    auto& rightChild = node->children[right];
+    if (leftChild->size() + rightChild->size() > kMaxEntries) {
+      return;
+    }
+    makeUnique(leftChild);
+    if (leftChild->isLeaf()) {
+      leftChild->entries.insert(
+          leftChild->entries.end(),
+          rightChild->entries.begin(),
+          rightChild->entries.end());
+    } else {
+      leftChild->keys.push_back(node->keys[left]);
+      leftChild->keys.insert(
+          leftChild->keys.end(),
+          rightChild->keys.begin(),
+          rightChild->keys.end());
+      leftChild->children.insert(
+          leftChild->children.end(),
+          rightChild->children.begin(),
+          rightChild->children.end());
+    }
+    node->keys.erase(node->keys.begin() + left);
+    node->children.erase(node->children.begin() + right);
+  }
+
+  std::shared_ptr<TreeNode> root_;
+  size_t size_{0};
+};
+
+template <typename T>
+struct IsPersistentBTreeMap : std::false_type {};
+
+template <typename KeyT, typename ValueT, size_t kMaxEntries>
+struct IsPersistentBTreeMap<PersistentBTreeMap<KeyT, ValueT, kMaxEntries>>
+    : std::true_type {};
+
+} // namespace facebook::fboss
@@ -12,9 +12,11 @@
 #include <boost/container/flat_set.hpp>
 
 #include <folly/dynamic.h>
+#include <folly/hash/Hash.h>
 
 #include "fboss/agent/state/RouteNextHop.h"
 #include "fboss/agent/state/RouteTypes.h"
+#include "fboss/lib/Interner.h"
 
 DECLARE_uint32(ecmp_width);
 
@@ -25,6 +27,18 @@ class RouteNextHopEntry {
   using Action = RouteForwardAction;
   using NextHopSet = boost::container::flat_set<NextHop>;
 
+  // Hashes the addresses and weights of the next hops, for the Interner
+  struct NextHopSetHash {
+    size_t operator()(const NextHopSet& nhops) const {
+      size_t hash = nhops.size();
+      for (const auto& nhop : nhops) {
+        hash = folly::hash::hash_combine(hash, nhop.addr(), nhop.weight());
+      }
+      return hash;
+    }
+  };
+  using NextHopSetInterner = Interner<NextHopSet, NextHopSetHash>;
+
   RouteNextHopEntry(Action action, AdminDistance distance)
       : adminDistance_(distance), action_(action) {
     CHECK_NE(action_, Action::NEXTHOPS);
@@ -32,11 +46,36 @@ class RouteNextHopEntry {
 
   RouteNextHopEntry(NextHopSet nhopSet, AdminDistance distance);
 
+  /*
+   * nhopSet must be interned, i.e. from getSharedNextHopSet(), as entries
+   * compare next hop sets by address. Checking that takes an Interner
+   * lookup, which this constructor is there to avoid, so only debug builds
+   * do.
+   */
+  RouteNextHopEntry(
+      std::shared_ptr<const NextHopSet> nhopSet,
+      AdminDistance distance)
+      : adminDistance_(distance),
+        action_(Action::NEXTHOPS),
+        nhopSet_(std::move(nhopSet)) {
+    CHECK(!nhopSet_->empty());
+    DCHECK(NextHopSetInterner::isInterned(nhopSet_));
+  }
+
   RouteNextHopEntry(NextHop nhop, AdminDistance distance)
       : adminDistance_(distance), action_(Action::NEXTHOPS) {
-    nhopSet_.emplace(std::move(nhop));
+    NextHopSet nhopSet;
+    nhopSet.emplace(std::move(nhop));
+    nhopSet_ = NextHopSetInterner::intern(std::move(nhopSet));
   }
 
+  /*
+   * Copied rather than moved from, even by a move, so that a moved from
+   * entry still has a next hop set.
+   */
+  RouteNextHopEntry(const RouteNextHopEntry&) = default;
+  RouteNextHopEntry& operator=(const RouteNextHopEntry&) = default;
+
   AdminDistance getAdminDistance() const {
     return adminDistance_;
   }
@@ -46,6 +85,14 @@ class RouteNextHopEntry {
   }
 
   const NextHopSet& getNextHopSet() const {
+    return *nhopSet_;
+  }
+
+  /*
+   * Next hop sets are interned: all entries with equal next hops share the
+   * same NextHopSet, so the set can be compared, or keyed on, by address.
+   */
+  const std::shared_ptr<const NextHopSet>& getSharedNextHopSet() const {
     return nhopSet_;
   }
 
@@ -79,7 +126,7 @@ class RouteNextHopEntry {
 
   // Reset the NextHopSet
   void reset() {
-    nhopSet_.clear();
+    nhopSet_ = NextHopSetInterner::defaultValue();
     action_ = Action::DROP;
   }
 
@@ -88,7 +135,8 @@ class RouteNextHopEntry {
  private:
   AdminDistance adminDistance_;
   Action action_{Action::DROP};
-  NextHopSet nhopSet_;
+  std::shared_ptr<const NextHopSet> nhopSet_{
+      NextHopSetInterner::defaultValue()};
 };
 
 /**
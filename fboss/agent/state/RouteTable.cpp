@@ -32,6 +32,17 @@ folly::dynamic RouteTableFields::toFollyDynamic() const {
   return rtable;
 }
 
+void RouteTableFields::writeTo(StreamingStateWriter& writer) const {
+  writer.beginObject();
+  writer.key(kRouterId);
+  writer.value(static_cast<uint32_t>(id));
+  writer.key(kRibV4);
+  ribV4->writeTo(writer);
+  writer.key(kRibV6);
+  ribV6->writeTo(writer);
+  writer.endObject();
+}
+
 RouteTable* RouteTable::modify(std::shared_ptr<SwitchState>* state) {
   if (!isPublished()) {
     return this;
@@ -29,9 +29,10 @@ struct RouteTableFields {
     fn(ribV6.get());
   }
   /*
-   * Serialize to folly::dynamic
+   * Serialize to folly::dynamic, or stream the same JSON to writer
    */
   folly::dynamic toFollyDynamic() const;
+  void writeTo(StreamingStateWriter& writer) const;
   /*
    * Deserialize from folly::dynamic
    */
@@ -66,6 +67,10 @@ class RouteTable : public NodeBaseT<RouteTable, RouteTableFields> {
     return this->getFields()->toFollyDynamic();
   }
 
+  void writeTo(StreamingStateWriter& writer) const override {
+    this->getFields()->writeTo(writer);
+  }
+
   RouterID getID() const {
     return getFields()->id;
   }
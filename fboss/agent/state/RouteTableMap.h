@@ -63,6 +63,10 @@ class RouteTableMap : public NodeMapT<RouteTableMap, RouteTableMapTraits> {
 
   void removeRouteTable(const std::shared_ptr<RouteTable>& rt);
 
+  void writeTo(StreamingStateWriter& writer) const override {
+    writeNodeMapTo(writer);
+  }
+
  private:
   // Inherit the constructors required for clone()
   using NodeMapT::NodeMapT;
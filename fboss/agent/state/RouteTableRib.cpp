@@ -56,16 +56,32 @@ folly::dynamic RouteTableRib<AddrT>::toFollyDynamic() const {
   return routes;
 }
 
+template <typename AddrT>
+void RouteTableRib<AddrT>::writeTo(StreamingStateWriter& writer) const {
+  writer.beginObject();
+  writer.key(kRoutes);
+  writer.beginArray();
+  for (const auto& route : *nodeMap_) {
+    route->writeTo(writer);
+  }
+  writer.endArray();
+  writer.endObject();
+}
+
 template <typename AddrT>
 std::shared_ptr<RouteTableRib<AddrT>> RouteTableRib<AddrT>::fromFollyDynamic(
     const folly::dynamic& routes) {
   auto rib = std::make_shared<RouteTableRib<AddrT>>();
-  auto routesJson = routes[kRoutes];
+  const auto& routesJson = routes[kRoutes];
+  RadixTreeEntries entries;
+  entries.reserve(routesJson.size());
   for (const auto& routeJson : routesJson) {
     auto route = Route<AddrT>::fromFollyDynamic(routeJson);
     rib->addRoute(route);
-    rib->addRouteInRadixTree(route);
+    entries.emplace_back(route->prefix().network, route->prefix().mask, route);
   }
+  rib->radixTree_.bulkInsert(std::move(entries));
+  CHECK_EQ(rib->size(), rib->radixTree_.size());
   return rib;
 }
 
@@ -88,10 +104,12 @@ RouteTableRib<AddrT>* RouteTableRib<AddrT>::modify(
   // modify() is that we have a cloned RouteTableRib return if the current one
   // is published. To make sure the cloned RouteTableRib works, we need to
   // ensure radixTree_ and nodeMap_ in sync before we return a newly cloned rib.
+  RadixTreeEntries entries;
+  entries.reserve(size());
   for (const auto& node : nodeMap_->getAllNodes()) {
-    clonedRib->radixTree_.insert(
-        node.first.network, node.first.mask, node.second);
+    entries.emplace_back(node.first.network, node.first.mask, node.second);
   }
+  clonedRib->radixTree_.bulkInsert(std::move(entries));
   CHECK_EQ(clonedRib->size(), clonedRib->radixTree_.size());
 
   auto clonedRibPtr = clonedRib.get();
@@ -16,6 +16,9 @@
 #include "fboss/agent/types.h"
 #include "fboss/lib/RadixTree.h"
 
+#include <tuple>
+#include <vector>
+
 namespace facebook::fboss {
 
 template <typename AddrT>
@@ -79,6 +82,8 @@ class RouteTableRib : public NodeBase {
   using RouteType = Route<AddrT>;
   using RoutesRadixTree =
       facebook::network::RadixTree<AddrT, std::shared_ptr<Route<AddrT>>>;
+  using RadixTreeEntries = std::vector<
+      std::tuple<AddrT, uint8_t, std::shared_ptr<Route<AddrT>>>>;
 
   bool empty() const {
     return nodeMap_->empty();
@@ -126,6 +131,11 @@ class RouteTableRib : public NodeBase {
    */
   folly::dynamic toFollyDynamic() const;
 
+  /*
+   * Write the toFollyDynamic() JSON to writer, one route at a time
+   */
+  void writeTo(StreamingStateWriter& writer) const;
+
   /*
    * Deserialize from folly::dynamic
    */
@@ -156,14 +166,17 @@ class RouteTableRib : public NodeBase {
     // We should expect this function is called only before we publish the rib
     CHECK(!isPublished());
     radixTree_.clear();
+    RadixTreeEntries entries;
+    entries.reserve(size());
     for (const auto& node : nodeMap_->getAllNodes()) {
       auto route = node.second;
       if (route->isPublished()) {
         route = route->clone(RouteType::Fields::COPY_PREFIX_AND_NEXTHOPS);
       }
       route->clearForward();
-      radixTree_.insert(node.first.network, node.first.mask, route);
+      entries.emplace_back(node.first.network, node.first.mask, route);
     }
+    radixTree_.bulkInsert(std::move(entries));
     CHECK_EQ(size(), radixTree_.size());
   }
 
@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <memory>
 
 #include <folly/FBString.h>
@@ -32,8 +33,28 @@ class SwitchState;
  */
 class StateUpdate {
  public:
-  explicit StateUpdate(folly::StringPiece name, bool allowCoalesce = true)
-      : name_(name.str()), allowCoalesce_(allowCoalesce) {}
+  /*
+   * Pending updates are queued in one lane per priority.  The update thread
+   * always serves the highest priority lane that has updates pending, so that
+   * e.g. a port going down does not wait behind a large route update.
+   * Updates within a lane are applied in the order they were scheduled, but
+   * updates from different lanes are never coalesced together.
+   */
+  enum class Priority : uint8_t {
+    // Link state and neighbor resolution
+    HIGH = 0,
+    // Config and everything else
+    NORMAL = 1,
+    // Bulk route programming
+    LOW = 2,
+  };
+  static constexpr size_t kNumPriorities = 3;
+
+  explicit StateUpdate(
+      folly::StringPiece name,
+      bool allowCoalesce = true,
+      Priority priority = Priority::NORMAL)
+      : name_(name.str()), allowCoalesce_(allowCoalesce), priority_(priority) {}
   virtual ~StateUpdate() {}
 
   const std::string& getName() const {
@@ -44,6 +65,10 @@ class StateUpdate {
     return allowCoalesce_;
   }
 
+  Priority getPriority() const {
+    return priority_;
+  }
+
   /*
    * Apply the update, and return a new SwitchState.
    *
@@ -84,6 +109,9 @@ class StateUpdate {
 
   std::string name_;
   bool allowCoalesce_;
+  Priority priority_;
+  // When the update got queued, set by SwSwitch
+  std::chrono::steady_clock::time_point enqueueTime_;
 
   // An intrusive list hook for maintaining the list of pending updates.
   folly::IntrusiveListHook listHook_;
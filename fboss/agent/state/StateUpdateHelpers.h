@@ -32,8 +32,9 @@ class FunctionStateUpdate : public StateUpdate {
   FunctionStateUpdate(
       folly::StringPiece name,
       StateUpdateFn fn,
-      bool allowCoalesce = true)
-      : StateUpdate(name, allowCoalesce), function_(fn) {}
+      bool allowCoalesce = true,
+      Priority priority = Priority::NORMAL)
+      : StateUpdate(name, allowCoalesce, priority), function_(fn) {}
 
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& origState) override {
@@ -104,8 +105,11 @@ class BlockingStateUpdate : public StateUpdate {
       folly::StringPiece name,
       StateUpdateFn fn,
       std::shared_ptr<BlockingUpdateResult> result,
-      bool allowCoalesce = true)
-      : StateUpdate(name, allowCoalesce), function_(fn), result_(result) {}
+      bool allowCoalesce = true,
+      Priority priority = Priority::NORMAL)
+      : StateUpdate(name, allowCoalesce, priority),
+        function_(fn),
+        result_(result) {}
 
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& origState) override {
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/StreamingStateWriter.h"
+
+#include <folly/FileUtil.h>
+#include <folly/json.h>
+#include <folly/logging/xlog.h>
+#include <glog/logging.h>
+
+#include <fcntl.h>
+
+namespace facebook::fboss {
+
+StreamingStateWriter::StreamingStateWriter(const std::string& filename) {
+  fd_ = folly::openNoInt(
+      filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    XLOG(ERR) << "Unable to open " << filename << " for writing: " << errno;
+    ok_ = false;
+  }
+  buffer_.reserve(kChunkSize);
+}
+
+StreamingStateWriter::~StreamingStateWriter() {
+  if (fd_ >= 0) {
+    folly::closeNoInt(fd_);
+  }
+}
+
+void StreamingStateWriter::beginObject() {
+  separate();
+  append("{");
+  firstMember_.push_back(true);
+}
+
+void StreamingStateWriter::endObject() {
+  DCHECK(!firstMember_.empty());
+  firstMember_.pop_back();
+  append("}");
+}
+
+void StreamingStateWriter::beginArray() {
+  separate();
+  append("[");
+  firstMember_.push_back(true);
+}
+
+void StreamingStateWriter::endArray() {
+  DCHECK(!firstMember_.empty());
+  firstMember_.pop_back();
+  append("]");
+}
+
+void StreamingStateWriter::key(folly::StringPiece name) {
+  separate();
+  append(folly::toJson(folly::dynamic(name)));
+  append(":");
+  afterKey_ = true;
+}
+
+void StreamingStateWriter::value(const folly::dynamic& value) {
+  separate();
+  append(folly::toJson(value));
+}
+
+void StreamingStateWriter::separate() {
+  if (afterKey_) {
+    afterKey_ = false;
+    return;
+  }
+  if (firstMember_.empty()) {
+    return;
+  }
+  if (firstMember_.back()) {
+    firstMember_.back() = false;
+  } else {
+    append(",");
+  }
+}
+
+void StreamingStateWriter::append(folly::StringPiece data) {
+  buffer_.append(data.data(), data.size());
+  if (buffer_.size() >= kChunkSize) {
+    flush();
+  }
+}
+
+void StreamingStateWriter::flush() {
+  if (ok_ && !buffer_.empty()) {
+    auto written = folly::writeFull(fd_, buffer_.data(), buffer_.size());
+    if (written < 0) {
+      XLOG(ERR) << "Error writing switch state: " << errno;
+      ok_ = false;
+    } else {
+      bytesWritten_ += written;
+    }
+  }
+  buffer_.clear();
+}
+
+bool StreamingStateWriter::finish() {
+  DCHECK(firstMember_.empty()) << "unterminated object or array";
+  flush();
+  if (fd_ >= 0) {
+    if (folly::closeNoInt(fd_) < 0) {
+      ok_ = false;
+    }
+    fd_ = -1;
+  }
+  return ok_;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/dynamic.h>
+
+#include <string>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * StreamingStateWriter writes switch state out to a file as JSON, one piece
+ * at a time.
+ *
+ * Serializing a SwitchState through toFollyDynamic() builds a folly::dynamic
+ * for the whole tree, and then the whole JSON string, before anything is
+ * written. With a full route table that is a lot of memory to allocate on
+ * the way out of the agent. Nodes instead call writeTo() on their children,
+ * which ends up emitting one small folly::dynamic per leaf node (a route, a
+ * port, ...). Output is buffered and written out every kChunkSize bytes, so
+ * memory use is bounded by the largest leaf rather than the whole state.
+ *
+ * The output parses to the same folly::dynamic that toFollyDynamic() would
+ * produce, and can be read back with the usual fromFollyDynamic() functions.
+ * It is not the same text as serializeState() writes: the JSON is compact
+ * rather than pretty printed, and object keys come in the order the nodes
+ * write them.
+ *
+ * Write errors are sticky, and reported by finish().
+ */
+class StreamingStateWriter {
+ public:
+  static constexpr size_t kChunkSize = 1 << 20;
+
+  explicit StreamingStateWriter(const std::string& filename);
+  ~StreamingStateWriter();
+
+  void beginObject();
+  void endObject();
+  void beginArray();
+  void endArray();
+
+  /*
+   * Key of the next value in the current object.
+   */
+  void key(folly::StringPiece name);
+
+  /*
+   * Write a complete value, either an array element or the value of the
+   * last key().
+   */
+  void value(const folly::dynamic& value);
+
+  /*
+   * Flush any buffered output and close the file. Returns false if anything
+   * failed to be written.
+   */
+  bool finish();
+
+  size_t bytesWritten() const {
+    return bytesWritten_;
+  }
+
+ private:
+  // Forbidden copy constructor and assignment operator
+  StreamingStateWriter(StreamingStateWriter const&) = delete;
+  StreamingStateWriter& operator=(StreamingStateWriter const&) = delete;
+
+  void separate();
+  void append(folly::StringPiece data);
+  void flush();
+
+  int fd_{-1};
+  bool ok_{true};
+  size_t bytesWritten_{0};
+  std::string buffer_;
+  // One entry per open object/array, true until its first member is written
+  std::vector<bool> firstMember_;
+  // Set by key(), so the value that follows does not get a separator
+  bool afterKey_{false};
+};
+
+} // namespace facebook::fboss
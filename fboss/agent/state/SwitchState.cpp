@@ -9,6 +9,7 @@
  */
 #include "fboss/agent/state/SwitchState.h"
 
+#include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/state/AclEntry.h"
 #include "fboss/agent/state/AclMap.h"
@@ -30,6 +31,10 @@
 
 #include "fboss/agent/state/NodeBase-defs.h"
 
+#include <folly/futures/Future.h>
+
+#include <vector>
+
 using std::make_shared;
 using std::shared_ptr;
 using std::chrono::seconds;
@@ -104,15 +109,150 @@ folly::dynamic SwitchStateFields::toFollyDynamic() const {
   return switchState;
 }
 
+void SwitchStateFields::writeTo(StreamingStateWriter& writer) const {
+  // Keep in sync with toFollyDynamic() above
+  writer.beginObject();
+  writer.key(kInterfaces);
+  interfaces->writeTo(writer);
+  writer.key(kPorts);
+  ports->writeTo(writer);
+  writer.key(kVlans);
+  vlans->writeTo(writer);
+  writer.key(kRouteTables);
+  routeTables->writeTo(writer);
+  writer.key(kAcls);
+  acls->writeTo(writer);
+  writer.key(kSflowCollectors);
+  sFlowCollectors->writeTo(writer);
+  writer.key(kDefaultVlan);
+  writer.value(static_cast<uint32_t>(defaultVlan));
+  writer.key(kControlPlane);
+  controlPlane->writeTo(writer);
+  writer.key(kLoadBalancers);
+  loadBalancers->writeTo(writer);
+  writer.key(kMirrors);
+  mirrors->writeTo(writer);
+  writer.key(kAggregatePorts);
+  aggPorts->writeTo(writer);
+  writer.key(kLabelForwardingInformationBase);
+  labelFib->writeTo(writer);
+  writer.key(kSwitchSettings);
+  switchSettings->writeTo(writer);
+  if (defaultDataPlaneQosPolicy) {
+    writer.key(kDefaultDataplaneQosPolicy);
+    defaultDataPlaneQosPolicy->writeTo(writer);
+  }
+  writer.key(kQosPolicies);
+  qosPolicies->writeTo(writer);
+  writer.endObject();
+}
+
+namespace {
+
+/*
+ * Deserialization tasks run on an executor, or inline if there is none.
+ * The tasks reference the folly::dynamic being deserialized, so we always
+ * wait for all of them before returning, even if one of them failed.
+ */
+class DeserializationTasks {
+ public:
+  explicit DeserializationTasks(folly::Executor* executor)
+      : executor_(executor) {}
+  ~DeserializationTasks() {
+    if (!tasks_.empty()) {
+      folly::collectAll(std::move(tasks_)).wait();
+    }
+  }
+
+  template <typename Fn>
+  void add(Fn&& fn) {
+    if (executor_) {
+      tasks_.push_back(folly::via(executor_, std::forward<Fn>(fn)));
+    } else {
+      tasks_.push_back(folly::makeFutureWith(std::forward<Fn>(fn)));
+    }
+  }
+
+  /*
+   * Wait for all tasks, and rethrow the first failure if there was one
+   */
+  void wait() {
+    auto results = folly::collectAll(std::move(tasks_)).get();
+    tasks_.clear();
+    for (auto& result : results) {
+      result.throwIfFailed();
+    }
+  }
+
+ private:
+  folly::Executor* executor_;
+  std::vector<folly::Future<folly::Unit>> tasks_;
+};
+
+/*
+ * Deserializes each entry of a NodeMap as a separate task, and assembles
+ * the map once they are done.
+ */
+template <typename MapT>
+class NodeMapDeserializer {
+ public:
+  explicit NodeMapDeserializer(const folly::dynamic& json)
+      : json_(json), nodes_(json[kEntries].size()) {}
+
+  void addTasks(DeserializationTasks* tasks) {
+    const auto& entries = json_[kEntries];
+    for (size_t i = 0; i < entries.size(); ++i) {
+      tasks->add([this, &entries, i] {
+        nodes_[i] = MapT::Node::fromFollyDynamic(entries[i]);
+      });
+    }
+  }
+
+  /*
+   * Only call once the tasks have completed
+   */
+  std::shared_ptr<MapT> get() {
+    auto nodeMap = std::make_shared<MapT>();
+    for (auto& node : nodes_) {
+      nodeMap->addNode(std::move(node));
+    }
+    nodeMap->writableExtraFields() =
+        MapT::ExtraFields::fromFollyDynamic(json_[kExtraFields]);
+    return nodeMap;
+  }
+
+ private:
+  const folly::dynamic& json_;
+  std::vector<std::shared_ptr<typename MapT::Node>> nodes_;
+};
+
+} // namespace
+
 SwitchStateFields SwitchStateFields::fromFollyDynamic(
-    const folly::dynamic& swJson) {
+    const folly::dynamic& swJson,
+    folly::Executor* executor) {
   SwitchStateFields switchState;
-  switchState.interfaces = InterfaceMap::fromFollyDynamic(swJson[kInterfaces]);
-  switchState.ports = PortMap::fromFollyDynamic(swJson[kPorts]);
-  switchState.vlans = VlanMap::fromFollyDynamic(swJson[kVlans]);
-  switchState.routeTables =
-      RouteTableMap::fromFollyDynamic(swJson[kRouteTables]);
-  switchState.acls = AclMap::fromFollyDynamic(swJson[kAcls]);
+  // The route tables and the neighbor tables in each VLAN make up most of
+  // a large state, so split those up per VRF and per VLAN.
+  NodeMapDeserializer<RouteTableMap> routeTables(swJson[kRouteTables]);
+  NodeMapDeserializer<VlanMap> vlans(swJson[kVlans]);
+  // Declared after everything the tasks write to, so that it is destroyed
+  // (and waits for them) first
+  DeserializationTasks tasks(executor);
+  routeTables.addTasks(&tasks);
+  vlans.addTasks(&tasks);
+  tasks.add([&] {
+    switchState.interfaces =
+        InterfaceMap::fromFollyDynamic(swJson[kInterfaces]);
+  });
+  tasks.add(
+      [&] { switchState.ports = PortMap::fromFollyDynamic(swJson[kPorts]); });
+  tasks.add(
+      [&] { switchState.acls = AclMap::fromFollyDynamic(swJson[kAcls]); });
+  tasks.wait();
+  switchState.routeTables = routeTables.get();
+  switchState.vlans = vlans.get();
+
   if (swJson.count(kSflowCollectors) > 0) {
     switchState.sFlowCollectors =
         SflowCollectorMap::fromFollyDynamic(swJson[kSflowCollectors]);
@@ -33,6 +33,10 @@
 #include "fboss/agent/state/VlanMap.h"
 #include "fboss/agent/types.h"
 
+namespace folly {
+class Executor;
+}
+
 namespace facebook::fboss {
 
 class ControlPlane;
@@ -68,9 +72,18 @@ struct SwitchStateFields {
    */
   folly::dynamic toFollyDynamic() const;
   /*
-   * Reconstruct object from folly::dynamic
+   * Stream the same JSON as toFollyDynamic() to writer, without building
+   * the folly::dynamic for large subtrees like the route tables
+   */
+  void writeTo(StreamingStateWriter& writer) const;
+  /*
+   * Reconstruct object from folly::dynamic. If an executor is given, the
+   * route tables (one per VRF), VLANs (with their neighbor tables), ports,
+   * interfaces and ACLs are deserialized on it in parallel.
    */
-  static SwitchStateFields fromFollyDynamic(const folly::dynamic& json);
+  static SwitchStateFields fromFollyDynamic(
+      const folly::dynamic& json,
+      folly::Executor* executor = nullptr);
   // Static state, which can be accessed without locking.
   std::shared_ptr<PortMap> ports;
   std::shared_ptr<AggregatePortMap> aggPorts;
@@ -153,8 +166,9 @@ class SwitchState : public NodeBaseT<SwitchState, SwitchStateFields> {
   ~SwitchState() override;
 
   static std::shared_ptr<SwitchState> fromFollyDynamic(
-      const folly::dynamic& json) {
-    const auto& fields = SwitchStateFields::fromFollyDynamic(json);
+      const folly::dynamic& json,
+      folly::Executor* executor = nullptr) {
+    const auto& fields = SwitchStateFields::fromFollyDynamic(json, executor);
     return std::make_shared<SwitchState>(fields);
   }
 
@@ -163,8 +177,9 @@ class SwitchState : public NodeBaseT<SwitchState, SwitchStateFields> {
   }
 
   static std::unique_ptr<SwitchState> uniquePtrFromFollyDynamic(
-      const folly::dynamic& json) {
-    const auto& fields = SwitchStateFields::fromFollyDynamic(json);
+      const folly::dynamic& json,
+      folly::Executor* executor = nullptr) {
+    const auto& fields = SwitchStateFields::fromFollyDynamic(json, executor);
     return std::make_unique<SwitchState>(fields);
   }
 
@@ -177,6 +192,10 @@ class SwitchState : public NodeBaseT<SwitchState, SwitchStateFields> {
     return getFields()->toFollyDynamic();
   }
 
+  void writeTo(StreamingStateWriter& writer) const override {
+    getFields()->writeTo(writer);
+  }
+
   static void modify(std::shared_ptr<SwitchState>* state);
 
   template <typename EntryClassT, typename NTableT>
@@ -79,6 +79,10 @@ class VlanMap : public NodeMapT<VlanMap, VlanMapTraits> {
 
   void updateVlan(const std::shared_ptr<Vlan>& vlan);
 
+  void writeTo(StreamingStateWriter& writer) const override {
+    writeNodeMapTo(writer);
+  }
+
  private:
   // Inherit the constructors required for clone()
   using NodeMapT::NodeMapT;
@@ -15,9 +15,11 @@
 
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/Range.h>
 #include <gtest/gtest.h>
 #include <array>
 #include <memory>
+#include <vector>
 
 namespace {
 
@@ -115,6 +117,51 @@ void CHECK_LPM(
   EXPECT_EQ(route->prefix().mask, mask);
 }
 
+/*
+ * Look up addresses in fib before and after publishing it, one at a time and
+ * as a batch, which must all find the same routes.
+ */
+template <typename AddressT>
+void checkPublishedLPM(
+    facebook::fboss::ForwardingInformationBase<AddressT>& fib,
+    const std::vector<AddressT>& addresses) {
+  std::vector<std::shared_ptr<facebook::fboss::Route<AddressT>>> expected;
+  for (const auto& address : addresses) {
+    expected.push_back(fib.longestMatch(address));
+  }
+  fib.publish();
+  auto batch = fib.longestMatch(folly::range(addresses));
+  ASSERT_EQ(batch.size(), addresses.size());
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    EXPECT_EQ(fib.longestMatch(addresses[i]), expected[i]) << addresses[i];
+    EXPECT_EQ(batch[i], expected[i]) << addresses[i];
+  }
+}
+
+// Addresses spread over the whole address space
+std::vector<folly::IPAddressV4> spreadAddressesV4() {
+  std::vector<folly::IPAddressV4> addresses;
+  for (uint32_t i = 0; i < 256; ++i) {
+    addresses.push_back(
+        folly::IPAddressV4::fromLongHBO((i << 24) | (i << 12) | 1));
+  }
+  return addresses;
+}
+
+std::vector<folly::IPAddressV6> spreadAddressesV6() {
+  std::vector<folly::IPAddressV6> addresses;
+  for (uint32_t i = 0; i < 256; ++i) {
+    std::array<uint8_t, 16> bytes;
+    bytes.fill(0);
+    bytes[0] = i;
+    bytes[1] = 255 - i;
+    bytes[15] = 1;
+    addresses.push_back(folly::IPAddressV6::fromBinary(
+        folly::range(bytes.begin(), bytes.end())));
+  }
+  return addresses;
+}
+
 } // namespace
 
 namespace facebook::fboss {
@@ -189,6 +236,87 @@ TEST_F(ForwardingInformationBaseV6Test, DecreasingLPMSequence) {
   }
 }
 
+TEST_F(ForwardingInformationBaseV4Test, PublishedLPM) {
+  checkPublishedLPM(fib, spreadAddressesV4());
+}
+
+TEST_F(ForwardingInformationBaseV6Test, PublishedLPM) {
+  checkPublishedLPM(fib, spreadAddressesV6());
+}
+
+TEST(ForwardingInformationBaseV6, PublishedLPMAtEveryMask) {
+  // One route every 3 bits down to a host route, and an address diverging
+  // from them at each bit
+  folly::IPAddressV6 address("FFFF:FFFF:FFFF:FFFF:FFFF:FFFF:FFFF:FFFF");
+  ForwardingInformationBaseV6 fib;
+  for (uint16_t mask = 0; mask <= address.bitCount(); mask += 3) {
+    fib.addNode(createRouteFromPrefix(address.mask(mask), mask));
+  }
+  fib.addNode(createRouteFromPrefix(address, address.bitCount()));
+
+  std::vector<folly::IPAddressV6> addresses{address};
+  auto bytes = address.toByteArray();
+  for (size_t bit = 0; bit < address.bitCount(); ++bit) {
+    auto diverging = bytes;
+    diverging[bit / 8] ^= 0x80 >> (bit % 8);
+    addresses.push_back(folly::IPAddressV6(diverging));
+  }
+  checkPublishedLPM(fib, addresses);
+}
+
+TEST(ForwardingInformationBaseV4, PublishedCloneSeesItsOwnRoutes) {
+  auto fib = std::make_shared<ForwardingInformationBaseV4>();
+  fib->addNode(createRouteFromPrefix(ip4_0, 1));
+  fib->addNode(createRouteFromPrefix(ip4_64, 3));
+  fib->publish();
+
+  folly::IPAddressV4 address("72.1.2.3");
+  CHECK_LPM(fib->longestMatch(address), ip4_64, 3);
+
+  auto newFib = fib->clone();
+  newFib->addNode(createRouteFromPrefix(ip4_72, 6));
+  newFib->removeNode(RoutePrefixV4{ip4_0, 1});
+  CHECK_LPM(newFib->longestMatch(address), ip4_72, 6);
+  newFib->publish();
+  CHECK_LPM(newFib->longestMatch(address), ip4_72, 6);
+  EXPECT_EQ(nullptr, newFib->longestMatch(folly::IPAddressV4("1.2.3.4")));
+
+  // The old version is unaffected
+  CHECK_LPM(fib->longestMatch(address), ip4_64, 3);
+  CHECK_LPM(fib->longestMatch(folly::IPAddressV4("1.2.3.4")), ip4_0, 1);
+}
+
+TEST(ForwardingInformationBaseV4, PublishedLPMAcrossGenerations) {
+  // Each generation adds routes under the previous generation's, and drops
+  // or replaces some of the older ones, so that the lookup trie carried over
+  // from the previous FIB has prefixes added, replaced and removed
+  auto addresses = spreadAddressesV4();
+  auto fib = std::make_shared<ForwardingInformationBaseV4>();
+  fib->addNode(createRouteFromPrefix(ip4_0, 0));
+  checkPublishedLPM(*fib, addresses);
+  for (uint8_t generation = 1; generation <= 8; ++generation) {
+    auto newFib = fib->clone();
+    // Few enough changes for the change journal to keep track of
+    for (uint32_t i = 0; i < 256; i += 32) {
+      uint8_t mask = generation * 3;
+      auto network = folly::IPAddressV4::fromLongHBO(i << 24).mask(mask);
+      if (!newFib->exactMatch(RoutePrefixV4{network, mask})) {
+        newFib->addNode(createRouteFromPrefix(network, mask));
+      }
+    }
+    for (const auto& prefixAndRoute : fib->getAllNodes()) {
+      const auto& prefix = prefixAndRoute.first;
+      if (prefix.mask % 2 == generation % 2) {
+        newFib->removeNode(prefix);
+      } else if (prefix.mask % 3 == generation % 3) {
+        newFib->updateNode(createRouteFromPrefix(prefix));
+      }
+    }
+    checkPublishedLPM(*newFib, addresses);
+    fib = newFib;
+  }
+}
+
 TEST(ForwardingInformationBaseV4, IPv4DefaultPrefixComparesSmallest) {
   ForwardingInformationBaseV4 oldFib;
   ForwardingInformationBaseV4 newFib;
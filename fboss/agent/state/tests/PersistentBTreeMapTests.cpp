@@ -0,0 +1,257 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/PersistentBTreeMap.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Small nodes, so that a few hundred entries already make a deep tree
+using TestMap = PersistentBTreeMap<int, std::shared_ptr<int>, 4>;
+using RefMap = std::map<int, int>;
+
+void checkEqual(const TestMap& map, const RefMap& ref) {
+  ASSERT_EQ(map.size(), ref.size());
+  ASSERT_EQ(map.empty(), ref.empty());
+  auto it = map.begin();
+  for (const auto& entry : ref) {
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, entry.first);
+    EXPECT_EQ(*it->second, entry.second);
+    ++it;
+  }
+  EXPECT_EQ(it, map.end());
+
+  auto rit = map.rbegin();
+  for (auto refIt = ref.rbegin(); refIt != ref.rend(); ++refIt) {
+    ASSERT_NE(rit, map.rend());
+    EXPECT_EQ(rit->first, refIt->first);
+    ++rit;
+  }
+  EXPECT_EQ(rit, map.rend());
+}
+
+} // namespace
+
+TEST(PersistentBTreeMap, empty) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_EQ(map.lower_bound(1), map.end());
+  EXPECT_EQ(map.erase(1), 0);
+}
+
+TEST(PersistentBTreeMap, insertFindErase) {
+  TestMap map;
+  RefMap ref;
+  // Insert out of order, to split nodes in the middle as well as at the end
+  for (int i = 0; i < 200; ++i) {
+    auto key = (i * 37) % 200;
+    auto ret = map.insert({key, std::make_shared<int>(key * 10)});
+    EXPECT_TRUE(ret.second);
+    EXPECT_EQ(ret.first->first, key);
+    ref[key] = key * 10;
+  }
+  checkEqual(map, ref);
+
+  auto ret = map.insert({5, std::make_shared<int>(0)});
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ(*ret.first->second, 50);
+
+  EXPECT_EQ(map.count(42), 1);
+  EXPECT_EQ(map.count(200), 0);
+  EXPECT_EQ(map.lower_bound(-1)->first, 0);
+  EXPECT_EQ(map.lower_bound(200), map.end());
+
+  for (int key = 0; key < 200; key += 2) {
+    EXPECT_EQ(map.erase(key), 1);
+    ref.erase(key);
+  }
+  checkEqual(map, ref);
+  EXPECT_EQ(map.lower_bound(42)->first, 43);
+
+  auto next = map.erase(map.find(43));
+  ref.erase(43);
+  ASSERT_NE(next, map.end());
+  EXPECT_EQ(next->first, 45);
+  checkEqual(map, ref);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentBTreeMap, decrementEnd) {
+  TestMap map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace_hint(map.cend(), i, std::make_shared<int>(i));
+  }
+  auto it = map.end();
+  --it;
+  EXPECT_EQ(it->first, 99);
+  for (int i = 98; i >= 0; --i) {
+    --it;
+    EXPECT_EQ(it->first, i);
+  }
+  EXPECT_EQ(it, map.begin());
+}
+
+TEST(PersistentBTreeMap, copiesAreIndependent) {
+  TestMap map;
+  RefMap ref;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = std::make_shared<int>(i);
+    ref[i] = i;
+  }
+  auto copy = map;
+  auto copyRef = ref;
+
+  copy[50] = std::make_shared<int>(-50);
+  copyRef[50] = -50;
+  copy.erase(10);
+  copyRef.erase(10);
+  copy.insert({1000, std::make_shared<int>(1000)});
+  copyRef[1000] = 1000;
+
+  checkEqual(map, ref);
+  checkEqual(copy, copyRef);
+
+  // Entries that were not modified are shared between both copies
+  EXPECT_EQ(map.find(20)->second, copy.find(20)->second);
+  EXPECT_NE(map.find(50)->second, copy.find(50)->second);
+}
+
+TEST(PersistentBTreeMap, randomOperations) {
+  std::mt19937 rng(0);
+  TestMap map;
+  RefMap ref;
+  std::vector<std::pair<TestMap, RefMap>> snapshots;
+  for (int i = 0; i < 20000; ++i) {
+    auto key = static_cast<int>(rng() % 500);
+    switch (rng() % 4) {
+      case 0:
+        EXPECT_EQ(
+            map.insert({key, std::make_shared<int>(i)}).second,
+            ref.insert({key, i}).second);
+        break;
+      case 1:
+        EXPECT_EQ(map.erase(key), ref.erase(key));
+        break;
+      case 2:
+        map[key] = std::make_shared<int>(i);
+        ref[key] = i;
+        break;
+      case 3: {
+        auto it = map.lower_bound(key);
+        auto refIt = ref.lower_bound(key);
+        ASSERT_EQ(it == map.end(), refIt == ref.end());
+        if (it != map.end()) {
+          EXPECT_EQ(it->first, refIt->first);
+        }
+        break;
+      }
+    }
+    if (i % 500 == 0) {
+      snapshots.emplace_back(map, ref);
+    }
+  }
+  checkEqual(map, ref);
+
+  // Erase everything, older versions must not be affected
+  for (const auto& entry : RefMap(ref)) {
+    map.erase(entry.first);
+  }
+  EXPECT_TRUE(map.empty());
+  for (const auto& snapshot : snapshots) {
+    checkEqual(snapshot.first, snapshot.second);
+  }
+}
+
+TEST(PersistentBTreeMap, sealNewEntries) {
+  TestMap map;
+  for (int i = 0; i < 200; ++i) {
+    map[i] = std::make_shared<int>(i);
+  }
+  std::set<std::shared_ptr<int>> seen;
+  auto record = [&seen](const std::shared_ptr<int>& value) {
+    seen.insert(value);
+  };
+  map.sealNewEntries(record);
+  EXPECT_EQ(seen.size(), 200);
+
+  // Nothing left to visit until the map is modified
+  seen.clear();
+  map.sealNewEntries(record);
+  EXPECT_TRUE(seen.empty());
+
+  // A copy only visits the entries on the paths it modified
+  auto copy = map;
+  copy[50] = std::make_shared<int>(-50);
+  copy.insert({1000, std::make_shared<int>(1000)});
+  copy.erase(10);
+  copy.sealNewEntries(record);
+  EXPECT_EQ(seen.count(copy.find(50)->second), 1);
+  EXPECT_EQ(seen.count(copy.find(1000)->second), 1);
+  EXPECT_LT(seen.size(), 50);
+
+  // Once the original is gone the copy's tree nodes are no longer shared,
+  // and are modified in place. They still need to be visited again.
+  map.clear();
+  seen.clear();
+  copy[60] = std::make_shared<int>(-60);
+  copy.sealNewEntries(record);
+  EXPECT_EQ(seen.count(copy.find(60)->second), 1);
+}
+
+TEST(PersistentBTreeMap, sealNewEntriesRandomOperations) {
+  std::mt19937 rng(0);
+  TestMap map;
+  std::set<std::shared_ptr<int>> seen;
+  auto record = [&seen](const std::shared_ptr<int>& value) {
+    seen.insert(value);
+  };
+  std::vector<TestMap> sealed;
+  for (int i = 0; i < 20000; ++i) {
+    auto key = static_cast<int>(rng() % 500);
+    switch (rng() % 3) {
+      case 0:
+        map.insert({key, std::make_shared<int>(i)});
+        break;
+      case 1:
+        map.erase(key);
+        break;
+      case 2:
+        map[key] = std::make_shared<int>(i);
+        break;
+    }
+    if (i % 100 == 0) {
+      // Every entry of a sealed map has been visited, by this call or an
+      // earlier one on a map it was copied from
+      map.sealNewEntries(record);
+      for (const auto& entry : map) {
+        ASSERT_EQ(seen.count(entry.second), 1);
+      }
+      sealed.push_back(map);
+      if (sealed.size() > 3) {
+        sealed.erase(sealed.begin());
+      }
+    }
+  }
+}
@@ -21,6 +21,7 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Conv.h>
 #include <gtest/gtest.h>
 
 using namespace facebook::fboss;
@@ -885,3 +886,100 @@ TEST(PortMap, iterateOrder) {
   ++it;
   EXPECT_EQ(ports->end(), it);
 }
+
+TEST(PortMap, deltaFromChangeJournal) {
+  auto ports0 = make_shared<PortMap>();
+  for (auto i = 1; i <= 200; ++i) {
+    ports0->registerPort(PortID(i), folly::to<std::string>("port", i));
+  }
+  ports0->publish();
+  // A freshly built map knows nothing about how it came about
+  auto empty = make_shared<PortMap>();
+  EXPECT_FALSE(ports0->changedKeysSince(*empty));
+
+  auto ports1 = ports0->clone();
+  auto port7 = ports1->getPort(PortID(7))->clone();
+  port7->setName("renamed7");
+  ports1->updatePort(port7);
+  ports1->publish();
+
+  auto ports2 = ports1->clone();
+  auto port3 = ports2->getPort(PortID(3))->clone();
+  port3->setName("renamed3");
+  ports2->updatePort(port3);
+  ports2->registerPort(PortID(500), "port500");
+  // Modify and revert port 9, which should not show up as changed
+  auto port9 = ports2->getPort(PortID(9));
+  auto newPort9 = port9->clone();
+  newPort9->setName("renamed9");
+  ports2->updatePort(newPort9);
+  ports2->updatePort(port9);
+  ports2->publish();
+
+  auto changedKeys = ports2->changedKeysSince(*ports0);
+  ASSERT_TRUE(changedKeys);
+  EXPECT_EQ(
+      (std::vector<PortID>{PortID(3), PortID(7), PortID(9), PortID(500)}),
+      *changedKeys);
+  EXPECT_FALSE(ports0->changedKeysSince(*ports2));
+
+  checkChangedPorts(ports0, ports1, {7});
+  checkChangedPorts(ports0, ports2, {3, 7});
+  checkChangedPorts(ports1, ports2, {3});
+
+  std::vector<PortID> added;
+  NodeMapDelta<PortMap> delta(ports0.get(), ports2.get());
+  DeltaFunctions::forEachAdded(delta, [&](const shared_ptr<Port>& port) {
+    added.push_back(port->getID());
+  });
+  EXPECT_EQ(std::vector<PortID>{PortID(500)}, added);
+}
+
+TEST(PortMap, deltaWithoutChangeJournal) {
+  auto ports0 = make_shared<PortMap>();
+  for (auto i = 1; i <= 10; ++i) {
+    ports0->registerPort(PortID(i), folly::to<std::string>("port", i));
+  }
+  ports0->publish();
+
+  // Changes made behind the journal's back force a full comparison
+  auto ports1 = ports0->clone();
+  auto port2 = ports1->getPort(PortID(2))->clone();
+  port2->setName("renamed2");
+  ports1->writableNodes()[PortID(2)] = port2;
+  ports1->publish();
+  EXPECT_FALSE(ports1->changedKeysSince(*ports0));
+  checkChangedPorts(ports0, ports1, {2});
+
+  // Later generations start tracking changes again
+  auto ports2 = ports1->clone();
+  auto port4 = ports2->getPort(PortID(4))->clone();
+  port4->setName("renamed4");
+  ports2->updatePort(port4);
+  ports2->publish();
+  EXPECT_TRUE(ports2->changedKeysSince(*ports1));
+  EXPECT_FALSE(ports2->changedKeysSince(*ports0));
+  checkChangedPorts(ports1, ports2, {4});
+  checkChangedPorts(ports0, ports2, {2, 4});
+}
+
+TEST(PortMap, deltaAfterModifyingClonedMap) {
+  auto ports0 = make_shared<PortMap>();
+  for (auto i = 1; i <= 10; ++i) {
+    ports0->registerPort(PortID(i), folly::to<std::string>("port", i));
+  }
+  auto ports1 = ports0->clone();
+  auto port5 = ports1->getPort(PortID(5))->clone();
+  port5->setName("renamed5");
+  ports1->updatePort(port5);
+
+  // ports0 was never published, so it can still change after the clone.
+  // ports1 only knows how it differs from ports0 as it was back then.
+  auto port3 = ports0->getPort(PortID(3))->clone();
+  port3->setName("renamed3");
+  ports0->updatePort(port3);
+  ports0->publish();
+  ports1->publish();
+  EXPECT_FALSE(ports1->changedKeysSince(*ports0));
+  checkChangedPorts(ports0, ports1, {3, 5});
+}
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/state/StreamingStateWriter.h"
+#include "fboss/agent/state/RouteTableMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/FileUtil.h>
+#include <folly/experimental/TestUtil.h>
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+folly::dynamic readJson(const std::string& filename) {
+  std::string json;
+  EXPECT_TRUE(folly::readFile(filename.c_str(), json));
+  return folly::parseJson(json);
+}
+
+} // namespace
+
+TEST(StreamingStateWriter, nestedValues) {
+  folly::test::TemporaryFile file;
+  StreamingStateWriter writer(file.path().string());
+  writer.beginObject();
+  writer.key("empty");
+  writer.beginArray();
+  writer.endArray();
+  writer.key("list");
+  writer.beginArray();
+  writer.value(1);
+  writer.beginObject();
+  writer.key("quoted \"key\"");
+  writer.value("value");
+  writer.endObject();
+  writer.value(folly::dynamic::array(2, 3));
+  writer.endArray();
+  writer.key("scalar");
+  writer.value(true);
+  writer.endObject();
+  ASSERT_TRUE(writer.finish());
+
+  folly::dynamic list = folly::dynamic::array(
+      1,
+      folly::dynamic::object("quoted \"key\"", "value"),
+      folly::dynamic::array(2, 3));
+  folly::dynamic expected = folly::dynamic::object(
+      "empty", folly::dynamic::array())("list", list)("scalar", true);
+  EXPECT_EQ(readJson(file.path().string()), expected);
+}
+
+TEST(StreamingStateWriter, matchesToFollyDynamic) {
+  auto state = testStateA();
+  ASSERT_GT(state->getRouteTables()->size(), 0);
+
+  folly::test::TemporaryFile file;
+  StreamingStateWriter writer(file.path().string());
+  state->writeTo(writer);
+  ASSERT_TRUE(writer.finish());
+  EXPECT_GT(writer.bytesWritten(), 0);
+
+  auto json = readJson(file.path().string());
+  EXPECT_EQ(json, state->toFollyDynamic());
+
+  // And it reads back as the same state
+  auto readBack = SwitchState::fromFollyDynamic(json);
+  EXPECT_EQ(readBack->toFollyDynamic(), state->toFollyDynamic());
+}
+
+TEST(StreamingStateWriter, openFailure) {
+  StreamingStateWriter writer("/nonexistent/dir/switch_state");
+  writer.beginObject();
+  writer.endObject();
+  EXPECT_FALSE(writer.finish());
+}
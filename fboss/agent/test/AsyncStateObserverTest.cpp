@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "fboss/agent/AsyncStateObserver.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+
+#include <folly/synchronization/Baton.h>
+
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+std::vector<std::shared_ptr<SwitchState>> makeStates(int count) {
+  std::vector<std::shared_ptr<SwitchState>> states;
+  states.push_back(std::make_shared<SwitchState>());
+  states.back()->publish();
+  for (auto i = 1; i < count; ++i) {
+    states.push_back(states.back()->clone());
+    states.back()->publish();
+  }
+  return states;
+}
+
+class RecordingObserver : public StateObserver {
+ public:
+  void stateUpdated(const StateDelta& delta) override {
+    if (blockFirst_ && deltas_.empty()) {
+      started_.post();
+      unblock_.wait();
+    }
+    deltas_.emplace_back(delta.oldState(), delta.newState());
+  }
+
+  bool blockFirst_{false};
+  folly::Baton<> started_;
+  folly::Baton<> unblock_;
+  std::vector<
+      std::pair<std::shared_ptr<SwitchState>, std::shared_ptr<SwitchState>>>
+      deltas_;
+};
+
+void waitForDrain(const AsyncStateObserver& asyncObserver) {
+  while (asyncObserver.pendingDeltas()) {
+    std::this_thread::yield();
+  }
+}
+
+} // namespace
+
+TEST(AsyncStateObserverTest, deltasDeliveredInOrder) {
+  auto states = makeStates(5);
+  RecordingObserver observer;
+  {
+    AsyncStateObserver asyncObserver(
+        &observer, "test", AsyncStateObserverOptions());
+    for (size_t i = 1; i < states.size(); ++i) {
+      asyncObserver.stateUpdated(StateDelta(states[i - 1], states[i]));
+    }
+    waitForDrain(asyncObserver);
+  }
+  ASSERT_EQ(observer.deltas_.size(), states.size() - 1);
+  for (size_t i = 1; i < states.size(); ++i) {
+    EXPECT_EQ(observer.deltas_[i - 1].first, states[i - 1]);
+    EXPECT_EQ(observer.deltas_[i - 1].second, states[i]);
+  }
+}
+
+TEST(AsyncStateObserverTest, deltasCollapsedWhenBehind) {
+  auto states = makeStates(6);
+  RecordingObserver observer;
+  observer.blockFirst_ = true;
+  AsyncStateObserverOptions options;
+  options.maxPendingDeltas = 2;
+  {
+    AsyncStateObserver asyncObserver(&observer, "test", options);
+    asyncObserver.stateUpdated(StateDelta(states[0], states[1]));
+    observer.started_.wait();
+    // Observer is now stuck on the first delta. Queue fills up with 1->2 and
+    // 2->3, after which 3->4 and 4->5 get folded into the last delta.
+    for (size_t i = 2; i < states.size(); ++i) {
+      asyncObserver.stateUpdated(StateDelta(states[i - 1], states[i]));
+    }
+    EXPECT_EQ(asyncObserver.pendingDeltas(), 2);
+    observer.unblock_.post();
+    waitForDrain(asyncObserver);
+  }
+  ASSERT_EQ(observer.deltas_.size(), 3);
+  EXPECT_EQ(observer.deltas_[1].first, states[1]);
+  EXPECT_EQ(observer.deltas_[1].second, states[2]);
+  EXPECT_EQ(observer.deltas_[2].first, states[2]);
+  EXPECT_EQ(observer.deltas_[2].second, states[5]);
+}
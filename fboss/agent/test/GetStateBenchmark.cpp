@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/PortMap.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Number of threads reading the state, as rx threads do for every packet
+auto constexpr kNumReaders = 16;
+// Interval between state updates while readers are running
+auto constexpr kUpdateInterval = std::chrono::milliseconds(1);
+
+enum class ReadPath {
+  LOCKED,
+  LOCK_FREE,
+};
+
+std::shared_ptr<SwitchState> readState(const SwSwitch* sw, ReadPath path) {
+  return path == ReadPath::LOCKED ? sw->getDesiredState() : sw->getState();
+}
+
+} // namespace
+
+/*
+ * kNumReaders threads each fetch the current state and look up a port, as
+ * the packet rx path does, while the update thread keeps publishing new
+ * states. Compares reading the desired state under stateLock_ with the lock
+ * free per-core snapshot behind getState().
+ */
+static void runGetStateBenchmark(unsigned int iters, ReadPath path) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+
+  auto handle = createTestHandle(testStateA());
+  auto sw = handle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  waitForStateUpdates(sw);
+
+  std::atomic<bool> done{false};
+  std::thread updater([sw, &done]() {
+    auto up = false;
+    while (!done.load()) {
+      up = !up;
+      sw->updateState(
+          "Toggle ports", [up](const std::shared_ptr<SwitchState>& state) {
+            return up ? bringAllPortsUp(state) : bringAllPortsDown(state);
+          });
+      std::this_thread::sleep_for(kUpdateInterval);
+    }
+  });
+
+  std::atomic<uint64_t> portsFound{0};
+  std::vector<std::thread> readers;
+  suspender.dismiss();
+  for (auto i = 0; i < kNumReaders; ++i) {
+    readers.emplace_back([sw, iters, path, &portsFound]() {
+      uint64_t found = 0;
+      for (unsigned int j = 0; j < iters / kNumReaders; ++j) {
+        auto state = readState(sw, path);
+        found += state->getPorts()->getPortIf(PortID(1)) != nullptr;
+      }
+      portsFound += found;
+    });
+  }
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  suspender.rehire();
+
+  done = true;
+  updater.join();
+  waitForStateUpdates(sw);
+  folly::doNotOptimizeAway(portsFound.load());
+}
+
+BENCHMARK(GetStateLocked, iters) {
+  runGetStateBenchmark(iters, ReadPath::LOCKED);
+}
+
+BENCHMARK_RELATIVE(GetStateLockFree, iters) {
+  runGetStateBenchmark(iters, ReadPath::LOCK_FREE);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,241 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+#include "fboss/lib/MultibitTrie.h"
+#include "fboss/lib/RadixTree.h"
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/MacAddress.h>
+#include <folly/Random.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace facebook::fboss;
+using facebook::network::MultibitTrie;
+using facebook::network::RadixTree;
+
+namespace {
+
+constexpr auto kEcmpWidth = 4;
+constexpr auto kNumAddresses = 1 << 16;
+constexpr size_t kBatchSize = 64;
+
+template <typename AddrT>
+AddrT randomAddressIn(const AddrT& network, uint8_t mask) {
+  auto bytes = network.toByteArray();
+  for (size_t i = 0; i < bytes.size(); ++i) {
+    auto networkBits = std::clamp<int>(mask - 8 * i, 0, 8);
+    uint8_t hostBits = 0xff >> networkBits;
+    bytes[i] = (bytes[i] & ~hostBits) | (folly::Random::rand32(256) & hostBits);
+  }
+  return AddrT(bytes);
+}
+
+/*
+ * Both lookup structures over the prefixes of one address family, and
+ * addresses to look up in them, each inside a random one of the prefixes.
+ */
+template <typename AddrT>
+struct LpmTables {
+  RadixTree<AddrT, int> tree;
+  MultibitTrie<AddrT, int> trie;
+  std::vector<AddrT> addrs;
+
+  void build(const std::vector<std::pair<AddrT, uint8_t>>& prefixes) {
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      tree.insert(prefixes[i].first, prefixes[i].second, i);
+    }
+    trie = MultibitTrie<AddrT, int>::fromRadixTree(tree);
+    for (auto i = 0; i < kNumAddresses && !prefixes.empty(); ++i) {
+      const auto& prefix =
+          prefixes[folly::Random::rand32(prefixes.size())];
+      addrs.push_back(randomAddressIn(prefix.first, prefix.second));
+    }
+  }
+};
+
+struct LookupData {
+  LpmTables<folly::IPAddressV4> v4;
+  LpmTables<folly::IPAddressV6> v6;
+
+  template <typename AddrT>
+  const LpmTables<AddrT>& get() const {
+    if constexpr (std::is_same_v<AddrT, folly::IPAddressV4>) {
+      return v4;
+    } else {
+      return v6;
+    }
+  }
+};
+
+template <typename Generator>
+LookupData makeLookupData() {
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle = createTestHandle(&config, SwitchFlags::DEFAULT);
+  auto sw = testHandle->getSw();
+
+  std::vector<std::pair<folly::IPAddressV4, uint8_t>> v4Prefixes;
+  std::vector<std::pair<folly::IPAddressV6, uint8_t>> v6Prefixes;
+  auto generator = Generator(sw->getAppliedState(), 1337, kEcmpWidth);
+  for (const auto& chunk : generator.get()) {
+    for (const auto& route : chunk) {
+      const auto& [network, mask] = route.prefix;
+      if (network.isV4()) {
+        v4Prefixes.emplace_back(network.asV4(), mask);
+      } else {
+        v6Prefixes.emplace_back(network.asV6(), mask);
+      }
+    }
+  }
+
+  LookupData data;
+  data.v4.build(v4Prefixes);
+  data.v6.build(v6Prefixes);
+  return data;
+}
+
+// Built once, as folly runs each benchmark several times
+template <typename Generator>
+const LookupData& lookupData() {
+  static const LookupData data = makeLookupData<Generator>();
+  return data;
+}
+
+template <typename Generator, typename AddrT>
+void radixTreeLookups(unsigned iters) {
+  folly::BenchmarkSuspender suspender;
+  const auto& tables = lookupData<Generator>().template get<AddrT>();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    const auto& addr = tables.addrs[i % tables.addrs.size()];
+    folly::doNotOptimizeAway(tables.tree.longestMatch(addr, addr.bitCount()));
+  }
+}
+
+template <typename Generator, typename AddrT>
+void multibitTrieLookups(unsigned iters) {
+  folly::BenchmarkSuspender suspender;
+  const auto& tables = lookupData<Generator>().template get<AddrT>();
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    const auto& addr = tables.addrs[i % tables.addrs.size()];
+    folly::doNotOptimizeAway(tables.trie.longestMatch(addr));
+  }
+}
+
+// Each iteration is still one lookup, made kBatchSize at a time
+template <typename Generator, typename AddrT>
+void multibitTrieBatchLookups(unsigned iters) {
+  folly::BenchmarkSuspender suspender;
+  const auto& tables = lookupData<Generator>().template get<AddrT>();
+  std::vector<const int*> results(kBatchSize);
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; i += kBatchSize) {
+    auto begin = i % tables.addrs.size();
+    auto count = std::min<size_t>(
+        {kBatchSize, iters - i, tables.addrs.size() - begin});
+    tables.trie.longestMatch(
+        folly::range(
+            tables.addrs.data() + begin, tables.addrs.data() + begin + count),
+        results.data());
+    folly::doNotOptimizeAway(results);
+  }
+}
+
+} // namespace
+
+BENCHMARK(RadixTreeLookupFSWV4, iters) {
+  radixTreeLookups<utility::FSWRouteScaleGenerator, folly::IPAddressV4>(iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieLookupFSWV4, iters) {
+  multibitTrieLookups<utility::FSWRouteScaleGenerator, folly::IPAddressV4>(
+      iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieBatchLookupFSWV4, iters) {
+  multibitTrieBatchLookups<
+      utility::FSWRouteScaleGenerator,
+      folly::IPAddressV4>(iters);
+}
+
+BENCHMARK(RadixTreeLookupFSWV6, iters) {
+  radixTreeLookups<utility::FSWRouteScaleGenerator, folly::IPAddressV6>(iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieLookupFSWV6, iters) {
+  multibitTrieLookups<utility::FSWRouteScaleGenerator, folly::IPAddressV6>(
+      iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieBatchLookupFSWV6, iters) {
+  multibitTrieBatchLookups<
+      utility::FSWRouteScaleGenerator,
+      folly::IPAddressV6>(iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(RadixTreeLookupTHAlpmV4, iters) {
+  radixTreeLookups<utility::THAlpmRouteScaleGenerator, folly::IPAddressV4>(
+      iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieLookupTHAlpmV4, iters) {
+  multibitTrieLookups<utility::THAlpmRouteScaleGenerator, folly::IPAddressV4>(
+      iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieBatchLookupTHAlpmV4, iters) {
+  multibitTrieBatchLookups<
+      utility::THAlpmRouteScaleGenerator,
+      folly::IPAddressV4>(iters);
+}
+
+BENCHMARK(RadixTreeLookupTHAlpmV6, iters) {
+  radixTreeLookups<utility::THAlpmRouteScaleGenerator, folly::IPAddressV6>(
+      iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieLookupTHAlpmV6, iters) {
+  multibitTrieLookups<utility::THAlpmRouteScaleGenerator, folly::IPAddressV6>(
+      iters);
+}
+
+BENCHMARK_RELATIVE(MultibitTrieBatchLookupTHAlpmV6, iters) {
+  multibitTrieBatchLookups<
+      utility::THAlpmRouteScaleGenerator,
+      folly::IPAddressV6>(iters);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
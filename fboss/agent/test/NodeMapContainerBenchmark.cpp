@@ -0,0 +1,254 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
+#include "fboss/agent/state/NodeMap-defs.h"
+#include "fboss/agent/state/PersistentBTreeMap.h"
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <boost/container/flat_map.hpp>
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+
+#include <memory>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * A v6 FIB keeping its routes in the default flat_map container, to compare
+ * against ForwardingInformationBaseV6 in the NodeMap benchmarks below.
+ */
+using FlatMapFibV6Traits = NodeMapTraits<RoutePrefixV6, RouteV6>;
+
+class FlatMapFibV6 : public NodeMapT<FlatMapFibV6, FlatMapFibV6Traits> {
+ public:
+  FlatMapFibV6() {}
+
+ private:
+  // Inherit the constructors required for clone()
+  using NodeMapT::NodeMapT;
+  friend class CloneAllocator;
+};
+
+FBOSS_INSTANTIATE_NODE_MAP(FlatMapFibV6, FlatMapFibV6Traits);
+
+} // namespace facebook::fboss
+
+using namespace facebook::fboss;
+
+namespace {
+
+// Number of copy-on-write updates made to the full route table
+auto constexpr kNumUpdates = 1000;
+
+using GeneratedRoute = utility::RouteDistributionGenerator::Route;
+using RouteNode = std::shared_ptr<const GeneratedRoute>;
+using FlatMapContainer =
+    boost::container::flat_map<folly::CIDRNetwork, RouteNode>;
+using PersistentContainer = PersistentBTreeMap<folly::CIDRNetwork, RouteNode>;
+
+template <typename Generator>
+std::vector<RouteNode> generateRoutes() {
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle = createTestHandle(&config);
+  auto sw = testHandle->getSw();
+
+  std::vector<RouteNode> routes;
+  for (const auto& chunk : Generator(sw->getAppliedState()).get()) {
+    for (const auto& route : chunk) {
+      routes.push_back(std::make_shared<const GeneratedRoute>(route));
+    }
+  }
+  return routes;
+}
+
+} // namespace
+
+/*
+ * Starting from a NodeContainer holding all routes of a RouteScaleGenerator
+ * distribution, make kNumUpdates copy-on-write updates the way NodeMapT does
+ * for each route change: copy the container of the published map, then
+ * replace one entry in the copy.
+ */
+template <typename Container, typename Generator>
+static void runCloneAndUpdateBenchmark() {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+
+  auto routes = generateRoutes<Generator>();
+  auto published = std::make_shared<Container>();
+  for (const auto& route : routes) {
+    published->emplace_hint(published->cend(), route->prefix, route);
+  }
+
+  suspender.dismiss();
+  for (auto i = 0; i < kNumUpdates; ++i) {
+    const auto& route = routes[(i * 7919) % routes.size()];
+    auto modified = std::make_shared<Container>(*published);
+    (*modified)[route->prefix] = std::make_shared<const GeneratedRoute>(*route);
+    published = std::move(modified);
+  }
+  suspender.rehire();
+
+  folly::doNotOptimizeAway(published->size());
+}
+
+/*
+ * Iterating a full route table, as the delta and forEachChild walks do.
+ */
+template <typename Container, typename Generator>
+static void runIterateBenchmark() {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+
+  auto routes = generateRoutes<Generator>();
+  Container container;
+  for (const auto& route : routes) {
+    container.emplace_hint(container.cend(), route->prefix, route);
+  }
+
+  suspender.dismiss();
+  size_t nhops = 0;
+  for (auto i = 0; i < kNumUpdates; ++i) {
+    for (const auto& entry : container) {
+      nhops += entry.second->nhops.size();
+    }
+  }
+  suspender.rehire();
+
+  folly::doNotOptimizeAway(nhops);
+}
+
+/*
+ * The same kNumUpdates updates through a whole NodeMap, as the FIB gets them
+ * from the route updater: clone() the published map, updateNode() one route
+ * and publish() the result. Only the v6 routes of the distribution are used.
+ */
+template <typename NodeMap, typename Generator>
+static void runNodeMapCloneUpdatePublishBenchmark() {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+
+  std::vector<std::shared_ptr<RouteV6>> routes;
+  for (const auto& route : generateRoutes<Generator>()) {
+    if (!route->prefix.first.isV6()) {
+      continue;
+    }
+    RoutePrefixV6 prefix{route->prefix.first.asV6(), route->prefix.second};
+    routes.push_back(std::make_shared<RouteV6>(
+        prefix,
+        ClientID::BGPD,
+        RouteNextHopEntry(RouteForwardAction::DROP, AdminDistance::EBGP)));
+  }
+  auto published = std::make_shared<NodeMap>();
+  for (const auto& route : routes) {
+    published->addNode(route);
+  }
+  published->publish();
+
+  suspender.dismiss();
+  for (auto i = 0; i < kNumUpdates; ++i) {
+    const auto& route = routes[(i * 7919) % routes.size()];
+    auto modified = published->clone();
+    modified->updateNode(route->clone());
+    modified->publish();
+    published = std::move(modified);
+  }
+  suspender.rehire();
+
+  folly::doNotOptimizeAway(published->size());
+}
+
+BENCHMARK(CloneAndUpdateFSWFlatMap) {
+  runCloneAndUpdateBenchmark<
+      FlatMapContainer,
+      utility::FSWRouteScaleGenerator>();
+}
+
+BENCHMARK_RELATIVE(CloneAndUpdateFSWPersistent) {
+  runCloneAndUpdateBenchmark<
+      PersistentContainer,
+      utility::FSWRouteScaleGenerator>();
+}
+
+BENCHMARK(CloneAndUpdateTHAlpmFlatMap) {
+  runCloneAndUpdateBenchmark<
+      FlatMapContainer,
+      utility::THAlpmRouteScaleGenerator>();
+}
+
+BENCHMARK_RELATIVE(CloneAndUpdateTHAlpmPersistent) {
+  runCloneAndUpdateBenchmark<
+      PersistentContainer,
+      utility::THAlpmRouteScaleGenerator>();
+}
+
+BENCHMARK(NodeMapCloneUpdatePublishFSWFlatMap) {
+  runNodeMapCloneUpdatePublishBenchmark<
+      FlatMapFibV6,
+      utility::FSWRouteScaleGenerator>();
+}
+
+BENCHMARK_RELATIVE(NodeMapCloneUpdatePublishFSWPersistent) {
+  runNodeMapCloneUpdatePublishBenchmark<
+      ForwardingInformationBaseV6,
+      utility::FSWRouteScaleGenerator>();
+}
+
+BENCHMARK(NodeMapCloneUpdatePublishTHAlpmFlatMap) {
+  runNodeMapCloneUpdatePublishBenchmark<
+      FlatMapFibV6,
+      utility::THAlpmRouteScaleGenerator>();
+}
+
+BENCHMARK_RELATIVE(NodeMapCloneUpdatePublishTHAlpmPersistent) {
+  runNodeMapCloneUpdatePublishBenchmark<
+      ForwardingInformationBaseV6,
+      utility::THAlpmRouteScaleGenerator>();
+}
+
+BENCHMARK(IterateFSWFlatMap) {
+  runIterateBenchmark<FlatMapContainer, utility::FSWRouteScaleGenerator>();
+}
+
+BENCHMARK_RELATIVE(IterateFSWPersistent) {
+  runIterateBenchmark<PersistentContainer, utility::FSWRouteScaleGenerator>();
+}
+
+BENCHMARK(IterateTHAlpmFlatMap) {
+  runIterateBenchmark<FlatMapContainer, utility::THAlpmRouteScaleGenerator>();
+}
+
+BENCHMARK_RELATIVE(IterateTHAlpmPersistent) {
+  runIterateBenchmark<
+      PersistentContainer,
+      utility::THAlpmRouteScaleGenerator>();
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
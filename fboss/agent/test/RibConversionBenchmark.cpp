@@ -13,6 +13,7 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/hw/sim/SimPlatform.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/rib/ForwardingInformationBaseUpdater.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/RouteScaleGenerators.h"
@@ -24,10 +25,11 @@
 
 using namespace facebook::fboss;
 
-template <typename Generator>
-static void runConversionBenchmark() {
-  auto constexpr kEcmpWidth = 4;
+namespace {
+
+auto constexpr kEcmpWidth = 4;
 
+std::unique_ptr<HwTestHandle> setupTestHandle() {
   SimPlatform plat(folly::MacAddress(), 128);
   std::vector<PortID> ports;
   for (int i = 0; i < 128; ++i) {
@@ -51,6 +53,29 @@ static void runConversionBenchmark() {
             std::make_shared<RouteTable>(RouterID(0)));
         return newState;
       });
+  return testHandle;
+}
+
+std::vector<NextHopThrift> nextHopsThrift(
+    const std::vector<folly::IPAddress>& addrs) {
+  std::vector<NextHopThrift> nexthops;
+  for (const auto& addr : addrs) {
+    NextHopThrift nexthop;
+    auto binaryAddr = facebook::network::toBinaryAddress(addr);
+    binaryAddr.ifName_ref() = "fboss1";
+    *nexthop.address_ref() = binaryAddr;
+    *nexthop.weight_ref() = static_cast<int32_t>(ECMP_WEIGHT);
+    nexthops.emplace_back(std::move(nexthop));
+  }
+  return nexthops;
+}
+
+} // namespace
+
+template <typename Generator>
+static void runConversionBenchmark() {
+  auto testHandle = setupTestHandle();
+  auto sw = testHandle->getSw();
 
   auto generator = Generator(sw->getAppliedState(), 1337, kEcmpWidth);
   const auto& states = generator.getSwitchStates();
@@ -63,6 +88,76 @@ static void runConversionBenchmark() {
   syncFibWithStandaloneRib(standaloneRib, sw);
 }
 
+/*
+ * Latency of RIB updates that add or remove a single route, with the FIB
+ * already synced to a RIB at scale. With incremental set, only the FIB
+ * entries the update changed are patched, rather than building the whole
+ * FIB again.
+ */
+template <typename Generator>
+static void runSmallDeltaBenchmark(unsigned iters, bool incremental) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+
+  auto testHandle = setupTestHandle();
+  auto sw = testHandle->getSw();
+
+  auto generator = Generator(sw->getAppliedState(), 1337, kEcmpWidth);
+  const auto& states = generator.getSwitchStates();
+  auto standaloneRib =
+      switchStateToStandaloneRib(states[states.size() - 1]->getRouteTables());
+  syncFibWithStandaloneRib(standaloneRib, sw);
+
+  // Flap a prefix outside the generated ones, through the next hops of a
+  // generated route
+  IpPrefix prefix;
+  prefix.ip = facebook::network::toBinaryAddress(folly::IPAddress("100::"));
+  prefix.prefixLength = 64;
+  UnicastRoute route;
+  route.set_dest(prefix);
+  route.nextHops_ref() = nextHopsThrift(generator.get().back().back().nhops);
+
+  auto fibUpdate = [incremental](
+                       RouterID vrf,
+                       const rib::IPv4NetworkToRouteMap& v4NetworkToRoute,
+                       const rib::IPv6NetworkToRouteMap& v6NetworkToRoute,
+                       const std::set<folly::CIDRNetwork>* changedPrefixes,
+                       void* cookie) {
+    rib::ForwardingInformationBaseUpdater fibUpdater(
+        vrf,
+        v4NetworkToRoute,
+        v6NetworkToRoute,
+        incremental ? changedPrefixes : nullptr);
+    static_cast<SwSwitch*>(cookie)->updateStateBlocking(
+        "", std::move(fibUpdater));
+  };
+
+  // Resume benchmakring post-setup.
+  suspender.dismiss();
+
+  for (unsigned i = 0; i < iters; ++i) {
+    std::vector<UnicastRoute> toAdd;
+    std::vector<IpPrefix> toDelete;
+    if (i % 2) {
+      toDelete.push_back(prefix);
+    } else {
+      toAdd.push_back(route);
+    }
+    standaloneRib.update(
+        RouterID(0),
+        ClientID::BGPD,
+        AdminDistance::EBGP,
+        toAdd,
+        toDelete,
+        false,
+        "small delta",
+        fibUpdate,
+        sw);
+  }
+
+  suspender.rehire();
+}
+
 BENCHMARK(RibConversionFSW) {
   runConversionBenchmark<utility::FSWRouteScaleGenerator>();
 }
@@ -79,6 +174,24 @@ BENCHMARK(RibConversionHgridUu) {
   runConversionBenchmark<utility::HgridUuRouteScaleGenerator>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(SmallDeltaFullFibFSW, iters) {
+  runSmallDeltaBenchmark<utility::FSWRouteScaleGenerator>(iters, false);
+}
+
+BENCHMARK_RELATIVE(SmallDeltaIncrementalFibFSW, iters) {
+  runSmallDeltaBenchmark<utility::FSWRouteScaleGenerator>(iters, true);
+}
+
+BENCHMARK(SmallDeltaFullFibTHAlpm, iters) {
+  runSmallDeltaBenchmark<utility::THAlpmRouteScaleGenerator>(iters, false);
+}
+
+BENCHMARK_RELATIVE(SmallDeltaIncrementalFibTHAlpm, iters) {
+  runSmallDeltaBenchmark<utility::THAlpmRouteScaleGenerator>(iters, true);
+}
+
 int main(int argc, char** argv) {
   facebook::initFacebook(&argc, &argv);
   folly::runBenchmarks();
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/Constants.h"
+#include "fboss/agent/StateSerialization.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/dynamic.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+template <typename Generator>
+folly::dynamic generateStateDynamic() {
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle = createTestHandle(&config);
+  auto sw = testHandle->getSw();
+
+  auto state = Generator(sw->getAppliedState()).getSwitchStates().back();
+  folly::dynamic switchState = folly::dynamic::object;
+  switchState[kSwSwitch] = state->toFollyDynamic();
+  return switchState;
+}
+
+} // namespace
+
+/*
+ * Serialize the switch state at full route scale, as done on warm boot exit.
+ */
+template <typename Generator>
+static void runSerializeBenchmark(StateSerializationFormat format) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+  auto switchState = generateStateDynamic<Generator>();
+  suspender.dismiss();
+
+  auto serialized = serializeState(switchState, format);
+
+  suspender.rehire();
+  folly::doNotOptimizeAway(serialized.size());
+}
+
+/*
+ * Parse the switch state back and recreate the SwitchState, as done on warm
+ * boot.
+ */
+template <typename Generator>
+static void runDeserializeBenchmark(StateSerializationFormat format) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+  auto serialized = serializeState(generateStateDynamic<Generator>(), format);
+  suspender.dismiss();
+
+  auto state =
+      SwitchState::fromFollyDynamic(deserializeState(serialized)[kSwSwitch]);
+
+  suspender.rehire();
+  folly::doNotOptimizeAway(state);
+}
+
+/*
+ * Recreate the SwitchState from its already parsed folly::dynamic, with the
+ * larger subtrees spread over a pool of numThreads threads (inline if 0).
+ */
+template <typename Generator>
+static void runFromFollyDynamicBenchmark(uint32_t numThreads) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+  auto switchState = generateStateDynamic<Generator>();
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  if (numThreads) {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+  }
+  suspender.dismiss();
+
+  auto state =
+      SwitchState::fromFollyDynamic(switchState[kSwSwitch], executor.get());
+
+  suspender.rehire();
+  folly::doNotOptimizeAway(state);
+}
+
+BENCHMARK(SerializeFSWJson) {
+  runSerializeBenchmark<utility::FSWRouteScaleGenerator>(
+      StateSerializationFormat::JSON);
+}
+
+BENCHMARK_RELATIVE(SerializeFSWBinary) {
+  runSerializeBenchmark<utility::FSWRouteScaleGenerator>(
+      StateSerializationFormat::BINARY);
+}
+
+BENCHMARK(SerializeTHAlpmJson) {
+  runSerializeBenchmark<utility::THAlpmRouteScaleGenerator>(
+      StateSerializationFormat::JSON);
+}
+
+BENCHMARK_RELATIVE(SerializeTHAlpmBinary) {
+  runSerializeBenchmark<utility::THAlpmRouteScaleGenerator>(
+      StateSerializationFormat::BINARY);
+}
+
+BENCHMARK(DeserializeFSWJson) {
+  runDeserializeBenchmark<utility::FSWRouteScaleGenerator>(
+      StateSerializationFormat::JSON);
+}
+
+BENCHMARK_RELATIVE(DeserializeFSWBinary) {
+  runDeserializeBenchmark<utility::FSWRouteScaleGenerator>(
+      StateSerializationFormat::BINARY);
+}
+
+BENCHMARK(DeserializeTHAlpmJson) {
+  runDeserializeBenchmark<utility::THAlpmRouteScaleGenerator>(
+      StateSerializationFormat::JSON);
+}
+
+BENCHMARK_RELATIVE(DeserializeTHAlpmBinary) {
+  runDeserializeBenchmark<utility::THAlpmRouteScaleGenerator>(
+      StateSerializationFormat::BINARY);
+}
+
+BENCHMARK(FromFollyDynamicFSW) {
+  runFromFollyDynamicBenchmark<utility::FSWRouteScaleGenerator>(0);
+}
+
+BENCHMARK_RELATIVE(FromFollyDynamicFSWParallel) {
+  runFromFollyDynamicBenchmark<utility::FSWRouteScaleGenerator>(4);
+}
+
+BENCHMARK(FromFollyDynamicTHAlpm) {
+  runFromFollyDynamicBenchmark<utility::THAlpmRouteScaleGenerator>(0);
+}
+
+BENCHMARK_RELATIVE(FromFollyDynamicTHAlpmParallel) {
+  runFromFollyDynamicBenchmark<utility::THAlpmRouteScaleGenerator>(4);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
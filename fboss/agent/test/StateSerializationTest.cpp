@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/StateSerialization.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/json.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+folly::dynamic testStateDynamic() {
+  folly::dynamic switchState = folly::dynamic::object;
+  switchState["swSwitch"] = testStateA()->toFollyDynamic();
+  return switchState;
+}
+
+} // namespace
+
+TEST(StateSerializationTest, jsonRoundTrip) {
+  auto state = testStateDynamic();
+  auto serialized = serializeState(state, StateSerializationFormat::JSON);
+  EXPECT_EQ(folly::parseJson(serialized), state);
+  EXPECT_EQ(deserializeState(serialized), state);
+}
+
+TEST(StateSerializationTest, binaryRoundTrip) {
+  auto state = testStateDynamic();
+  auto serialized = serializeState(state, StateSerializationFormat::BINARY);
+  EXPECT_LT(
+      serialized.size(),
+      serializeState(state, StateSerializationFormat::JSON).size());
+  auto deserialized = deserializeState(serialized);
+  EXPECT_EQ(deserialized, state);
+
+  // The whole SwitchState survives the round trip
+  auto switchState = SwitchState::fromFollyDynamic(deserialized["swSwitch"]);
+  EXPECT_EQ(switchState->toFollyDynamic(), state["swSwitch"]);
+}
+
+TEST(StateSerializationTest, rejectsNewerBinaryVersion) {
+  auto serialized =
+      serializeState(testStateDynamic(), StateSerializationFormat::BINARY);
+  // Version follows the 8 byte magic, in network byte order
+  serialized[11] = 2;
+  EXPECT_THROW(deserializeState(serialized), FbossError);
+}
+
+TEST(StateSerializationTest, rejectsTruncatedBinaryHeader) {
+  auto serialized =
+      serializeState(testStateDynamic(), StateSerializationFormat::BINARY);
+  EXPECT_THROW(deserializeState(serialized.substr(0, 10)), FbossError);
+}
+
+TEST(StateSerializationTest, parallelDeserialize) {
+  auto json = testStateA()->toFollyDynamic();
+  folly::CPUThreadPoolExecutor executor(4);
+  auto switchState = SwitchState::fromFollyDynamic(json, &executor);
+  EXPECT_EQ(switchState->toFollyDynamic(), json);
+}
+
+TEST(StateSerializationTest, parallelDeserializeError) {
+  auto json = testStateA()->toFollyDynamic();
+  json["vlans"]["entries"][0].erase("vlanId");
+  folly::CPUThreadPoolExecutor executor(4);
+  EXPECT_ANY_THROW(SwitchState::fromFollyDynamic(json, &executor));
+}
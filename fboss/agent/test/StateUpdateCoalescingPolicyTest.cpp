@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include "fboss/agent/StateUpdateCoalescingPolicy.h"
+
+using namespace facebook::fboss;
+using namespace std::chrono;
+
+TEST(StateUpdateCoalescingPolicyTest, noLimits) {
+  StateUpdateCoalescingPolicy policy(0, microseconds(0), false);
+  EXPECT_EQ(policy.getBatchSizeLimit(), 0);
+  auto start = steady_clock::now();
+  EXPECT_FALSE(policy.batchLatencyExceeded(start, start + seconds(10)));
+  policy.batchApplied(1000, seconds(10));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 0);
+}
+
+TEST(StateUpdateCoalescingPolicyTest, fixedLimits) {
+  StateUpdateCoalescingPolicy policy(8, milliseconds(10), false);
+  EXPECT_EQ(policy.getBatchSizeLimit(), 8);
+  auto start = steady_clock::now();
+  EXPECT_FALSE(policy.batchLatencyExceeded(start, start + milliseconds(5)));
+  EXPECT_TRUE(policy.batchLatencyExceeded(start, start + milliseconds(10)));
+  // Limits stay put without adaptive mode
+  policy.batchApplied(8, milliseconds(100));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 8);
+}
+
+TEST(StateUpdateCoalescingPolicyTest, adaptiveNeedsLatencyBudget) {
+  StateUpdateCoalescingPolicy policy(8, microseconds(0), true);
+  policy.batchApplied(8, seconds(1));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 8);
+}
+
+TEST(StateUpdateCoalescingPolicyTest, adaptiveBacksOffAndGrows) {
+  StateUpdateCoalescingPolicy policy(0, milliseconds(10), true);
+  EXPECT_EQ(
+      policy.getBatchSizeLimit(),
+      StateUpdateCoalescingPolicy::kMaxAdaptiveBatchSize);
+
+  // Slow batches halve the limit, down to a single update
+  policy.batchApplied(100, milliseconds(20));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 50);
+  policy.batchApplied(1, milliseconds(20));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 1);
+
+  // Fast, full batches double it again
+  policy.batchApplied(1, milliseconds(1));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 2);
+  policy.batchApplied(2, milliseconds(1));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 4);
+
+  // Batches not capped by the limit, or close to the budget, leave it alone
+  policy.batchApplied(2, milliseconds(1));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 4);
+  policy.batchApplied(4, milliseconds(8));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 4);
+}
+
+TEST(StateUpdateCoalescingPolicyTest, adaptiveRespectsMaxBatchSize) {
+  StateUpdateCoalescingPolicy policy(6, milliseconds(10), true);
+  policy.batchApplied(6, milliseconds(20));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 3);
+  policy.batchApplied(3, milliseconds(1));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 6);
+  policy.batchApplied(6, milliseconds(1));
+  EXPECT_EQ(policy.getBatchSizeLimit(), 6);
+}
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "common/init/Init.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/ThriftHandler.h"
+#include "fboss/agent/hw/sim/SimPlatform.h"
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/RouteScaleGenerators.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/logging/xlog.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace facebook::fboss;
+
+namespace {
+
+auto constexpr kEcmpWidth = 4;
+auto constexpr kChunkSize = 1000;
+// Number of thrift clients concurrently adding routes
+auto constexpr kNumClients = 4;
+
+facebook::network::thrift::BinaryAddress createNextHop(
+    const folly::IPAddress& addr) {
+  auto addrAsBinaryAddress = facebook::network::toBinaryAddress(addr);
+  addrAsBinaryAddress.ifName_ref() = "fboss1";
+  return addrAsBinaryAddress;
+}
+
+std::vector<NextHopThrift> nextHopsThrift(
+    const std::vector<folly::IPAddress>& addrs) {
+  std::vector<NextHopThrift> nexthops;
+  for (const auto& addr : addrs) {
+    NextHopThrift nexthop;
+    *nexthop.address_ref() = createNextHop(addr);
+    *nexthop.weight_ref() = static_cast<int32_t>(ECMP_WEIGHT);
+    nexthops.emplace_back(std::move(nexthop));
+  }
+  return nexthops;
+}
+
+} // namespace
+
+/*
+ * Measure routes/sec while kNumClients thrift clients keep adding routes
+ * through addUnicastRoutes. With the state update pipeline enabled,
+ * programming hardware for one generation overlaps with preparing the next
+ * one, so throughput should be bound by the slower of the two stages rather
+ * than their sum.
+ */
+template <typename Generator>
+static void runAddUnicastRoutesBenchmark(SwitchFlags flags) {
+  // Suspend benchamrking for setup.
+  folly::BenchmarkSuspender suspender;
+
+  SimPlatform plat(folly::MacAddress(), 128);
+  std::vector<PortID> ports;
+  for (int i = 0; i < 128; ++i) {
+    ports.push_back(PortID(i));
+  }
+  cfg::SwitchConfig config =
+      utility::onePortPerVlanConfig(plat.getHwSwitch(), ports);
+  auto testHandle = createTestHandle(&config, flags);
+  auto sw = testHandle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  sw->fibSynced();
+  ThriftHandler handler(sw);
+
+  std::vector<std::vector<UnicastRoute>> routeChunks;
+  size_t numRoutes = 0;
+  for (const auto& chunk :
+       Generator(sw->getAppliedState(), kChunkSize, kEcmpWidth).get()) {
+    std::vector<UnicastRoute> routesToAdd;
+    for (const auto& route : chunk) {
+      UnicastRoute routeToAdd;
+      IpPrefix prefix;
+      prefix.ip = facebook::network::toBinaryAddress(route.prefix.first);
+      prefix.prefixLength = route.prefix.second;
+      routeToAdd.set_dest(prefix);
+      routeToAdd.nextHops_ref() = nextHopsThrift(route.nhops);
+      routesToAdd.push_back(std::move(routeToAdd));
+    }
+    numRoutes += routesToAdd.size();
+    routeChunks.push_back(std::move(routesToAdd));
+  }
+
+  // Resume benchmakring post-setup.
+  suspender.dismiss();
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> clients;
+  for (auto client = 0; client < kNumClients; ++client) {
+    clients.emplace_back([&handler, &routeChunks, client]() {
+      for (size_t i = client; i < routeChunks.size(); i += kNumClients) {
+        handler.addUnicastRoutes(
+            static_cast<int16_t>(ClientID::BGPD),
+            std::make_unique<std::vector<UnicastRoute>>(routeChunks[i]));
+      }
+    });
+  }
+  for (auto& client : clients) {
+    client.join();
+  }
+  // Routes only count once they have been programmed, so wait for the hw
+  // update thread to catch up with the desired state.
+  waitForStateUpdates(sw);
+  while (sw->getAppliedState() != sw->getDesiredState()) {
+    std::this_thread::yield();
+  }
+
+  auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(
+      std::chrono::steady_clock::now() - start);
+  suspender.rehire();
+  XLOG(INFO) << numRoutes << " routes added in " << duration.count()
+             << "s: " << numRoutes / duration.count() << " routes/sec";
+}
+
+BENCHMARK(AddUnicastRoutesFSW) {
+  runAddUnicastRoutesBenchmark<utility::FSWRouteScaleGenerator>(
+      SwitchFlags::DEFAULT);
+}
+
+BENCHMARK_RELATIVE(AddUnicastRoutesFSWPipelined) {
+  runAddUnicastRoutesBenchmark<utility::FSWRouteScaleGenerator>(
+      SwitchFlags::ENABLE_STATE_UPDATE_PIPELINE);
+}
+
+BENCHMARK(AddUnicastRoutesTHAlpm) {
+  runAddUnicastRoutesBenchmark<utility::THAlpmRouteScaleGenerator>(
+      SwitchFlags::DEFAULT);
+}
+
+BENCHMARK_RELATIVE(AddUnicastRoutesTHAlpmPipelined) {
+  runAddUnicastRoutesBenchmark<utility::THAlpmRouteScaleGenerator>(
+      SwitchFlags::ENABLE_STATE_UPDATE_PIPELINE);
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  folly::runBenchmarks();
+  return EXIT_SUCCESS;
+}
@@ -24,11 +24,18 @@
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Conv.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/MacAddress.h>
+#include <folly/synchronization/Baton.h>
+#include <gflags/gflags.h>
 
 #include <algorithm>
+#include <thread>
+
+DECLARE_int32(state_update_max_batch_size);
+DECLARE_int32(state_update_max_lane_wait_ms);
 
 using namespace facebook::fboss;
 using folly::IPAddressV4;
@@ -185,3 +192,168 @@ TEST_F(SwSwitchTest, TestStateNonCoalescing) {
   // 0 neighbor entries expected, i.e. entries must be purged
   verifyReachableCnt(0);
 }
+
+TEST(SwSwitchPipelineTest, PipelinedUpdatesReachHw) {
+  auto handle = createTestHandle(
+      testStateA(), std::nullopt, SwitchFlags::ENABLE_STATE_UPDATE_PIPELINE);
+  auto sw = handle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  waitForStateUpdates(sw);
+  ASSERT_TRUE(sw->isStateUpdatePipelineEnabled());
+
+  auto origState = sw->getAppliedState();
+  sw->updateState(
+      "Bring Ports Up", [](const std::shared_ptr<SwitchState>& state) {
+        return bringAllPortsUp(state);
+      });
+  sw->updateStateNoCoalescing(
+      "Bring Ports Down", [](const std::shared_ptr<SwitchState>& state) {
+        return bringAllPortsDown(state);
+      });
+  waitForStateUpdates(sw);
+  // Desired state is published by the update thread, hardware programming
+  // catches up from the hw update thread.
+  auto desiredState = sw->getDesiredState();
+  EXPECT_GT(desiredState->getGeneration(), origState->getGeneration());
+  while (sw->getAppliedState() != desiredState) {
+    std::this_thread::yield();
+  }
+  for (const auto& port : *sw->getAppliedState()->getPorts()) {
+    EXPECT_FALSE(port->isUp());
+  }
+}
+
+TEST(SwSwitchBatchingTest, BatchSizeLimitsCoalescing) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_update_max_batch_size = 2;
+  auto handle = createTestHandle(testStateA());
+  auto sw = handle->getSw();
+  sw->initialConfigApplied(std::chrono::steady_clock::now());
+  waitForStateUpdates(sw);
+
+  folly::Baton<> updateThreadBlocked;
+  folly::Baton<> unblockUpdateThread;
+  sw->getUpdateEvb()->runInEventBaseThread([&]() {
+    updateThreadBlocked.post();
+    unblockUpdateThread.wait();
+  });
+  updateThreadBlocked.wait();
+  // 5 coalescible updates, each changing the state, should get programmed
+  // in batches of 2, 2 and 1.
+  EXPECT_HW_CALL(sw, stateChanged(_)).Times(3);
+  for (auto i = 0; i < 5; ++i) {
+    sw->updateState(
+        folly::to<std::string>("Toggle Ports ", i),
+        [i](const std::shared_ptr<SwitchState>& state) {
+          return i % 2 ? bringAllPortsDown(state) : bringAllPortsUp(state);
+        });
+  }
+  unblockUpdateThread.post();
+  waitForStateUpdates(sw);
+  for (const auto& port : *sw->getState()->getPorts()) {
+    EXPECT_TRUE(port->isUp());
+  }
+}
+
+TEST_F(SwSwitchTest, HighPriorityUpdatesRunFirst) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_update_max_lane_wait_ms = 0;
+  std::vector<std::string> applied;
+  auto recordUpdate = [&applied](const std::string& name) {
+    return [&applied, name](const std::shared_ptr<SwitchState>& /*state*/)
+               -> std::shared_ptr<SwitchState> {
+      applied.push_back(name);
+      return nullptr;
+    };
+  };
+  // Hold the update thread, so that all of the updates below are pending
+  // by the time it gets to them.
+  folly::Baton<> updateThreadBlocked;
+  folly::Baton<> unblockUpdateThread;
+  sw->getUpdateEvb()->runInEventBaseThread([&]() {
+    updateThreadBlocked.post();
+    unblockUpdateThread.wait();
+  });
+  updateThreadBlocked.wait();
+  sw->updateState("low1", recordUpdate("low1"), StateUpdate::Priority::LOW);
+  sw->updateState("normal", recordUpdate("normal"));
+  sw->updateState("low2", recordUpdate("low2"), StateUpdate::Priority::LOW);
+  sw->updateState("high", recordUpdate("high"), StateUpdate::Priority::HIGH);
+  unblockUpdateThread.post();
+  waitForStateUpdates(sw);
+
+  std::vector<std::string> expected{"high", "normal", "low1", "low2"};
+  ASSERT_EQ(expected.size(), applied.size());
+  EXPECT_EQ(expected, applied);
+}
+
+TEST_F(SwSwitchTest, LowPriorityLaneAges) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_state_update_max_lane_wait_ms = 1;
+  std::vector<std::string> applied;
+  auto recordUpdate = [&applied](const std::string& name) {
+    return [&applied, name](const std::shared_ptr<SwitchState>& /*state*/)
+               -> std::shared_ptr<SwitchState> {
+      applied.push_back(name);
+      return nullptr;
+    };
+  };
+  folly::Baton<> updateThreadBlocked;
+  folly::Baton<> unblockUpdateThread;
+  sw->getUpdateEvb()->runInEventBaseThread([&]() {
+    updateThreadBlocked.post();
+    unblockUpdateThread.wait();
+  });
+  updateThreadBlocked.wait();
+  sw->updateState("low", recordUpdate("low"), StateUpdate::Priority::LOW);
+  // Past the longest a lane is made to wait
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  sw->updateState("high", recordUpdate("high"), StateUpdate::Priority::HIGH);
+  unblockUpdateThread.post();
+  waitForStateUpdates(sw);
+
+  std::vector<std::string> expected{"low", "high"};
+  ASSERT_EQ(expected.size(), applied.size());
+  EXPECT_EQ(expected, applied);
+}
+
+TEST_F(SwSwitchTest, HwOutOfSyncDoesNotStallOtherLanes) {
+  auto origState = sw->getAppliedState();
+  auto newState = bringAllPortsUp(origState->clone());
+  EXPECT_HW_CALL(sw, stateChanged(_)).WillRepeatedly(Return(origState));
+  sw->updateState(
+      "Reject update",
+      [=](const std::shared_ptr<SwitchState>& /*state*/) { return newState; });
+  waitForStateUpdates(sw);
+  EXPECT_NE(sw->getAppliedState(), sw->getDesiredState());
+
+  // The update to get hw back in sync is queued without scheduling a batch
+  // of its own. It must not take the batch of the next update, which would
+  // then never be applied and block its caller forever.
+  EXPECT_HW_CALL(sw, stateChanged(_)).WillRepeatedly(Return(newState));
+  bool blockingApplied = false;
+  sw->updateStateBlocking(
+      "blocking low",
+      [&blockingApplied, newState](
+          const std::shared_ptr<SwitchState>& /*state*/) {
+        blockingApplied = true;
+        return newState;
+      },
+      StateUpdate::Priority::LOW);
+  EXPECT_TRUE(blockingApplied);
+  EXPECT_EQ(sw->getAppliedState(), sw->getDesiredState());
+
+  std::vector<std::string> applied;
+  auto recordUpdate = [&applied](const std::string& name) {
+    return [&applied, name](const std::shared_ptr<SwitchState>& /*state*/)
+               -> std::shared_ptr<SwitchState> {
+      applied.push_back(name);
+      return nullptr;
+    };
+  };
+  sw->updateState("high", recordUpdate("high"), StateUpdate::Priority::HIGH);
+  sw->updateState("low", recordUpdate("low"), StateUpdate::Priority::LOW);
+  waitForStateUpdates(sw);
+  std::vector<std::string> expected{"high", "low"};
+  EXPECT_EQ(expected, applied);
+}
@@ -203,10 +203,11 @@ MockPlatform* getMockPlatform(std::unique_ptr<SwSwitch>& sw) {
 }
 
 std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw) {
-  // All StateUpdates scheduled from this thread will be applied in order,
-  // so we can simply perform a blocking no-op update.  When it is done
-  // we can be sure that all previously scheduled updates have also been
-  // applied.
+  // All StateUpdates scheduled from this thread will be applied in order
+  // within their priority lane, and higher priority lanes are always drained
+  // first. So we can simply perform a blocking no-op update in the lowest
+  // priority lane.  When it is done we can be sure that all previously
+  // scheduled updates have also been applied.
   std::shared_ptr<SwitchState> snapshot{nullptr};
   auto snapshotUpdate = [&snapshot](const shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
@@ -214,7 +215,8 @@ std::shared_ptr<SwitchState> waitForStateUpdates(SwSwitch* sw) {
     snapshot = state;
     return nullptr;
   };
-  sw->updateStateBlocking("waitForStateUpdates", snapshotUpdate);
+  sw->updateStateBlocking(
+      "waitForStateUpdates", snapshotUpdate, StateUpdate::Priority::LOW);
   return snapshot;
 }
 
@@ -0,0 +1,127 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include <folly/Indestructible.h>
+#include <folly/Synchronized.h>
+
+namespace facebook::fboss {
+
+/*
+ * Interner keeps a single shared copy of each distinct value of T, for
+ * values which many objects hold equal copies of, such as the next hop set
+ * of routes: a few hundred ECMP groups are shared by most of the routes of
+ * a switch.
+ *
+ * intern() returns the shared copy equal to the value it is given, so two
+ * interned values are equal if and only if they are the same object, and
+ * can be compared or keyed on by address. A copy is freed once nothing
+ * refers to it anymore. Like RefMap, but process wide and thread safe, as
+ * interned values are created and dropped from any thread.
+ *
+ * Values are spread over kNumShards tables by Hash, each with its own lock,
+ * so that threads interning different values rarely wait on one another.
+ * Looking up a value that is already interned, the common case, only takes
+ * a read lock.
+ *
+ * T must be ordered by operator<, and Hash must agree with it: equal values
+ * hash the same.
+ */
+template <typename T, typename Hash = std::hash<T>>
+class Interner {
+ public:
+  using Handle = std::shared_ptr<const T>;
+
+  static constexpr size_t kNumShards = 16;
+
+  static Handle intern(T value) {
+    auto& shard = shardOf(value);
+    {
+      auto locked = shard.rlock();
+      auto itr = locked->find(value);
+      if (itr != locked->end()) {
+        if (auto handle = itr->second.lock()) {
+          return handle;
+        }
+      }
+    }
+    auto locked = shard.wlock();
+    auto itr = locked->find(value);
+    if (itr != locked->end()) {
+      if (auto handle = itr->second.lock()) {
+        return handle;
+      }
+      // Last reference is being dropped, its deleter will leave the new
+      // copy alone
+    } else {
+      itr = locked->emplace(value, std::weak_ptr<const T>()).first;
+    }
+    Handle handle(new T(std::move(value)), &Interner::release);
+    itr->second = handle;
+    return handle;
+  }
+
+  // Interned T(), which is never freed
+  static const Handle& defaultValue() {
+    static const folly::Indestructible<Handle> handle(intern(T()));
+    return *handle;
+  }
+
+  // Whether handle is the interned copy of its value, rather than another
+  // copy that happens to be equal to it
+  static bool isInterned(const Handle& handle) {
+    auto locked = shardOf(*handle).rlock();
+    auto itr = locked->find(*handle);
+    return itr != locked->end() && itr->second.lock() == handle;
+  }
+
+  // Number of distinct values currently interned
+  static size_t size() {
+    size_t size = 0;
+    for (const auto& shard : shards()) {
+      size += shard.rlock()->size();
+    }
+    return size;
+  }
+
+ private:
+  using Table = std::map<T, std::weak_ptr<const T>>;
+  using Shard = folly::Synchronized<Table>;
+
+  static std::array<Shard, kNumShards>& shards() {
+    static folly::Indestructible<std::array<Shard, kNumShards>> shards;
+    return *shards;
+  }
+
+  static Shard& shardOf(const T& value) {
+    return shards()[Hash()(value) % kNumShards];
+  }
+
+  static void release(const T* value) {
+    {
+      auto locked = shardOf(*value).wlock();
+      auto itr = locked->find(*value);
+      // Unless the value was interned again since the last reference to
+      // this copy was dropped
+      if (itr != locked->end() && itr->second.expired()) {
+        locked->erase(itr);
+      }
+    }
+    delete value;
+  }
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,432 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/Range.h>
+
+#include "fboss/lib/RadixTree.h"
+
+namespace facebook::network {
+
+/*
+ * MultibitTrie is a longest prefix match table for IPv4 or IPv6 addresses,
+ * built from a set of prefixes, e.g. from a RadixTree, and then kept up to
+ * date with update().
+ *
+ * RadixTree is a binary trie with a heap allocated node per prefix, so a
+ * lookup chases a pointer per bit of the prefix it matches. MultibitTrie
+ * is a multibit trie instead, where each node is indexed by a byte of the
+ * address. Each slot of a node holds the longest prefix ending in that node
+ * which covers it, if any, and the node for the next byte, if any, so a
+ * lookup takes one step per byte: three for a /24 in IPv4.
+ *
+ * As in Poptrie, nodes are stored compressed. Neighbouring slots mostly
+ * hold the same thing, so a node only stores a bitmap of the slots where a
+ * new run of slots starts, and the content of each run. A slot is found by
+ * counting the bits set in the bitmap up to it.
+ *
+ * Nodes are immutable and shared between copies of a trie, so copying one
+ * is cheap. update() builds new versions of the nodes the changed prefixes
+ * end in, and of the nodes above them, and shares all other nodes with the
+ * trie it was copied from, so it takes time proportional to the number of
+ * changed prefixes, and readers of earlier copies are not affected. A
+ * MultibitTrie may be read from multiple threads at once, but only updated
+ * by one.
+ */
+template <typename IPADDRTYPE, typename VALUE>
+class MultibitTrie {
+ public:
+  struct Prefix {
+    IPADDRTYPE network;
+    uint8_t mask;
+    VALUE value;
+  };
+
+  /*
+   * Set the value of a prefix, or remove the prefix if value is unset.
+   */
+  struct Change {
+    IPADDRTYPE network;
+    uint8_t mask;
+    std::optional<VALUE> value;
+  };
+
+  MultibitTrie() = default;
+
+  /*
+   * Prefixes may come in any order, but must be distinct.
+   */
+  explicit MultibitTrie(std::vector<Prefix> prefixes) {
+    std::vector<Change> changes;
+    changes.reserve(prefixes.size());
+    for (auto& prefix : prefixes) {
+      changes.push_back(
+          Change{prefix.network, prefix.mask, std::move(prefix.value)});
+    }
+    update(std::move(changes));
+  }
+
+  static MultibitTrie fromRadixTree(const RadixTree<IPADDRTYPE, VALUE>& tree) {
+    std::vector<Prefix> prefixes;
+    prefixes.reserve(tree.size());
+    for (const auto& node : tree) {
+      prefixes.push_back(Prefix{node.ipAddress(),
+                                static_cast<uint8_t>(node.masklen()),
+                                node.value()});
+    }
+    return MultibitTrie(std::move(prefixes));
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  /*
+   * Apply changes, at most one per prefix. Removing a prefix that is not
+   * in the trie is a no-op.
+   */
+  void update(std::vector<Change> changes) {
+    std::vector<PendingChange> pending;
+    pending.reserve(changes.size());
+    for (auto& change : changes) {
+      CHECK_LE(change.mask, IPADDRTYPE::bitCount());
+      pending.push_back(PendingChange{
+          change.network.mask(change.mask).toByteArray(),
+          change.mask,
+          std::move(change.value)});
+    }
+    // Preorder, so that the changes below each node are contiguous
+    std::sort(
+        pending.begin(), pending.end(), [](const auto& a, const auto& b) {
+          return std::tie(a.bytes, a.mask) < std::tie(b.bytes, b.mask);
+        });
+    root_ = updateNode(root_, pending, 0, pending.size(), 0);
+  }
+
+  /*
+   * Value of the longest prefix containing addr, or nullptr if none does.
+   */
+  const VALUE* longestMatch(const IPADDRTYPE& addr) const {
+    auto bytes = addr.toByteArray();
+    const VALUE* match = nullptr;
+    const Node* node = root_.get();
+    for (size_t byte = 0; node; ++byte) {
+      const auto& run = node->runs[runIndex(*node, bytes[byte])];
+      if (run.ending) {
+        match = &node->endings[run.ending - 1].value;
+      }
+      node = run.child ? node->children[run.child - 1].get() : nullptr;
+    }
+    return match;
+  }
+
+  /*
+   * Look up each of addrs into the same position of results, which must
+   * have room for all of them. Lookups are interleaved in small batches,
+   * so that their cache misses overlap rather than follow one another.
+   */
+  void longestMatch(
+      folly::Range<const IPADDRTYPE*> addrs,
+      const VALUE** results) const {
+    constexpr size_t kBatchSize = 16;
+    std::array<ByteArray, kBatchSize> bytes;
+    std::array<const Node*, kBatchSize> nodes;
+    std::array<size_t, kBatchSize> slots;
+    std::array<size_t, kBatchSize> runs;
+
+    for (size_t begin = 0; begin < addrs.size(); begin += kBatchSize) {
+      auto count = std::min(kBatchSize, addrs.size() - begin);
+      for (size_t i = 0; i < count; ++i) {
+        bytes[i] = addrs[begin + i].toByteArray();
+        nodes[i] = root_.get();
+        slots[i] = bytes[i][0];
+        results[begin + i] = nullptr;
+      }
+      for (size_t byte = 1;; ++byte) {
+        bool descending = false;
+        for (size_t i = 0; i < count; ++i) {
+          if (nodes[i]) {
+            __builtin_prefetch(&nodes[i]->words[slots[i] / 64]);
+            descending = true;
+          }
+        }
+        if (!descending) {
+          break;
+        }
+        for (size_t i = 0; i < count; ++i) {
+          if (nodes[i]) {
+            runs[i] = runIndex(*nodes[i], slots[i]);
+            __builtin_prefetch(&nodes[i]->runs[runs[i]]);
+          }
+        }
+        for (size_t i = 0; i < count; ++i) {
+          if (!nodes[i]) {
+            continue;
+          }
+          const auto& run = nodes[i]->runs[runs[i]];
+          if (run.ending) {
+            results[begin + i] = &nodes[i]->endings[run.ending - 1].value;
+          }
+          nodes[i] =
+              run.child ? nodes[i]->children[run.child - 1].get() : nullptr;
+          if (nodes[i]) {
+            slots[i] = bytes[i][byte];
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  using ByteArray = decltype(std::declval<IPADDRTYPE>().toByteArray());
+
+  static constexpr size_t kStrideBits = 8;
+  static constexpr size_t kNumSlots = size_t(1) << kStrideBits;
+
+  struct PendingChange {
+    ByteArray bytes;
+    uint8_t mask;
+    std::optional<VALUE> value;
+  };
+
+  /*
+   * A prefix ending in a node, i.e. whose last bit is one of the bits the
+   * node is indexed by. It covers the 2^(endBit - mask) slots from
+   * firstSlot.
+   */
+  struct Ending {
+    uint8_t firstSlot;
+    uint8_t mask;
+    VALUE value;
+  };
+
+  /*
+   * 64 slots of a node: the bitmap of the slots where a run starts, and
+   * the index in runs of the first run starting in this word.
+   */
+  struct Word {
+    uint64_t runStarts;
+    uint32_t firstRun;
+  };
+
+  /*
+   * Content of a run of slots: one more than the index of the longest
+   * ending covering them and of the node below them, or 0 for none.
+   */
+  struct Run {
+    uint32_t ending;
+    uint32_t child;
+  };
+
+  struct Node {
+    // Sorted by mask, then firstSlot
+    std::vector<Ending> endings;
+    std::vector<std::shared_ptr<const Node>> children;
+    std::array<Word, kNumSlots / 64> words;
+    std::vector<Run> runs;
+  };
+
+  static size_t runIndex(const Node& node, size_t slot) {
+    const auto& word = node.words[slot / 64];
+    // Runs started at or before slot within this word
+    auto runsUpToSlot = word.runStarts & (~uint64_t(0) >> (63 - slot % 64));
+    return word.firstRun + __builtin_popcountll(runsUpToSlot) - 1;
+  }
+  // First slot of the ending of mask covering slot
+  static uint32_t firstSlotOf(size_t slot, uint8_t mask, size_t endBit) {
+    return slot & ~((size_t(1) << (endBit - mask)) - 1);
+  }
+  static typename std::vector<Ending>::iterator
+  findEnding(std::vector<Ending>& endings, uint32_t firstSlot, uint8_t mask) {
+    auto itr = std::lower_bound(
+        endings.begin(),
+        endings.end(),
+        std::make_pair(mask, firstSlot),
+        [](const Ending& ending, const auto& key) {
+          return std::tie(ending.mask, ending.firstSlot) <
+              std::tie(key.first, key.second);
+        });
+    if (itr != endings.end() && itr->mask == mask &&
+        itr->firstSlot == firstSlot) {
+      return itr;
+    }
+    return endings.end();
+  }
+
+  /*
+   * Return a copy of node, or a new node if it is null, for the given byte
+   * of the address, with those of changes [first, last) that end in it
+   * applied. The changes ending below the node are applied to its
+   * children the same way. Returns null if the node ends up empty.
+   *
+   * Each slot of the uncompressed node is tracked by the mask of its longest
+   * covering ending, which together with the slot identifies the ending.
+   */
+  std::shared_ptr<const Node> updateNode(
+      const std::shared_ptr<const Node>& node,
+      std::vector<PendingChange>& changes,
+      size_t first,
+      size_t last,
+      size_t byte) {
+    if (first == last) {
+      return node;
+    }
+    size_t startBit = byte * kStrideBits;
+    size_t endBit = startBit + kStrideBits;
+    // Prefixes ending above the node were handled above it, except at the
+    // root, which is where a default route ends
+    int minMask = startBit == 0 ? 0 : startBit + 1;
+    std::array<int16_t, kNumSlots> slotMasks;
+    slotMasks.fill(-1);
+    // Children are only pointed to until the node is compressed, so that
+    // each is copied once rather than once per slot
+    std::array<const std::shared_ptr<const Node>*, kNumSlots> slotChildren{};
+    std::deque<std::shared_ptr<const Node>> updatedChildren;
+    std::vector<Ending> endings;
+    if (node) {
+      endings = node->endings;
+      auto run = node->runs.end();
+      for (size_t slot = 0; slot < kNumSlots; ++slot) {
+        if (node->words[slot / 64].runStarts & (uint64_t(1) << (slot % 64))) {
+          run = run == node->runs.end() ? node->runs.begin() : run + 1;
+        }
+        if (run->ending) {
+          slotMasks[slot] = node->endings[run->ending - 1].mask;
+        }
+        if (run->child) {
+          slotChildren[slot] = &node->children[run->child - 1];
+        }
+      }
+    }
+
+    for (auto i = first; i < last; ++i) {
+      auto& change = changes[i];
+      if (change.mask < minMask || change.mask > endBit) {
+        continue;
+      }
+      size_t firstSlot = change.bytes[byte];
+      auto begin = slotMasks.begin() + firstSlot;
+      auto end = begin + (size_t(1) << (endBit - change.mask));
+      auto ending = findEnding(endings, firstSlot, change.mask);
+      if (change.value) {
+        if (ending != endings.end()) {
+          ending->value = std::move(*change.value);
+          continue;
+        }
+        auto pos = std::upper_bound(
+            endings.begin(),
+            endings.end(),
+            std::make_pair(change.mask, firstSlot),
+            [](const auto& key, const Ending& e) {
+              return std::tie(key.first, key.second) <
+                  std::tie(e.mask, e.firstSlot);
+            });
+        endings.insert(
+            pos,
+            Ending{static_cast<uint8_t>(firstSlot),
+                   change.mask,
+                   std::move(*change.value)});
+        ++size_;
+        // Slots covered by a longer prefix keep it
+        std::replace_if(
+            begin,
+            end,
+            [&](int16_t mask) { return mask < change.mask; },
+            change.mask);
+      } else if (ending != endings.end()) {
+        endings.erase(ending);
+        --size_;
+        // Slots it was the longest match for now fall back to the longest
+        // prefix containing it, if that also ends in this node
+        int16_t covering = -1;
+        for (int mask = change.mask - 1; mask >= minMask; --mask) {
+          if (findEnding(endings, firstSlotOf(firstSlot, mask, endBit), mask) !=
+              endings.end()) {
+            covering = mask;
+            break;
+          }
+        }
+        std::replace(begin, end, int16_t(change.mask), covering);
+      }
+    }
+
+    // Changes ending below this node, by the slot they go through
+    for (auto i = first; i < last;) {
+      if (changes[i].mask <= endBit) {
+        ++i;
+        continue;
+      }
+      auto slot = changes[i].bytes[byte];
+      auto j = i + 1;
+      while (j < last && changes[j].bytes[byte] == slot) {
+        ++j;
+      }
+      auto child = updateNode(
+          slotChildren[slot] ? *slotChildren[slot] : nullptr,
+          changes,
+          i,
+          j,
+          byte + 1);
+      slotChildren[slot] = nullptr;
+      if (child) {
+        updatedChildren.push_back(std::move(child));
+        slotChildren[slot] = &updatedChildren.back();
+      }
+      i = j;
+    }
+
+    // Compress the slots into runs
+    auto updated = std::make_shared<Node>();
+    updated->endings = std::move(endings);
+    for (size_t slot = 0; slot < kNumSlots; ++slot) {
+      auto mask = slotMasks[slot];
+      auto& word = updated->words[slot / 64];
+      if (slot % 64 == 0) {
+        word = Word{0, static_cast<uint32_t>(updated->runs.size())};
+      }
+      if (slot > 0 && mask == slotMasks[slot - 1] &&
+          (mask < 0 ||
+           firstSlotOf(slot, mask, endBit) ==
+               firstSlotOf(slot - 1, mask, endBit)) &&
+          slotChildren[slot] == slotChildren[slot - 1]) {
+        continue;
+      }
+      Run run{0, 0};
+      if (mask >= 0) {
+        auto ending = findEnding(
+            updated->endings, firstSlotOf(slot, mask, endBit), mask);
+        DCHECK(ending != updated->endings.end());
+        run.ending = ending - updated->endings.begin() + 1;
+      }
+      if (slotChildren[slot]) {
+        updated->children.push_back(*slotChildren[slot]);
+        run.child = updated->children.size();
+      }
+      word.runStarts |= uint64_t(1) << (slot % 64);
+      updated->runs.push_back(run);
+    }
+    if (updated->endings.empty() && updated->children.empty()) {
+      return nullptr;
+    }
+    return updated;
+  }
+
+  std::shared_ptr<const Node> root_;
+  size_t size_{0};
+};
+
+} // namespace facebook::network
@@ -146,7 +146,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
       // specific root.
       auto prefix = IPADDRTYPE::longestCommonPrefix(
           {root_->ipAddress(), root_->masklen()}, {toAdd, mask});
-      std::unique_ptr<TreeNode> newRoot = nullptr;
+      NodePtr newRoot = nullptr;
       if (prefix.first == toAdd && prefix.second == mask) {
         // To be added node is the new root
         newRoot = std::move(newNode);
@@ -217,7 +217,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         // bestMatchChild and new node.
         auto internalNode = makeNode(prefix.first, prefix.second);
         auto internalNodeRaw = internalNode.get();
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(internalNode));
         } else {
@@ -237,7 +237,7 @@ RadixTree<IPADDRTYPE, T, TreeTraits>::insert(
         CHECK(internalNode == nullptr);
       } else {
         // New node needs to be inserted  b/w bestMatch and bestMatchChild
-        std::unique_ptr<TreeNode> oldBestMatchChild = nullptr;
+        NodePtr oldBestMatchChild = nullptr;
         if (toAddDirection == TreeDirection::LEFT) {
           oldBestMatchChild = bestMatch->resetLeft(std::move(newNode));
         } else {
@@ -386,6 +386,164 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::erase(TreeNode* toDelete) {
   return true;
 }
 
+template <typename IPADDRTYPE, typename T, typename TreeTraits>
+size_t RadixTree<IPADDRTYPE, T, TreeTraits>::bulkInsert(
+    std::vector<std::tuple<IPADDRTYPE, uint8_t, T>> entries) {
+  size_t inserted = 0;
+  if (root_) {
+    for (auto& [ipaddr, mask, value] : entries) {
+      inserted += insert(ipaddr, mask, std::move(value)).second;
+    }
+    return inserted;
+  }
+  for (auto& [ipaddr, mask, value] : entries) {
+    ipaddr = ipaddr.mask(mask);
+  }
+  // In preorder: a prefix ahead of the more specific ones within it, and
+  // the left (0 bit) side of a prefix ahead of its right side. Stable, so
+  // that the first of duplicate entries wins, as with insert.
+  std::stable_sort(
+      entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return std::tie(std::get<0>(a), std::get<1>(a)) <
+            std::tie(std::get<0>(b), std::get<1>(b));
+      });
+  // At most one non value node per branch, so one less than value nodes
+  if (!entries.empty()) {
+    pool().reserve(2 * entries.size() - 1);
+  }
+
+  // Path from the root to the last node added. Later prefixes only ever
+  // hang off this path, as they are to the right of everything else.
+  std::vector<TreeNode*> path;
+  path.reserve(IPADDRTYPE::bitCount() + 1);
+  for (auto& [ipaddr, mask, value] : entries) {
+    // Go up to the deepest node containing the prefix. The last node
+    // passed on the way, if any, is its child on the path.
+    TreeNode* lastChild = nullptr;
+    while (!path.empty() &&
+           path.back()->searchDirection(ipaddr, mask) ==
+               TreeDirection::PARENT) {
+      lastChild = path.back();
+      path.pop_back();
+    }
+    auto parent = path.empty() ? nullptr : path.back();
+    if (parent &&
+        parent->searchDirection(ipaddr, mask) == TreeDirection::THIS_NODE) {
+      // Duplicate prefix
+      continue;
+    }
+
+    auto newNode = makeNode(ipaddr, mask, std::move(value));
+    auto newNodeRaw = newNode.get();
+    if (!lastChild) {
+      // parent is the last node added, so has no children yet
+      if (!parent) {
+        makeRoot(std::move(newNode));
+      } else if (
+          parent->searchDirection(newNodeRaw) == TreeDirection::LEFT) {
+        parent->resetLeft(std::move(newNode));
+      } else {
+        parent->resetRight(std::move(newNode));
+      }
+    } else {
+      // The new node sorts after lastChild, so goes to its right, where
+      // their prefixes part.
+      auto prefix = IPADDRTYPE::longestCommonPrefix(
+          {lastChild->ipAddress(), lastChild->masklen()}, {ipaddr, mask});
+      if (parent && prefix.second == parent->masklen()) {
+        // lastChild is the left child of parent
+        DCHECK(parent->right() == nullptr);
+        parent->resetRight(std::move(newNode));
+      } else {
+        // Insert a non value internal node in place of lastChild, as the
+        // parent of lastChild and new node.
+        auto internalNode = makeNode(prefix.first, prefix.second);
+        auto internalNodeRaw = internalNode.get();
+        NodePtr oldLastChild = nullptr;
+        if (!parent) {
+          oldLastChild = std::move(root_);
+          makeRoot(std::move(internalNode));
+        } else if (parent->left() == lastChild) {
+          oldLastChild = parent->resetLeft(std::move(internalNode));
+        } else {
+          oldLastChild = parent->resetRight(std::move(internalNode));
+        }
+        internalNodeRaw->resetLeft(std::move(oldLastChild));
+        internalNodeRaw->resetRight(std::move(newNode));
+        path.push_back(internalNodeRaw);
+      }
+    }
+    CHECK(newNode == nullptr);
+    path.push_back(newNodeRaw);
+    ++size_;
+    ++inserted;
+  }
+  return inserted;
+}
+
+template <typename IPADDRTYPE, typename T, typename TreeTraits>
+size_t RadixTree<IPADDRTYPE, T, TreeTraits>::bulkErase(
+    std::vector<std::pair<IPADDRTYPE, uint8_t>> prefixes) {
+  for (auto& [ipaddr, mask] : prefixes) {
+    ipaddr = ipaddr.mask(mask);
+  }
+  // Preorder, the order in which bulkEraseSubTree comes across them
+  std::sort(prefixes.begin(), prefixes.end());
+  auto sizeBefore = size_;
+  auto prefix = prefixes.cbegin();
+  makeRoot(bulkEraseSubTree(std::move(root_), prefix, prefixes.cend()));
+  return sizeBefore - size_;
+}
+
+template <typename IPADDRTYPE, typename T, typename TreeTraits>
+typename RadixTree<IPADDRTYPE, T, TreeTraits>::NodePtr
+RadixTree<IPADDRTYPE, T, TreeTraits>::bulkEraseSubTree(
+    NodePtr node,
+    typename std::vector<std::pair<IPADDRTYPE, uint8_t>>::const_iterator&
+        prefix,
+    typename std::vector<std::pair<IPADDRTYPE, uint8_t>>::const_iterator
+        end) {
+  if (!node) {
+    return node;
+  }
+  // Prefixes ahead of this subtree, which are not in the tree
+  std::pair<IPADDRTYPE, uint8_t> nodePrefix{node->ipAddress(),
+                                            node->masklen()};
+  while (prefix != end &&
+         node->searchDirection(prefix->first, prefix->second) ==
+             TreeDirection::PARENT &&
+         *prefix < nodePrefix) {
+    ++prefix;
+  }
+  if (prefix == end ||
+      node->searchDirection(prefix->first, prefix->second) ==
+          TreeDirection::PARENT) {
+    // Nothing to erase in this subtree
+    return node;
+  }
+  auto eraseThis = false;
+  if (*prefix == nodePrefix) {
+    eraseThis = node->isValueNode();
+    ++prefix;
+  }
+  node->resetLeft(bulkEraseSubTree(node->resetLeft(nullptr), prefix, end));
+  node->resetRight(bulkEraseSubTree(node->resetRight(nullptr), prefix, end));
+
+  // Same outcome as erase(), with the children already taken care of
+  auto hasBothChildren = node->left() && node->right();
+  if (eraseThis) {
+    --size_;
+    if (hasBothChildren) {
+      node->makeNonValueNode();
+      return node;
+    }
+  } else if (node->isValueNode() || hasBothChildren) {
+    return node;
+  }
+  // Erased or non value node with at most one child, which replaces it
+  return node->left() ? node->resetLeft(nullptr) : node->resetRight(nullptr);
+}
+
 template <typename IPADDRTYPE, typename T, typename TreeTraits>
 bool RadixTree<IPADDRTYPE, T, TreeTraits>::radixSubTreesEqual(
     const TreeNode* nodeA,
@@ -402,21 +560,16 @@ bool RadixTree<IPADDRTYPE, T, TreeTraits>::radixSubTreesEqual(
 }
 
 template <typename IPADDRTYPE, typename T, typename TreeTraits>
-std::unique_ptr<typename RadixTree<IPADDRTYPE, T, TreeTraits>::TreeNode>
+typename RadixTree<IPADDRTYPE, T, TreeTraits>::NodePtr
 RadixTree<IPADDRTYPE, T, TreeTraits>::cloneSubTree(const TreeNode* node) {
   if (!node) {
     return nullptr;
   }
-  std::unique_ptr<TreeNode> copy;
+  NodePtr copy;
   if (node->isValueNode()) {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(),
-        node->masklen(),
-        node->value(),
-        node->nodeDeleteCallback());
+    copy = makeNode(node->ipAddress(), node->masklen(), node->value());
   } else {
-    copy = std::make_unique<TreeNode>(
-        node->ipAddress(), node->masklen(), node->nodeDeleteCallback());
+    copy = makeNode(node->ipAddress(), node->masklen());
   }
   copy->resetLeft(cloneSubTree(node->left()));
   copy->resetRight(cloneSubTree(node->right()));
@@ -9,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -19,9 +20,22 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <folly/Memory.h>
+#include <folly/ScopeGuard.h>
 #include <optional>
 
 namespace facebook::network {
+
+template <typename IPADDRTYPE, typename T>
+class RadixTreeNode;
+template <typename IPADDRTYPE, typename T>
+class RadixTreeNodePool;
+
+// Returns a node to the pool it was allocated from
+template <typename IPADDRTYPE, typename T>
+struct RadixTreeNodeDeleter {
+  void operator()(RadixTreeNode<IPADDRTYPE, T>* node) const;
+};
+
 /*
  * Node in RadixTree, holds IP, mask. Will hold  value for nodes
  * created as a result of user inserts. Other type of nodes are
@@ -32,32 +46,26 @@ namespace facebook::network {
 template <typename IPADDRTYPE, typename T>
 class RadixTreeNode {
  public:
-  // Optional function parameter to call from destructor
+  // Optional function parameter to call before a node is destroyed
   typedef std::function<void(const RadixTreeNode<IPADDRTYPE, T>&)>
       NodeDeleteCallback;
+  typedef RadixTreeNodePool<IPADDRTYPE, T> NodePool;
+  typedef std::unique_ptr<RadixTreeNode, RadixTreeNodeDeleter<IPADDRTYPE, T>>
+      NodePtr;
 
-  RadixTreeNode(
-      const IPADDRTYPE& ipAddr,
-      uint8_t mlen,
-      NodeDeleteCallback deleteCallback)
-      : ipAddress_(ipAddr), masklen_(mlen), deleteCallback_(deleteCallback) {}
+  RadixTreeNode(NodePool* pool, const IPADDRTYPE& ipAddr, uint8_t mlen)
+      : ipAddress_(ipAddr), masklen_(mlen), pool_(pool) {}
 
   template <typename VALUE>
   RadixTreeNode(
+      NodePool* pool,
       const IPADDRTYPE& ipAddr,
       uint8_t mlen,
-      VALUE&& val,
-      NodeDeleteCallback deleteCallback)
+      VALUE&& val)
       : ipAddress_(ipAddr),
         masklen_(mlen),
         value_(std::forward<VALUE>(val)),
-        deleteCallback_(deleteCallback) {}
-
-  ~RadixTreeNode() {
-    if (deleteCallback_) {
-      deleteCallback_(*this);
-    }
-  }
+        pool_(pool) {}
 
   enum class TreeDirection { LEFT, RIGHT, PARENT, THIS_NODE };
 
@@ -101,7 +109,10 @@ class RadixTreeNode {
     return value_.value();
   }
   NodeDeleteCallback nodeDeleteCallback() const {
-    return deleteCallback_;
+    return pool_->deleteCallback();
+  }
+  NodePool* pool() const {
+    return pool_;
   }
   std::string str(bool printValue = true) const {
     auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
@@ -129,8 +140,7 @@ class RadixTreeNode {
         (!isValueNode() || this->value() == r.value());
   }
 
-  std::unique_ptr<RadixTreeNode> resetLeft(
-      std::unique_ptr<RadixTreeNode> newLeft) {
+  NodePtr resetLeft(NodePtr newLeft) {
     auto old = std::move(left_);
     left_ = std::move(newLeft);
     if (left_) {
@@ -139,8 +149,7 @@ class RadixTreeNode {
     return old;
   }
 
-  std::unique_ptr<RadixTreeNode> resetRight(
-      std::unique_ptr<RadixTreeNode> newRight) {
+  NodePtr resetRight(NodePtr newRight) {
     auto old = std::move(right_);
     right_ = std::move(newRight);
     if (right_) {
@@ -166,12 +175,131 @@ class RadixTreeNode {
   IPADDRTYPE ipAddress_;
   uint32_t masklen_{0}; // Number of bits to match.
   std::optional<T> value_;
-  std::unique_ptr<RadixTreeNode> left_{nullptr};
-  std::unique_ptr<RadixTreeNode> right_{nullptr};
+  NodePtr left_{nullptr};
+  NodePtr right_{nullptr};
   RadixTreeNode* parent_{nullptr};
+  NodePool* pool_;
+};
+
+/*
+ * Allocator for the nodes of a RadixTree. Nodes are carved out of slabs
+ * of contiguous slots rather than each being a heap allocation of its own,
+ * and freed slots are kept on a free list for the next node. This keeps
+ * the nodes of a tree close together, and saves going to the heap on
+ * inserts, erases, clone and teardown of large trees such as route tables.
+ *
+ * The pool also holds the delete callback of the tree, which is called
+ * for each node before it is destroyed, so that nodes need not carry a
+ * copy of it. Slabs are only released when the pool is destroyed, which
+ * must be after all its nodes are.
+ */
+template <typename IPADDRTYPE, typename T>
+class RadixTreeNodePool {
+ public:
+  typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
+  typedef typename TreeNode::NodePtr NodePtr;
+  typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+
+  explicit RadixTreeNodePool(NodeDeleteCallback deleteCallback)
+      : deleteCallback_(std::move(deleteCallback)) {}
+  ~RadixTreeNodePool() {
+    DCHECK_EQ(size_, 0);
+  }
+
+  RadixTreeNodePool(const RadixTreeNodePool&) = delete;
+  RadixTreeNodePool& operator=(const RadixTreeNodePool&) = delete;
+
+  template <typename... Args>
+  NodePtr create(Args&&... args) {
+    auto slot = allocate();
+    SCOPE_FAIL {
+      release(slot);
+    };
+    return NodePtr(
+        new (slot->storage) TreeNode(this, std::forward<Args>(args)...));
+  }
+
+  void destroy(TreeNode* node) {
+    if (deleteCallback_) {
+      deleteCallback_(*node);
+    }
+    node->~TreeNode();
+    release(reinterpret_cast<Slot*>(node));
+  }
+
+  // Make room for count more nodes, in one slab
+  void reserve(size_t count) {
+    if (count > freeSlots_) {
+      addSlab(count - freeSlots_);
+    }
+  }
+
+  const NodeDeleteCallback& deleteCallback() const {
+    return deleteCallback_;
+  }
+  // Number of nodes allocated from the pool
+  size_t size() const {
+    return size_;
+  }
+  // Memory held by the pool, free slots included
+  size_t allocatedBytes() const {
+    return capacity_ * sizeof(Slot);
+  }
+
+ private:
+  union Slot {
+    Slot* next;
+    alignas(TreeNode) unsigned char storage[sizeof(TreeNode)];
+  };
+
+  static constexpr size_t kMinSlabSlots = 16;
+  static constexpr size_t kMaxSlabSlots = 4096;
+
+  Slot* allocate() {
+    if (!freeList_) {
+      // Grow with the pool, so that small trees stay small
+      addSlab(std::clamp(capacity_, kMinSlabSlots, kMaxSlabSlots));
+    }
+    auto slot = freeList_;
+    freeList_ = slot->next;
+    --freeSlots_;
+    ++size_;
+    return slot;
+  }
+
+  void release(Slot* slot) {
+    slot->next = freeList_;
+    freeList_ = slot;
+    ++freeSlots_;
+    --size_;
+  }
+
+  void addSlab(size_t numSlots) {
+    slabs_.push_back(std::make_unique<Slot[]>(numSlots));
+    auto slab = slabs_.back().get();
+    // Thread in reverse, so that slots are handed out in address order
+    for (size_t i = numSlots; i > 0; --i) {
+      slab[i - 1].next = freeList_;
+      freeList_ = &slab[i - 1];
+    }
+    capacity_ += numSlots;
+    freeSlots_ += numSlots;
+  }
+
   NodeDeleteCallback deleteCallback_;
+  std::vector<std::unique_ptr<Slot[]>> slabs_;
+  Slot* freeList_{nullptr};
+  size_t capacity_{0};
+  size_t freeSlots_{0};
+  size_t size_{0};
 };
 
+template <typename IPADDRTYPE, typename T>
+void RadixTreeNodeDeleter<IPADDRTYPE, T>::operator()(
+    RadixTreeNode<IPADDRTYPE, T>* node) const {
+  node->pool()->destroy(node);
+}
+
 /*
  * Forward Iterator to traverse a Radix tree
  * Traverses the tree in DFS/preorder fashion
@@ -378,6 +506,8 @@ class RadixTree {
   typedef RadixTreeNode<IPADDRTYPE, T> TreeNode;
   typedef typename TreeNode::TreeDirection TreeDirection;
   typedef typename TreeNode::NodeDeleteCallback NodeDeleteCallback;
+  typedef typename TreeNode::NodePool NodePool;
+  typedef typename TreeNode::NodePtr NodePtr;
   typedef typename TreeTraits::Iterator Iterator;
   typedef typename TreeTraits::ConstIterator ConstIterator;
   typedef typename std::vector<ConstIterator> VecConstIterators;
@@ -406,6 +536,7 @@ class RadixTree {
   // Free all nodes and clear the tree.
   void clear() {
     root_.reset(nullptr);
+    pool_.reset();
     size_ = 0;
   }
   RadixTree(RadixTree&& r) noexcept
@@ -414,9 +545,13 @@ class RadixTree {
   }
   // Move radix tree onto this
   RadixTree& operator=(RadixTree&& r) noexcept {
-    // Don't copy the traits and delete callback, use
-    // ones with which this Radix tree was created
+    // Don't copy the traits, use ones with which this Radix tree was
+    // created. The nodes of r come with the pool they were allocated from,
+    // and so with the delete callback of r, which is swapped with ours.
+    clear();
     size_ = r.size_;
+    pool_ = std::move(r.pool_);
+    nodeDeleteCallback_.swap(r.nodeDeleteCallback_);
     makeRoot(std::move(r.root_));
     r.size_ = 0;
     return *this;
@@ -430,7 +565,11 @@ class RadixTree {
         "clone template type must be the same as Radix tree value type");
     RadixTree copy(nodeDeleteCallback_, traits_);
     copy.size_ = size_;
-    copy.root_ = cloneSubTree(root_.get());
+    if (pool_) {
+      // Allocate the copy in one go
+      copy.pool().reserve(pool_->size());
+    }
+    copy.root_ = copy.cloneSubTree(root_.get());
     return copy;
   }
   /*
@@ -445,11 +584,28 @@ class RadixTree {
   std::pair<Iterator, bool>
   insert(const IPADDRTYPE& ipaddr, uint8_t masklen, VALUE&& value);
 
+  /*
+   * Insert many IP, mask, value entries at once. Into an empty tree, the
+   * entries are sorted and the tree built in a single pass, adding each
+   * node below the last one rather than looking it up from the root.
+   * Otherwise they are inserted one at a time. As with insert, entries for
+   * prefixes already in the tree (or earlier in entries) are dropped.
+   * Returns the number of entries inserted.
+   */
+  size_t bulkInsert(std::vector<std::tuple<IPADDRTYPE, uint8_t, T>> entries);
+
   // Erase a IP, mask
   bool erase(const IPADDRTYPE& ipaddr, uint8_t masklen) {
     return erase(exactMatch(ipaddr, masklen));
   }
 
+  /*
+   * Erase many IP, masks at once, in a single pass over the parts of the
+   * tree they are in. Returns the number of prefixes erased. The delete
+   * callback is called once for each node removed from the tree.
+   */
+  size_t bulkErase(std::vector<std::pair<IPADDRTYPE, uint8_t>> prefixes);
+
   // Erase node pointed to be iterator
   bool erase(Iterator itr) {
     if (itr == end()) {
@@ -588,9 +744,20 @@ class RadixTree {
   const TreeTraits& traits() const {
     return traits_;
   }
+  // Memory held for the nodes of this tree
+  size_t allocatedBytes() const {
+    return pool_ ? pool_->allocatedBytes() : 0;
+  }
 
  private:
-  static std::unique_ptr<TreeNode> cloneSubTree(const TreeNode* node);
+  NodePtr cloneSubTree(const TreeNode* node);
+  // Worker function for bulkErase, returns what replaces node in the tree
+  NodePtr bulkEraseSubTree(
+      NodePtr node,
+      typename std::vector<std::pair<IPADDRTYPE, uint8_t>>::const_iterator&
+          prefix,
+      typename std::vector<std::pair<IPADDRTYPE, uint8_t>>::const_iterator
+          end);
   // Worker function to do the actual longest match lookup.
   const TreeNode* longestMatchImpl(
       const IPADDRTYPE& ipaddr,
@@ -611,18 +778,24 @@ class RadixTree {
             ipaddr, masklen, foundExact, includeNonValueNodes, trail));
   }
 
-  std::unique_ptr<TreeNode> makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
-    return std::make_unique<TreeNode>(ip, masklen, nodeDeleteCallback_);
+  // Pool is only created with the first node, so empty trees stay cheap
+  NodePool& pool() {
+    if (!pool_) {
+      pool_ = std::make_unique<NodePool>(nodeDeleteCallback_);
+    }
+    return *pool_;
+  }
+
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen) {
+    return pool().create(ip, masklen);
   }
 
   template <typename VALUE>
-  std::unique_ptr<TreeNode>
-  makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
-    return std::make_unique<TreeNode>(
-        ip, masklen, std::forward<VALUE>(value), nodeDeleteCallback_);
+  NodePtr makeNode(const IPADDRTYPE& ip, uint8_t masklen, VALUE&& value) {
+    return pool().create(ip, masklen, std::forward<VALUE>(value));
   }
 
-  void makeRoot(std::unique_ptr<TreeNode> newRoot) {
+  void makeRoot(NodePtr newRoot) {
     CHECK(root_ != newRoot || root_ == nullptr);
     if (newRoot) {
       newRoot->setParent(nullptr);
@@ -635,7 +808,9 @@ class RadixTree {
       bool includeNonValueNodes,
       const TreeNode* node) const;
 
-  std::unique_ptr<TreeNode> root_{nullptr};
+  // Declared before root_, so that it outlives the nodes
+  std::unique_ptr<NodePool> pool_;
+  NodePtr root_{nullptr};
   size_t size_{0};
   NodeDeleteCallback nodeDeleteCallback_;
   TreeTraits traits_;
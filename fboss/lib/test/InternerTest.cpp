@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/lib/Interner.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+// Its own type, so that other tests do not share its interned values
+struct IntSet : std::set<int> {
+  using std::set<int>::set;
+};
+
+struct IntSetHash {
+  size_t operator()(const IntSet& values) const {
+    size_t hash = values.size();
+    for (auto value : values) {
+      hash = hash * 31 + value;
+    }
+    return hash;
+  }
+};
+
+using IntSetInterner = Interner<IntSet, IntSetHash>;
+} // namespace
+
+TEST(Interner, equalValuesShared) {
+  auto a = IntSetInterner::intern(IntSet{1, 2, 3});
+  auto b = IntSetInterner::intern(IntSet{3, 2, 1});
+  auto c = IntSetInterner::intern(IntSet{1, 2});
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(a.use_count(), 2);
+  EXPECT_EQ(*a, (IntSet{1, 2, 3}));
+}
+
+TEST(Interner, defaultValue) {
+  const auto& empty = IntSetInterner::defaultValue();
+  EXPECT_TRUE(empty->empty());
+  EXPECT_EQ(empty, IntSetInterner::intern(IntSet()));
+}
+
+TEST(Interner, freedWhenUnused) {
+  auto before = IntSetInterner::size();
+  auto a = IntSetInterner::intern(IntSet{42});
+  EXPECT_EQ(IntSetInterner::size(), before + 1);
+  auto b = a;
+  a.reset();
+  EXPECT_EQ(IntSetInterner::size(), before + 1);
+  b.reset();
+  EXPECT_EQ(IntSetInterner::size(), before);
+  // Interned again after being freed
+  EXPECT_EQ(*IntSetInterner::intern(IntSet{42}), IntSet{42});
+}
+
+TEST(Interner, concurrentInterning) {
+  auto before = IntSetInterner::size();
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < 8; ++thread) {
+    threads.emplace_back([] {
+      for (int i = 0; i < 10000; ++i) {
+        auto a = IntSetInterner::intern(IntSet{100 + i % 7});
+        auto b = IntSetInterner::intern(IntSet{100 + i % 7});
+        EXPECT_EQ(a, b);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(IntSetInterner::size(), before);
+}
+
+TEST(Interner, isInterned) {
+  auto a = IntSetInterner::intern(IntSet{7, 8});
+  EXPECT_TRUE(IntSetInterner::isInterned(a));
+  // Equal, but not the interned copy
+  auto copy = std::make_shared<const IntSet>(*a);
+  EXPECT_FALSE(IntSetInterner::isInterned(copy));
+  EXPECT_FALSE(
+      IntSetInterner::isInterned(std::make_shared<const IntSet>(IntSet{9})));
+}
+
+TEST(Interner, concurrentInterningAcrossShards) {
+  auto before = IntSetInterner::size();
+  std::vector<std::thread> threads;
+  for (int thread = 0; thread < 8; ++thread) {
+    threads.emplace_back([thread] {
+      std::vector<IntSetInterner::Handle> handles;
+      for (int i = 0; i < 1000; ++i) {
+        // Some values are interned by this thread only, others by all
+        auto value = i % 2 ? IntSet{thread, 1000 + i} : IntSet{1000 + i};
+        handles.push_back(IntSetInterner::intern(value));
+        EXPECT_EQ(handles.back(), IntSetInterner::intern(value));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(IntSetInterner::size(), before);
+}
@@ -0,0 +1,226 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include <folly/Random.h>
+
+#include "fboss/lib/MultibitTrie.h"
+#include "fboss/lib/RadixTree.h"
+
+using namespace facebook::network;
+using folly::IPAddressV4;
+using folly::IPAddressV6;
+
+namespace {
+
+IPAddressV4 randomAddress(IPAddressV4 /* unused */) {
+  return IPAddressV4::fromLongHBO(folly::Random::rand32());
+}
+
+IPAddressV6 randomAddress(IPAddressV6 /* unused */) {
+  IPAddressV6::ByteArray bytes;
+  for (auto& byte : bytes) {
+    byte = folly::Random::rand32(256);
+  }
+  // Keep to a few /16s, so that prefixes share nodes below the root
+  bytes[0] = 0x24;
+  bytes[1] = folly::Random::rand32(4);
+  return IPAddressV6(bytes);
+}
+
+/*
+ * Build a RadixTree and a MultibitTrie from the same random prefixes, and
+ * check that they match the same prefix for random addresses.
+ */
+template <typename AddrT>
+void checkAgainstRadixTree(size_t numPrefixes, size_t numLookups) {
+  RadixTree<AddrT, int> tree;
+  for (size_t i = 0; i < numPrefixes; ++i) {
+    auto mask = folly::Random::rand32(AddrT::bitCount() + 1);
+    tree.insert(randomAddress(AddrT()).mask(mask), mask, static_cast<int>(i));
+  }
+  auto trie = MultibitTrie<AddrT, int>::fromRadixTree(tree);
+  EXPECT_EQ(tree.size(), trie.size());
+
+  std::vector<AddrT> addrs;
+  for (size_t i = 0; i < numLookups; ++i) {
+    addrs.push_back(randomAddress(AddrT()));
+  }
+  std::vector<const int*> batchResults(addrs.size());
+  trie.longestMatch(folly::range(addrs), batchResults.data());
+
+  for (size_t i = 0; i < addrs.size(); ++i) {
+    auto expected = tree.longestMatch(addrs[i], AddrT::bitCount());
+    auto result = trie.longestMatch(addrs[i]);
+    if (expected == tree.end()) {
+      EXPECT_EQ(nullptr, result) << addrs[i];
+      EXPECT_EQ(nullptr, batchResults[i]) << addrs[i];
+    } else {
+      ASSERT_NE(nullptr, result) << addrs[i];
+      ASSERT_NE(nullptr, batchResults[i]) << addrs[i];
+      EXPECT_EQ(expected->value(), *result) << addrs[i];
+      EXPECT_EQ(expected->value(), *batchResults[i]) << addrs[i];
+    }
+  }
+}
+
+/*
+ * Apply random changes to a RadixTree and a MultibitTrie over several
+ * rounds, and check that a copy of the trie taken after each round matches
+ * the same prefixes as the tree did then, i.e. that copies don't see later
+ * rounds.
+ */
+template <typename AddrT>
+void checkUpdatesAgainstRadixTree(size_t numRounds, size_t numChanges) {
+  using Trie = MultibitTrie<AddrT, int>;
+  constexpr int kNoMatch = -2;
+  RadixTree<AddrT, int> tree;
+  Trie trie;
+  std::vector<AddrT> addrs;
+  for (size_t i = 0; i < 1000; ++i) {
+    addrs.push_back(randomAddress(AddrT()));
+  }
+  // Trie after each round, along with the size and matches of the tree
+  std::vector<std::tuple<Trie, size_t, std::vector<int>>> versions;
+  for (size_t round = 0; round < numRounds; ++round) {
+    std::vector<typename Trie::Change> changes;
+    for (size_t i = 0; i < numChanges; ++i) {
+      auto mask = folly::Random::rand32(AddrT::bitCount() + 1);
+      auto network = randomAddress(AddrT()).mask(mask);
+      if (tree.exactMatch(network, mask) != tree.end()) {
+        continue;
+      }
+      auto value = static_cast<int>(round * numChanges + i);
+      tree.insert(network, mask, value);
+      changes.push_back({network, static_cast<uint8_t>(mask), value});
+    }
+    // Replace or remove some of the prefixes added in earlier rounds
+    if (round > 0) {
+      std::vector<std::pair<AddrT, uint8_t>> existing;
+      for (const auto& node : tree) {
+        if (node.value() < static_cast<int>(round * numChanges) &&
+            folly::Random::oneIn(4)) {
+          existing.emplace_back(node.ipAddress(), node.masklen());
+        }
+      }
+      for (const auto& [network, mask] : existing) {
+        if (folly::Random::oneIn(2)) {
+          tree.erase(network, mask);
+          changes.push_back({network, mask, std::nullopt});
+        } else {
+          tree.exactMatch(network, mask).setValue(-1);
+          changes.push_back({network, mask, -1});
+        }
+      }
+    }
+    trie.update(std::move(changes));
+    std::vector<int> matches;
+    for (const auto& addr : addrs) {
+      auto match = tree.longestMatch(addr, AddrT::bitCount());
+      matches.push_back(match == tree.end() ? kNoMatch : match->value());
+    }
+    versions.emplace_back(trie, tree.size(), std::move(matches));
+  }
+
+  for (const auto& [trieVersion, size, matches] : versions) {
+    EXPECT_EQ(size, trieVersion.size());
+    for (size_t i = 0; i < addrs.size(); ++i) {
+      auto result = trieVersion.longestMatch(addrs[i]);
+      EXPECT_EQ(matches[i], result ? *result : kNoMatch) << addrs[i];
+    }
+  }
+}
+
+} // namespace
+
+TEST(MultibitTrie, Empty) {
+  MultibitTrie<IPAddressV4, int> trie;
+  EXPECT_EQ(0, trie.size());
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV4("10.0.0.1")));
+}
+
+TEST(MultibitTrie, LongestMatch4) {
+  MultibitTrie<IPAddressV4, int> trie({
+      {IPAddressV4("10.1.2.3"), 32, 4},
+      {IPAddressV4("0.0.0.0"), 0, 1},
+      {IPAddressV4("10.1.2.0"), 24, 3},
+      {IPAddressV4("10.0.0.0"), 8, 2},
+  });
+  EXPECT_EQ(1, *trie.longestMatch(IPAddressV4("11.0.0.1")));
+  EXPECT_EQ(2, *trie.longestMatch(IPAddressV4("10.5.0.1")));
+  EXPECT_EQ(3, *trie.longestMatch(IPAddressV4("10.1.2.1")));
+  EXPECT_EQ(3, *trie.longestMatch(IPAddressV4("10.1.2.255")));
+  EXPECT_EQ(4, *trie.longestMatch(IPAddressV4("10.1.2.3")));
+}
+
+TEST(MultibitTrie, LongestMatch6) {
+  MultibitTrie<IPAddressV6, int> trie({
+      {IPAddressV6("2401:db00::"), 32, 1},
+      {IPAddressV6("2401:db00:e003:9100::"), 64, 2},
+      {IPAddressV6("2401:db00:e003:9100:1006::2c"), 127, 3},
+  });
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV6("2401:db01::1")));
+  EXPECT_EQ(1, *trie.longestMatch(IPAddressV6("2401:db00::1")));
+  EXPECT_EQ(2, *trie.longestMatch(IPAddressV6("2401:db00:e003:9100::1")));
+  EXPECT_EQ(
+      3, *trie.longestMatch(IPAddressV6("2401:db00:e003:9100:1006::2d")));
+}
+
+TEST(MultibitTrie, MatchesRadixTree4) {
+  checkAgainstRadixTree<IPAddressV4>(10000, 10000);
+}
+
+TEST(MultibitTrie, MatchesRadixTree6) {
+  checkAgainstRadixTree<IPAddressV6>(10000, 10000);
+}
+
+TEST(MultibitTrie, Update) {
+  using Trie = MultibitTrie<IPAddressV4, int>;
+  Trie trie({
+      {IPAddressV4("0.0.0.0"), 0, 1},
+      {IPAddressV4("10.0.0.0"), 8, 2},
+      {IPAddressV4("10.1.2.0"), 24, 3},
+  });
+  auto before = trie;
+
+  trie.update({
+      {IPAddressV4("10.1.0.0"), 16, 4},
+      {IPAddressV4("10.1.2.0"), 24, std::nullopt},
+      {IPAddressV4("10.0.0.0"), 8, 5},
+      // Not in the trie
+      {IPAddressV4("10.1.3.0"), 24, std::nullopt},
+  });
+  EXPECT_EQ(3, trie.size());
+  EXPECT_EQ(1, *trie.longestMatch(IPAddressV4("11.0.0.1")));
+  EXPECT_EQ(5, *trie.longestMatch(IPAddressV4("10.5.0.1")));
+  EXPECT_EQ(4, *trie.longestMatch(IPAddressV4("10.1.2.1")));
+
+  // Removing a prefix falls back to the next longest one
+  trie.update({
+      {IPAddressV4("10.1.0.0"), 16, std::nullopt},
+      {IPAddressV4("0.0.0.0"), 0, std::nullopt},
+  });
+  EXPECT_EQ(1, trie.size());
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV4("11.0.0.1")));
+  EXPECT_EQ(5, *trie.longestMatch(IPAddressV4("10.1.2.1")));
+
+  trie.update({{IPAddressV4("10.0.0.0"), 8, std::nullopt}});
+  EXPECT_EQ(0, trie.size());
+  EXPECT_EQ(nullptr, trie.longestMatch(IPAddressV4("10.1.2.1")));
+
+  // The copy taken before is left alone
+  EXPECT_EQ(3, before.size());
+  EXPECT_EQ(1, *before.longestMatch(IPAddressV4("11.0.0.1")));
+  EXPECT_EQ(2, *before.longestMatch(IPAddressV4("10.5.0.1")));
+  EXPECT_EQ(3, *before.longestMatch(IPAddressV4("10.1.2.1")));
+}
+
+TEST(MultibitTrie, UpdatesMatchRadixTree4) {
+  checkUpdatesAgainstRadixTree<IPAddressV4>(20, 500);
+}
+
+TEST(MultibitTrie, UpdatesMatchRadixTree6) {
+  checkUpdatesAgainstRadixTree<IPAddressV6>(20, 500);
+}
@@ -4,6 +4,8 @@
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
 #include <set>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include "PyRadixWrapper.h"
 #include "common/base/Random.h"
@@ -38,6 +40,27 @@ set<Prefix6> exactMatchSet6;
 set<Prefix6> longestMatchSet6;
 vector<int> valueSet;
 
+template <typename IPADDRTYPE, typename PREFIX>
+vector<tuple<IPADDRTYPE, uint8_t, int>> bulkInsertEntries(
+    const set<PREFIX>& prefixes) {
+  vector<tuple<IPADDRTYPE, uint8_t, int>> entries;
+  auto count = 0;
+  for (auto pfx : prefixes) {
+    entries.emplace_back(pfx.ip, pfx.mask, valueSet[count++]);
+  }
+  return entries;
+}
+
+template <typename IPADDRTYPE, typename PREFIX>
+vector<pair<IPADDRTYPE, uint8_t>> bulkErasePrefixes(
+    const set<PREFIX>& prefixes) {
+  vector<pair<IPADDRTYPE, uint8_t>> toErase;
+  for (auto pfx : prefixes) {
+    toErase.emplace_back(pfx.ip, pfx.mask);
+  }
+  return toErase;
+}
+
 // V4 Benchmarks
 template <typename TREE>
 void setupTree4(TREE& tree) {
@@ -57,6 +80,15 @@ BENCHMARK_RELATIVE(RadixTreeInsert4) {
   setupTree4(rtree);
 }
 
+BENCHMARK_RELATIVE(RadixTreeBulkInsert4) {
+  RadixTree<IPAddressV4, int> rtree;
+  vector<tuple<IPAddressV4, uint8_t, int>> entries;
+  BENCHMARK_SUSPEND {
+    entries = bulkInsertEntries<IPAddressV4>(insertSet4);
+  }
+  rtree.bulkInsert(std::move(entries));
+}
+
 BENCHMARK(PyRadixErase4) {
   PyRadixWrapper<IPAddressV4, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -77,6 +109,16 @@ BENCHMARK_RELATIVE(RadixTreeErase4) {
   }
 }
 
+BENCHMARK_RELATIVE(RadixTreeBulkErase4) {
+  RadixTree<IPAddressV4, int> rtree;
+  vector<pair<IPAddressV4, uint8_t>> toErase;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+    toErase = bulkErasePrefixes<IPAddressV4>(eraseSet4);
+  }
+  rtree.bulkErase(std::move(toErase));
+}
+
 BENCHMARK(PyRadixExactMatch4) {
   PyRadixWrapper<IPAddressV4, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -117,6 +159,26 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch4) {
   }
 }
 
+BENCHMARK(RadixTreeClone4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  auto copy = rtree.clone();
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+    copy.clear();
+  }
+}
+
+BENCHMARK(RadixTreeClear4) {
+  RadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  rtree.clear();
+}
+
 // V6 benchmarks
 
 template <typename TREE>
@@ -137,6 +199,15 @@ BENCHMARK_RELATIVE(RadixTreeInsert6) {
   setupTree6(rtree);
 }
 
+BENCHMARK_RELATIVE(RadixTreeBulkInsert6) {
+  RadixTree<IPAddressV6, int> rtree;
+  vector<tuple<IPAddressV6, uint8_t, int>> entries;
+  BENCHMARK_SUSPEND {
+    entries = bulkInsertEntries<IPAddressV6>(insertSet6);
+  }
+  rtree.bulkInsert(std::move(entries));
+}
+
 BENCHMARK(PyRadixErase6) {
   PyRadixWrapper<IPAddressV6, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -157,6 +228,16 @@ BENCHMARK_RELATIVE(RadixTreeErase6) {
   }
 }
 
+BENCHMARK_RELATIVE(RadixTreeBulkErase6) {
+  RadixTree<IPAddressV6, int> rtree;
+  vector<pair<IPAddressV6, uint8_t>> toErase;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+    toErase = bulkErasePrefixes<IPAddressV6>(eraseSet6);
+  }
+  rtree.bulkErase(std::move(toErase));
+}
+
 BENCHMARK(PyRadixExactMatch6) {
   PyRadixWrapper<IPAddressV6, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -197,6 +278,35 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+BENCHMARK(RadixTreeClone6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  auto copy = rtree.clone();
+  BENCHMARK_SUSPEND {
+    rtree.clear();
+    copy.clear();
+  }
+}
+
+BENCHMARK(RadixTreeClear6) {
+  RadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  rtree.clear();
+}
+
+// Memory taken by the nodes of a tree of all of insertSet, per prefix
+template <typename TREE>
+void printMemoryPerPrefix(const std::string& name, void (*setupTree)(TREE&)) {
+  TREE rtree;
+  setupTree(rtree);
+  LOG(INFO) << name << " memory per prefix: "
+            << rtree.allocatedBytes() / rtree.size() << " bytes";
+}
+
 } // namespace
 
 int main(int /*argc*/, char* /*argv*/ []) {
@@ -252,5 +362,7 @@ int main(int /*argc*/, char* /*argv*/ []) {
     auto newIp = pfx.ip.mask(newMask);
     longestMatchSet6.insert(Prefix6(newIp, newMask));
   }
+  printMemoryPerPrefix<RadixTree<IPAddressV4, int>>("RadixTree4", setupTree4);
+  printMemoryPerPrefix<RadixTree<IPAddressV6, int>>("RadixTree6", setupTree6);
   runBenchmarks();
 }
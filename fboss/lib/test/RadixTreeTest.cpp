@@ -1379,6 +1379,99 @@ TEST(RadixTree, Clone) {
   EXPECT_TRUE(v6Tree == v6TreeCopy);
   EXPECT_TRUE(ipTree == ipTreeCopy);
 }
+
+/*
+ * Nodes come from a pool per tree, which calls the delete callback for
+ * each of them and goes along with them when a tree is moved
+ */
+TEST(RadixTree, NodePool) {
+  auto deleteCount = 0;
+  auto deleteCallback = [&](const RadixTreeNode<IPAddressV4, int>& /*node*/) {
+    ++deleteCount;
+  };
+  RadixTree<IPAddressV4, int> rtree(deleteCallback);
+  EXPECT_EQ(0, rtree.allocatedBytes());
+  auto prefixes = setupTestTree4(rtree);
+  auto allocatedBytes = rtree.allocatedBytes();
+  EXPECT_GT(allocatedBytes, 0);
+
+  // Erased nodes are reused rather than growing the pool
+  for (const auto& prefix : prefixes) {
+    rtree.erase(prefix.ip, prefix.mask);
+  }
+  EXPECT_EQ(0, rtree.size());
+  EXPECT_EQ(allocatedBytes, rtree.allocatedBytes());
+  setupTestTree4(rtree);
+  EXPECT_EQ(allocatedBytes, rtree.allocatedBytes());
+
+  auto copy = rtree.clone();
+  EXPECT_TRUE(rtree == copy);
+
+  // Moved nodes are still deleted through the callback
+  RadixTree<IPAddressV4, int> moved;
+  moved = std::move(copy);
+  EXPECT_TRUE(rtree == moved);
+  EXPECT_EQ(0, copy.size());
+  deleteCount = 0;
+  moved.clear();
+  EXPECT_GT(deleteCount, 0);
+  EXPECT_EQ(0, moved.allocatedBytes());
+}
+
+/*
+ * Bulk inserts and erases must leave the same tree as inserting and
+ * erasing the same prefixes one at a time
+ */
+TEST(RadixTree, BulkInsertAndErase) {
+  RadixTree<IPAddressV4, int> rtree, bulkTree;
+  vector<tuple<IPAddressV4, uint8_t, int>> entries;
+  vector<pair<IPAddressV4, uint8_t>> toErase;
+  auto const kInsertCount = 1000;
+  for (auto i = 0; i < kInsertCount; ++i) {
+    auto mask = folly::Random::rand32(33);
+    // Keep to 10/8 for prefixes to nest, and some duplicates
+    auto ip = IPAddressV4::fromLongHBO(
+        (10 << 24) | (folly::Random::rand32() & 0xffffff));
+    rtree.insert(ip, mask, i);
+    entries.emplace_back(ip, mask, i);
+    if (i % 3 == 0) {
+      toErase.emplace_back(ip, mask);
+    }
+  }
+  EXPECT_EQ(rtree.size(), bulkTree.bulkInsert(entries));
+  EXPECT_TRUE(rtree == bulkTree);
+
+  // Into a tree which is not empty
+  auto moreEntries = entries;
+  for (auto& entry : moreEntries) {
+    get<0>(entry) = IPAddressV4::fromLongHBO(folly::Random::rand32());
+  }
+  auto bulkTreeCopy = bulkTree.clone();
+  auto inserted = bulkTreeCopy.bulkInsert(moreEntries);
+  for (auto& [ip, mask, value] : moreEntries) {
+    rtree.insert(ip, mask, value);
+  }
+  EXPECT_EQ(rtree.size(), bulkTree.size() + inserted);
+  EXPECT_TRUE(rtree == bulkTreeCopy);
+
+  // Prefixes not in the tree are skipped
+  toErase.emplace_back(IPAddressV4("11.0.0.0"), 8);
+  size_t erased = 0;
+  for (const auto& [ip, mask] : toErase) {
+    erased += bulkTreeCopy.erase(ip, mask);
+  }
+  EXPECT_EQ(erased, rtree.bulkErase(toErase));
+  EXPECT_TRUE(rtree == bulkTreeCopy);
+
+  // Erasing all prefixes empties the tree
+  vector<pair<IPAddressV4, uint8_t>> all;
+  for (const auto& node : rtree) {
+    all.emplace_back(node.ipAddress(), node.masklen());
+  }
+  EXPECT_EQ(all.size(), rtree.bulkErase(all));
+  EXPECT_EQ(0, rtree.size());
+  EXPECT_EQ(nullptr, rtree.root());
+}
 /*
  * Compare with py-radix
  * Insert a set of random prefixes on both py-radix and our radix tree